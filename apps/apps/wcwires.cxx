@@ -45,7 +45,7 @@ int main(int argc, char** argv)
                    "Search paths to consider in addition to those in WIRECELL_PATH"
         )->type_size(1)->allow_extra_args(false);
     app.add_option("-o,--output", output,
-                   "Write out a wires file (def=none)"
+                   "Write out a wires file, binary if ending in .wcb (def=none)"
         )->type_size(1)->allow_extra_args(false);
     app.add_option("-c,--correction", correction,
                    "Correction level: 1=load,2=order,3=direction,4=pitch (def=4)"
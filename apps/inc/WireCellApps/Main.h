@@ -87,6 +87,14 @@ namespace WireCell {
         /// log. (levels: critical, error, warn, info, debug, trace).
         void set_loglevel(const std::string& log, const std::string& level = "");
 
+        /// Configure components using up to nthreads threads.  Zero
+        /// or one configures serially in configuration sequence
+        /// order.  Otherwise, a component is configured only after
+        /// all components it references by "type:name" (or bare
+        /// "type") strings in its configuration and independent
+        /// components may be configured concurrently.
+        void set_config_threads(int nthreads);
+
         /// Call once after all setup has been done and before
         /// running.
         void initialize();
@@ -110,9 +118,28 @@ namespace WireCell {
         // only relevant if we are built with TBB support
         int m_threads{0};
 
+        // Threads used to configure components.  See set_config_threads().
+        int m_config_threads{0};
+
+        // Apply configuration to configurables, see initialize().
+        void configure_components();
+
         std::unordered_map<std::string, std::string> m_log_levels;
 
     };
 
+    /// Sort components into levels for concurrent configuration.
+    ///
+    /// The tns give each component's "type:name" (or bare "type")
+    /// and cfgs its configuration, in configuration sequence order.
+    /// A component which holds a string naming another one is placed
+    /// in a level after it.  Each returned level holds indices of
+    /// mutually independent components in sequence order.  If the
+    /// references form a cycle, cyclic is set true and one level per
+    /// component is returned in sequence order.
+    std::vector<std::vector<size_t>> configuration_levels(const std::vector<std::string>& tns,
+                                                          const std::vector<Configuration>& cfgs,
+                                                          bool& cyclic);
+
 }  // namespace WireCell
 #endif
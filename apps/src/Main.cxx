@@ -5,6 +5,7 @@
 
 #include "WireCellUtil/Version.h"
 #include "WireCellUtil/NamedFactory.h"
+#include "WireCellUtil/Parallel.h"
 #include "WireCellUtil/String.h"
 #include "WireCellUtil/Point.h"
 
@@ -17,7 +18,10 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/property_tree/ptree.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <iostream>
 
@@ -88,6 +92,9 @@ int Main::cmdline(int argc, char* argv[])
          "limit number of threads used")
 #endif
 
+        ("config-threads", po::value<int>(),
+         "configure independent components with this many threads (def=serial)")
+
         ("version,v", 
          "print the compiled version to stdout")
 
@@ -199,6 +206,9 @@ int Main::cmdline(int argc, char* argv[])
         m_threads = opts["threads"].as<int>();
     }
 #endif
+    if (opts.count("config-threads")) {
+        set_config_threads(opts["config-threads"].as<int>());
+    }
 
     return 0;
 }
@@ -247,6 +257,8 @@ void Main::tla_code(const std::string& name, const std::string& value) { m_tlaco
 
 void Main::add_path(const std::string& dirname) { m_load_path.push_back(dirname); }
 
+void Main::set_config_threads(int nthreads) { m_config_threads = std::max(0, nthreads); }
+
 void Main::initialize()
 {
     // Here we got thought the boot-up sequence steps.
@@ -280,6 +292,9 @@ void Main::initialize()
             log->debug("config requests app: \"{}\"", app);
             m_apps.push_back(app);
         }
+        if (!m_config_threads) {
+            set_config_threads(get(main_cfg, "data.config_threads", 0));
+        }
     }
     if (m_apps.empty()) {
         log->critical("no apps given");
@@ -337,25 +352,163 @@ void Main::initialize()
     apply_log_config();
     Log::fill_levels();
 
-    // Finally, ask any configurables for their default, merge with
-    // user config and give back.
+    configure_components();
+}
+
+// Add to deps the index of any component referenced by a string in cfg.
+static void find_references(const Json::Value& cfg, const std::unordered_map<std::string, size_t>& known,
+                            std::vector<size_t>& deps)
+{
+    if (cfg.isString()) {
+        auto it = known.find(cfg.asString());
+        if (it != known.end()) {
+            deps.push_back(it->second);
+        }
+        return;
+    }
+    if (cfg.isArray() or cfg.isObject()) {
+        for (const auto& one : cfg) {
+            find_references(one, known, deps);
+        }
+    }
+}
+
+std::vector<std::vector<size_t>> WireCell::configuration_levels(const std::vector<std::string>& tns,
+                                                                const std::vector<Configuration>& cfgs,
+                                                                bool& cyclic)
+{
+    const size_t nents = tns.size();
+    std::unordered_map<std::string, size_t> known;
+    for (size_t ind = 0; ind < nents; ++ind) {
+        known[tns[ind]] = ind;
+        if (tns[ind].find(':') == std::string::npos) {
+            known[tns[ind] + ":"] = ind;
+        }
+    }
+
+    // Dependency DAG from references and a topological sort into
+    // levels of mutually independent components.
+    std::vector<std::vector<size_t>> users(nents);
+    std::vector<size_t> nwaiting(nents, 0);
+    for (size_t ind = 0; ind < nents; ++ind) {
+        std::vector<size_t> deps;
+        find_references(cfgs[ind], known, deps);
+        std::sort(deps.begin(), deps.end());
+        deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+        for (size_t dep : deps) {
+            if (dep == ind) {
+                continue;
+            }
+            users[dep].push_back(ind);
+            ++nwaiting[ind];
+        }
+    }
+    std::vector<std::vector<size_t>> levels;
+    std::vector<size_t> ready;
+    for (size_t ind = 0; ind < nents; ++ind) {
+        if (!nwaiting[ind]) {
+            ready.push_back(ind);
+        }
+    }
+    size_t nsorted = 0;
+    while (!ready.empty()) {
+        nsorted += ready.size();
+        std::vector<size_t> next;
+        for (size_t ind : ready) {
+            for (size_t user : users[ind]) {
+                if (--nwaiting[user] == 0) {
+                    next.push_back(user);
+                }
+            }
+        }
+        std::sort(next.begin(), next.end());  // keep sequence order
+        levels.push_back(ready);
+        ready.swap(next);
+    }
+
+    cyclic = nsorted != nents;
+    if (cyclic) {
+        levels.assign(nents, {});
+        for (size_t ind = 0; ind < nents; ++ind) {
+            levels[ind].push_back(ind);
+        }
+    }
+    return levels;
+}
+
+void Main::configure_components()
+{
+    using clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::string tn;
+        IConfigurable::pointer cfgobj;
+        Configuration cfg;
+        double seconds{0};
+    };
+    std::vector<Entry> entries;
+
+    auto configure_one = [&](Entry& ent) {
+        log->debug("configuring component: \"{}\"", ent.tn);
+        const auto t0 = clock::now();
+        ent.cfgobj->configure(ent.cfg);  // throws
+        ent.seconds = std::chrono::duration<double>(clock::now() - t0).count();
+        log->debug("configured component: \"{}\" in {:.3f} s", ent.tn, ent.seconds);
+    };
+
+    const auto start = clock::now();
+    size_t nlevels = 0;
     for (auto c : m_cfgmgr.all()) {
         if (c.isNull()) {
             continue;  // allow and ignore any totally empty configurations
         }
         string type = get<string>(c, "type");
         string name = get<string>(c, "name");
-        log->debug("configuring component: \"{}\":\"{}\"", type, name);
         auto cfgobj = Factory::find_maybe<IConfigurable>(type, name);  // doesn't throw.
         if (!cfgobj) {
             continue;
         }
-
         // Get component's hard-coded default config, update it with
-        // anything the user may have provided and apply it.
+        // anything the user may have provided.
         Configuration cfg = cfgobj->default_configuration();
-        cfg = update(cfg, c["data"]);
-        cfgobj->configure(cfg);  // throws
+        entries.push_back(Entry{name.empty() ? type : type + ":" + name, cfgobj, update(cfg, c["data"])});
+
+        // Serial configuration keeps the sequence order.
+        if (m_config_threads <= 1) {
+            configure_one(entries.back());
+            ++nlevels;
+        }
+    }
+
+    if (m_config_threads > 1) {
+        std::vector<std::string> tns;
+        std::vector<Configuration> cfgs;
+        for (const auto& ent : entries) {
+            tns.push_back(ent.tn);
+            cfgs.push_back(ent.cfg);
+        }
+        bool cyclic = false;
+        const auto levels = configuration_levels(tns, cfgs, cyclic);
+        if (cyclic) {
+            log->warn("configuration references form a cycle, configuring serially");
+        }
+
+        nlevels = levels.size();
+        for (const auto& level : levels) {
+            Parallel::for_each(level.size(), m_config_threads,
+                               [&](size_t ind) { configure_one(entries[level[ind]]); });
+        }
+    }
+
+    const double total = std::chrono::duration<double>(clock::now() - start).count();
+    log->info("configured {} components in {} steps with {} threads in {:.3f} s", entries.size(), nlevels,
+              std::max(1, m_config_threads), total);
+
+    // Report the slowest.
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const Entry& a, const Entry& b) { return a.seconds > b.seconds; });
+    for (size_t ind = 0; ind < std::min<size_t>(5, entries.size()); ++ind) {
+        log->info("\tconfigure \"{}\": {:.3f} s", entries[ind].tn, entries[ind].seconds);
     }
 }
 
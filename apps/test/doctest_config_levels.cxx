@@ -0,0 +1,61 @@
+#include "WireCellApps/Main.h"
+#include "WireCellUtil/doctest.h"
+
+using namespace WireCell;
+
+static Configuration refs(std::vector<std::string> names)
+{
+    Configuration cfg;
+    for (const auto& name : names) {
+        cfg["list"].append(name);
+    }
+    cfg["other"] = 42;
+    return cfg;
+}
+
+TEST_CASE("configuration levels independent")
+{
+    std::vector<std::string> tns = {"A:a", "B:b", "C"};
+    std::vector<Configuration> cfgs = {refs({}), refs({"nothing:here"}), refs({})};
+    bool cyclic = true;
+    auto levels = configuration_levels(tns, cfgs, cyclic);
+    REQUIRE(!cyclic);
+    REQUIRE(levels.size() == 1);
+    REQUIRE(levels[0] == std::vector<size_t>{0, 1, 2});
+}
+
+TEST_CASE("configuration levels dag")
+{
+    // d uses b and C, b uses a, C uses a and itself, e is independent.
+    std::vector<std::string> tns = {"D:d", "B:b", "A:a", "C", "E:e"};
+    std::vector<Configuration> cfgs = {
+        refs({"B:b", "C:"}),
+        refs({"A:a"}),
+        refs({}),
+        refs({"A:a", "C"}),
+        refs({}),
+    };
+    cfgs[0]["nested"]["deep"] = "C";
+
+    bool cyclic = true;
+    auto levels = configuration_levels(tns, cfgs, cyclic);
+    REQUIRE(!cyclic);
+    REQUIRE(levels.size() == 3);
+    REQUIRE(levels[0] == std::vector<size_t>{2, 4});
+    REQUIRE(levels[1] == std::vector<size_t>{1, 3});
+    REQUIRE(levels[2] == std::vector<size_t>{0});
+}
+
+TEST_CASE("configuration levels cycle")
+{
+    // a -> b -> c -> a, d is independent.
+    std::vector<std::string> tns = {"A:a", "B:b", "C:c", "D:d"};
+    std::vector<Configuration> cfgs = {refs({"B:b"}), refs({"C:c"}), refs({"A:a"}), refs({})};
+    bool cyclic = false;
+    auto levels = configuration_levels(tns, cfgs, cyclic);
+    REQUIRE(cyclic);
+    REQUIRE(levels.size() == tns.size());
+    for (size_t ind = 0; ind < tns.size(); ++ind) {
+        REQUIRE(levels[ind] == std::vector<size_t>{ind});
+    }
+}
@@ -0,0 +1,100 @@
+#ifndef WIRECELLAUX_DENSEFRAME
+#define WIRECELLAUX_DENSEFRAME
+
+#include "WireCellAux/SimpleFrame.h"
+#include "WireCellUtil/Array.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace WireCell::Aux {
+
+    /** A contiguous block of samples.
+     *
+     * Rows are channels and columns are ticks with row-major storage.
+     * A block may be filled before it is given to a DenseFrame and
+     * must not be modified after.
+     */
+    struct DenseBlock {
+        std::vector<int> channels;  // channel ident of each row
+        size_t ncols{0};
+        int tbin{0};                // tbin of column 0
+        std::vector<float> data;    // nrows*ncols, zero-initialized
+
+        DenseBlock(const std::vector<int>& channels, size_t ncols, int tbin = 0);
+
+        size_t nrows() const { return channels.size(); }
+        float* row(size_t irow) { return data.data() + irow * ncols; }
+        const float* row(size_t irow) const { return data.data() + irow * ncols; }
+    };
+    using dense_block_ptr = std::shared_ptr<const DenseBlock>;
+
+    /** A trace which views one row of a DenseBlock.
+     *
+     * The samples() are not copied.  The vector returned by charge()
+     * is made on first call and kept for the life of the trace, so a
+     * consumer calling charge() on every trace doubles the memory of
+     * the frame.  Consumers of dense frames should use samples().
+     */
+    class DenseTrace : public ITrace {
+      public:
+        DenseTrace(dense_block_ptr block, size_t irow);
+
+        virtual int channel() const;
+        virtual int tbin() const;
+        virtual const ChargeSequence& charge() const;
+        virtual const float* samples() const;
+        virtual size_t nsamples() const;
+
+        /// True if charge() has made its copy.
+        bool charged() const { return m_charged; }
+
+      private:
+        dense_block_ptr m_block;
+        size_t m_row;
+        mutable std::once_flag m_once;
+        mutable ChargeSequence m_charge;
+        mutable std::atomic<bool> m_charged{false};
+    };
+
+    /** A frame holding its samples in a DenseBlock.
+     *
+     * Its traces are DenseTrace views, one per row and in row order.
+     * Tags may be applied as for SimpleFrame.
+     */
+    class DenseFrame : public SimpleFrame {
+      public:
+        DenseFrame(int ident, double time, dense_block_ptr block,
+                   double tick = 0.5 * units::microsecond,
+                   const Waveform::ChannelMaskMap& cmm = Waveform::ChannelMaskMap());
+
+        // Copy an (nchannels x nticks) array into a new block.
+        DenseFrame(int ident, double time, const Array::array_xxf& array,
+                   const std::vector<int>& channels, int tbin = 0,
+                   double tick = 0.5 * units::microsecond,
+                   const Waveform::ChannelMaskMap& cmm = Waveform::ChannelMaskMap());
+
+        virtual ~DenseFrame();
+
+        virtual dense_view_t dense() const;
+
+        dense_block_ptr block() const { return m_block; }
+
+      private:
+        dense_block_ptr m_block;
+    };
+
+    /// A row-major Eigen array type matching the dense view layout.
+    using dense_array_t = Eigen::Array<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    /// Return a zero-copy Eigen map of a dense view.  The view must
+    /// be true.
+    inline Eigen::Map<const dense_array_t> dense_map(const IFrame::dense_view_t& view)
+    {
+        return Eigen::Map<const dense_array_t>(view.data, view.nrows, view.ncols);
+    }
+
+}  // namespace WireCell::Aux
+
+#endif
@@ -2,6 +2,9 @@
 #define WIRECELLAUX_FFTWDFT
 
 #include "WireCellIface/IDFT.h"
+#include "WireCellIface/IConfigurable.h"
+#include "WireCellIface/ITerminal.h"
+#include "WireCellAux/Logger.h"
 
 namespace WireCell::Aux {
 
@@ -11,14 +14,45 @@ namespace WireCell::Aux {
         All instances share a common thread-safe plan cache.  There is
         no benefit to using more than one instance in a process.
 
+        Plans are made with FFTW_ESTIMATE unless configured otherwise.
+        More rigorous planning takes longer but may find faster plans.
+        The planning rigor is held by each instance and is part of the
+        plan cache key so instances configured differently do not
+        share plans.  Planning never touches the caller's arrays.  The
+        FFTW wisdom is process-wide and may be saved to a file to be
+        reused by later jobs.  See default_configuration() for details.
+
+        Plans are cached by the shape of the transform and not by the
+        addresses of the arrays.  Arrays that are not SIMD-aligned
+        are transformed via aligned copies.  Allocate with
+        fftwf_malloc() or similar to avoid this cost.
+
         See IDFT.h for important comments.
     */
-    class FftwDFT : public IDFT {
+    class FftwDFT : public Aux::Logger,
+                    public IDFT,
+                    public IConfigurable,
+                    public ITerminal {
       public:
         
         FftwDFT();
         virtual ~FftwDFT();
 
+        // IConfigurable
+        virtual void configure(const WireCell::Configuration& config);
+        virtual WireCell::Configuration default_configuration() const;
+
+        // ITerminal
+        virtual void finalize();
+
+        // Process-wide plan cache statistics.  A "miss" that finds
+        // a plan made meanwhile by another thread does not count in
+        // "plans".  "copies" counts executions on aligned copies.
+        struct PlanStats {
+            size_t hits{0}, misses{0}, plans{0}, copies{0};
+        };
+        static PlanStats plan_stats();
+
         // 1d 
 
         virtual 
@@ -44,6 +78,30 @@ namespace WireCell::Aux {
         void inv2d(const complex_t* in, complex_t* out,
                    int nrows, int ncols) const;
 
+        // real input / half-spectrum
+
+        virtual
+        void fwd1d_r2c(const scalar_t* in, complex_t* out, int size) const;
+
+        virtual
+        void inv1d_c2r(const complex_t* in, scalar_t* out, int size) const;
+
+        virtual
+        void fwd1b_r2c(const scalar_t* in, complex_t* out,
+                       int nrows, int ncols, int axis) const;
+
+        virtual
+        void inv1b_c2r(const complex_t* in, scalar_t* out,
+                       int nrows, int ncols, int axis) const;
+
+        virtual
+        void fwd2d_r2c(const scalar_t* in, complex_t* out,
+                       int nrows, int ncols) const;
+
+        virtual
+        void inv2d_c2r(const complex_t* in, scalar_t* out,
+                       int nrows, int ncols) const;
+
         virtual
         void transpose(const scalar_t* in, scalar_t* out,
                        int nrows, int ncols) const;
@@ -51,6 +109,10 @@ namespace WireCell::Aux {
         void transpose(const complex_t* in, complex_t* out,
                        int nrows, int ncols) const;
 
+      private:
+        unsigned m_rigor;       // FFTW planner flag
+        std::string m_wisdom{""};
+        bool m_save_wisdom{true};
     };
 }
 
@@ -15,6 +15,10 @@ namespace WireCell::Aux::RandTools {
     // A generator that returns fresh randoms.
     using generator_f = std::function<double()>;
 
+    // A filler of an array with n fresh randoms, eg in bulk with
+    // IRandom::fill_normal().
+    using filler_f = std::function<void(float* out, size_t n)>;
+
     // A base for pseudo RNGs
     struct PRNG {
         virtual ~PRNG() {}
@@ -48,9 +52,14 @@ namespace WireCell::Aux::RandTools {
         //
         // With a 4% replacement, speedup is about 2x compared to
         // fully regenerating as in Fresh.  See test_noise.
+        //
+        // If "fill" is given it provides the randoms that fill the
+        // ring, and any enlargement of it, in place of calls to gen.
+        // It must draw from the same distribution as gen.
         Recycling(generator_f gen, generator_f uni,
                   size_t capacity=1000,
-                  double replacement_fraction=0.04);
+                  double replacement_fraction=0.04,
+                  filler_f fill=nullptr);
 
         // Return a single pseudo-pseudo-random 
         float operator()();
@@ -69,6 +78,7 @@ namespace WireCell::Aux::RandTools {
 
       private:
         generator_f gen, uni;
+        filler_f fill;
         size_t nreplace, replace;
         double repfrac{0.02};
         size_t cursor{0};  // may eventually roll over, we do not care
@@ -80,18 +90,30 @@ namespace WireCell::Aux::RandTools {
     class Fresh : virtual public PRNG {
       public:
 
-        Fresh(generator_f gen);
+        // If "fill" is given it makes the vectors in place of calls
+        // to gen.  It must draw from the same distribution as gen.
+        Fresh(generator_f gen, filler_f fill=nullptr);
         float operator()();
         real_vector_t operator()(size_t size);
 
       private:
         generator_f gen;
+        filler_f fill;
     };
 
     
     // Helpers to make above
 
     namespace Normals {
+        inline
+        filler_f
+        make_filler(IRandom::pointer rng, double mean=0.0, double sigma=1.0)
+        {
+            return [rng, mean, sigma](float* out, size_t n) {
+                rng->fill_normal(out, n, mean, sigma);
+            };
+        }
+
         inline
         RandTools::Recycling
         make_recycling(IRandom::pointer rng, size_t capacity, 
@@ -100,18 +122,29 @@ namespace WireCell::Aux::RandTools {
         {
             return RandTools::Recycling(rng->make_normal(mean, sigma),
                                         rng->make_uniform(0,1),
-                                        capacity, replacement_fraction);
+                                        capacity, replacement_fraction,
+                                        make_filler(rng, mean, sigma));
         }
         inline
         RandTools::Fresh
         make_fresh(IRandom::pointer rng,
                    double mean=0.0, double sigma=1.0)
         {
-            return RandTools::Fresh(rng->make_normal(mean, sigma));
+            return RandTools::Fresh(rng->make_normal(mean, sigma),
+                                    make_filler(rng, mean, sigma));
         }
     }
 
     namespace Uniforms {
+        inline
+        filler_f
+        make_filler(IRandom::pointer rng, double lo=0.0, double hi=1.0)
+        {
+            return [rng, lo, hi](float* out, size_t n) {
+                rng->fill_uniform(out, n, lo, hi);
+            };
+        }
+
         inline
         RandTools::Recycling
         make_recycling(IRandom::pointer rng, size_t capacity, 
@@ -120,14 +153,16 @@ namespace WireCell::Aux::RandTools {
         {
             return RandTools::Recycling(rng->make_uniform(lo, hi),
                                         rng->make_uniform(0,1),
-                                        capacity, replacement_fraction);
+                                        capacity, replacement_fraction,
+                                        make_filler(rng, lo, hi));
         }
 
         inline
         RandTools::Fresh
         make_fresh(IRandom::pointer rng, double lo=0.0, double hi=1.0)
         {
-            return RandTools::Fresh(rng->make_uniform(lo, hi));
+            return RandTools::Fresh(rng->make_uniform(lo, hi),
+                                    make_filler(rng, lo, hi));
         }
     }
 
@@ -61,11 +61,14 @@ namespace WireCell::Aux::TensorDM {
     /** Convert tensors representing a named point cloud set.
 
        The tensor found at datapath is converted unless datapath is
-       empty in which case the first pcnamedset found is used.
+       empty in which case the first pcnamedset found is used.  See
+       as_array() for meaning of "share".
 
      */
-    named_pointclouds_t as_pcnamedset(const ITensor::vector& tens, const std::string& datapath = "");
-    named_pointclouds_t as_pcnamedset(const TensorIndex& ti, const std::string& datapath = "");
+    named_pointclouds_t as_pcnamedset(const ITensor::vector& tens, const std::string& datapath = "",
+                                      bool share = false);
+    named_pointclouds_t as_pcnamedset(const TensorIndex& ti, const std::string& datapath = "",
+                                      bool share = false);
                                                              
 
 
@@ -82,6 +85,9 @@ namespace WireCell::Aux::TensorDM {
      * The datapath specifies which in the sequence of tensors is the
      * pctree.  If empty then the first tensor of type pctree is
      * assumed.
+     *
+     * The local point clouds of the returned tree hold copies of their
+     * slice of the tensor arrays and do not refer to the tensors.
      */
     std::unique_ptr<WireCell::PointCloud::Tree::Points::node_t>
     as_pctree(const ITensor::vector& tens,
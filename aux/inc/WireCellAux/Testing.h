@@ -17,6 +17,7 @@
 #include "WireCellIface/IAnodePlane.h"
 
 #include "WireCellUtil/NamedFactory.h"
+#include "WireCellUtil/Units.h"
 
 #include <string>
 #include <vector>
@@ -43,5 +44,13 @@ namespace WireCell::Testing {
     // Return configured anodes for a known detector.
     IAnodePlane::vector anodes(const std::string detector);
 
+    // Return a fake anode of one face of three planes, each of nwires
+    // wires along Y spaced by pitch along Z about Z=0.  Each wire has
+    // its own channel with an ident of 100 times the plane index plus
+    // the wire index.  It is made by the factory as "FakeAnode" so
+    // components may be configured to find it.  Later calls reshape
+    // the same instance.
+    IAnodePlane::pointer fake_anode(int nwires = 20, double pitch = 5 * units::mm);
+
 }
 
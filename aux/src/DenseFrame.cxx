@@ -0,0 +1,82 @@
+#include "WireCellAux/DenseFrame.h"
+
+using namespace WireCell;
+
+Aux::DenseBlock::DenseBlock(const std::vector<int>& channels, size_t ncols, int tbin)
+  : channels(channels)
+  , ncols(ncols)
+  , tbin(tbin)
+  , data(channels.size() * ncols, 0.0)
+{
+}
+
+Aux::DenseTrace::DenseTrace(dense_block_ptr block, size_t irow)
+  : m_block(block)
+  , m_row(irow)
+{
+}
+
+int Aux::DenseTrace::channel() const { return m_block->channels[m_row]; }
+
+int Aux::DenseTrace::tbin() const { return m_block->tbin; }
+
+const float* Aux::DenseTrace::samples() const { return m_block->row(m_row); }
+
+size_t Aux::DenseTrace::nsamples() const { return m_block->ncols; }
+
+const ITrace::ChargeSequence& Aux::DenseTrace::charge() const
+{
+    std::call_once(m_once, [this]() {
+        const float* beg = samples();
+        m_charge.assign(beg, beg + nsamples());
+        m_charged = true;
+    });
+    return m_charge;
+}
+
+static ITrace::shared_vector make_views(const Aux::dense_block_ptr& block)
+{
+    const size_t nrows = block->nrows();
+    auto traces = std::make_shared<ITrace::vector>(nrows);
+    for (size_t irow = 0; irow < nrows; ++irow) {
+        (*traces)[irow] = std::make_shared<Aux::DenseTrace>(block, irow);
+    }
+    return traces;
+}
+
+static Aux::dense_block_ptr make_block(const Array::array_xxf& array,
+                                       const std::vector<int>& channels, int tbin)
+{
+    const size_t nrows = std::min((size_t) array.rows(), channels.size());
+    std::vector<int> chans(channels.begin(), channels.begin() + nrows);
+    auto block = std::make_shared<Aux::DenseBlock>(chans, array.cols(), tbin);
+    Eigen::Map<Aux::dense_array_t>(block->data.data(), nrows, array.cols()) = array.topRows(nrows);
+    return block;
+}
+
+Aux::DenseFrame::DenseFrame(int ident, double time, dense_block_ptr block, double tick,
+                            const Waveform::ChannelMaskMap& cmm)
+  : SimpleFrame(ident, time, make_views(block), tick, cmm)
+  , m_block(block)
+{
+}
+
+Aux::DenseFrame::DenseFrame(int ident, double time, const Array::array_xxf& array,
+                            const std::vector<int>& channels, int tbin, double tick,
+                            const Waveform::ChannelMaskMap& cmm)
+  : DenseFrame(ident, time, make_block(array, channels, tbin), tick, cmm)
+{
+}
+
+Aux::DenseFrame::~DenseFrame() {}
+
+IFrame::dense_view_t Aux::DenseFrame::dense() const
+{
+    dense_view_t view;
+    view.data = m_block->data.data();
+    view.nrows = m_block->nrows();
+    view.ncols = m_block->ncols;
+    view.tbin = m_block->tbin;
+    view.channels = &m_block->channels;
+    return view;
+}
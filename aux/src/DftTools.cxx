@@ -23,10 +23,14 @@ DftTools::complex_vector_t DftTools::fwd(const IDFT::pointer& dft, const DftTool
 
 DftTools::complex_vector_t DftTools::fwd_r2c(const IDFT::pointer& dft, const DftTools::real_vector_t& vec)
 {
-    complex_vector_t cvec(vec.size());
-    std::transform(vec.begin(), vec.end(), cvec.begin(),
-                   [](float re) { return DftTools::complex_t(re,0.0); } );
-    return fwd(dft, cvec);
+    complex_vector_t spec(vec.size());
+    if (vec.empty()) {
+        return spec;
+    }
+    // Transform to half spectrum and mirror to full.
+    dft->fwd1d_r2c(vec.data(), spec.data(), vec.size());
+    hermitian_mirror(spec.begin(), spec.end());
+    return spec;
 }
 
 DftTools::complex_vector_t DftTools::inv(const IDFT::pointer& dft, const DftTools::complex_vector_t& spec)
@@ -38,14 +42,12 @@ DftTools::complex_vector_t DftTools::inv(const IDFT::pointer& dft, const DftTool
 
 DftTools::real_vector_t DftTools::inv_c2r(const IDFT::pointer& dft, const DftTools::complex_vector_t& spec)
 {
-    // fixme: in future, expand IDFT to have c2r 
-    complex_vector_t symspec(spec.size());
-    hermitian_mirror(spec.begin(), spec.end(), symspec.begin());
-
-    auto cvec = inv(dft, symspec);
-    real_vector_t rvec(cvec.size());
-    std::transform(cvec.begin(), cvec.end(), rvec.begin(),
-                   [](const DftTools::complex_t& c) { return std::real(c); });
+    // The c2r only reads the half spectrum up to Nyquist.
+    real_vector_t rvec(spec.size());
+    if (spec.empty()) {
+        return rvec;
+    }
+    dft->inv1d_c2r(spec.data(), rvec.data(), spec.size());
     return rvec;
 }
 
@@ -124,18 +126,61 @@ DftTools::complex_array_t DftTools::inv(const IDFT::pointer& dft, const DftTools
 }
 
 
+// Implementation notes for fwd_r2c()/inv_c2r():
+//
+// - As for fwd()/inv(), the column-wise storage is given to IDFT
+//   with reversed (nrows, ncols) and axis.
+//
+// - The half spectrum is transformed into, or from, a contiguous
+//   array of the half shape and the full spectrum is formed by
+//   Hermitian mirroring.
+
 DftTools::complex_array_t DftTools::fwd_r2c(const IDFT::pointer& dft, const DftTools::real_array_t& wave, int axis)
 {
-    complex_array_t cwave = wave.cast<complex_t>();
-    return fwd(dft, cwave, axis);
+    const int nrows = wave.rows(), ncols = wave.cols();
+    complex_array_t spec(nrows, ncols);
+    if (!nrows or !ncols) {
+        return spec;
+    }
+    real_array_t cwave = wave;  // assure column-major storage
+
+    if (axis) {
+        const int nhalf = ncols/2 + 1;
+        // The half spectrum are the first nhalf columns.
+        dft->fwd1b_r2c(cwave.data(), spec.data(), ncols, nrows, 0);
+        for (int icol=nhalf; icol<ncols; ++icol) {
+            spec.col(icol) = spec.col(ncols - icol).conjugate();
+        }
+        return spec;
+    }
+
+    const int nhalf = nrows/2 + 1;
+    complex_array_t half(nhalf, ncols);
+    dft->fwd1b_r2c(cwave.data(), half.data(), ncols, nrows, 1);
+    spec.topRows(nhalf) = half;
+    for (int irow=nhalf; irow<nrows; ++irow) {
+        spec.row(irow) = half.row(nrows - irow).conjugate();
+    }
+    return spec;
 }
 
 DftTools::real_array_t DftTools::inv_c2r(const IDFT::pointer& dft, const DftTools::complex_array_t& spec, int axis)
 {
-    complex_array_t symspec = hermitian_mirror(spec, axis);
-    complex_array_t cwave = inv(dft, symspec, axis);
-    // Drops the small imaginary that is accrued due to round-off errors.
-    return cwave.real();        
+    const int nrows = spec.rows(), ncols = spec.cols();
+    real_array_t wave(nrows, ncols);
+    if (!nrows or !ncols) {
+        return wave;
+    }
+
+    // The c2r only reads the half spectrum up to Nyquist.
+    if (axis) {
+        complex_array_t half = spec.leftCols(ncols/2 + 1);
+        dft->inv1b_c2r(half.data(), wave.data(), ncols, nrows, 0);
+        return wave;
+    }
+    complex_array_t half = spec.topRows(nrows/2 + 1);
+    dft->inv1b_c2r(half.data(), wave.data(), ncols, nrows, 1);
+    return wave;
 }
 
 
@@ -2,41 +2,121 @@
 #include "WireCellUtil/NamedFactory.h"
 
 #include <fftw3.h>
+#include <atomic>
 #include <mutex>
 #include <shared_mutex>
 #include <unordered_map>
+#include <algorithm>
+#include <cstring>
 
-WIRECELL_FACTORY(FftwDFT, WireCell::Aux::FftwDFT, WireCell::IDFT)
+#include <boost/container_hash/hash.hpp>
+
+WIRECELL_FACTORY(FftwDFT, WireCell::Aux::FftwDFT,
+                 WireCell::INamed,
+                 WireCell::IDFT,
+                 WireCell::IConfigurable,
+                 WireCell::ITerminal)
 
 
 using namespace WireCell;
 
-using plan_key_t = int64_t;
 using plan_type = fftwf_plan;
-using plan_map_t = std::unordered_map<plan_key_t, plan_type>;
 using plan_val_t = fftwf_complex;
 
-// Make a key by which a plan is known.  dir should be FFTW_FORWARD or
-// FFTW_BACKWARD and "axis" is -1 for all or in {0,1} for one of 2D.
-// For 1D, use the default axis=-1.
-//
-// Imp note: The key is slightly over-specified as we keep one
-// independent cache for each of the six methods.  The "dir" is
-// thus redundant.
+// A plan is known only by the geometry of its transform: the array
+// shape, the "axis" (-1 for all or in {0,1} for one of 2D) and whether
+// it is applied in-place, and by the planning rigor of the instance
+// asking for it.  It does not depend on the addresses of the arrays as
+// all plans are made on, and executed with, SIMD-aligned arrays.  See
+// doit().  Each method keeps its own cache so the direction and type
+// of transform need not be part of the key.
+struct plan_key_t {
+    int nrows, ncols, axis;
+    bool inplace;
+    unsigned rigor;
+    bool operator==(const plan_key_t& other) const {
+        return nrows == other.nrows && ncols == other.ncols
+            && axis == other.axis && inplace == other.inplace
+            && rigor == other.rigor;
+    }
+};
+struct plan_key_hash {
+    size_t operator()(const plan_key_t& key) const {
+        size_t seed = 0;
+        boost::hash_combine(seed, key.nrows);
+        boost::hash_combine(seed, key.ncols);
+        boost::hash_combine(seed, key.axis);
+        boost::hash_combine(seed, key.inplace);
+        boost::hash_combine(seed, key.rigor);
+        return seed;
+    }
+};
+using plan_map_t = std::unordered_map<plan_key_t, plan_type, plan_key_hash>;
+
+static
+plan_key_t make_key(unsigned rigor, const void * src, const void * dst, int nrows, int ncols, int axis=-1)
+{
+    return plan_key_t{nrows, ncols, axis, src == dst, rigor};
+}
+
+// The FFTW planner and its wisdom are global and not thread safe.
+static std::mutex g_planner_mutex;
+
+// Plan cache statistics, see FftwDFT::plan_stats().
+static std::atomic<size_t> g_hits{0}, g_misses{0}, g_plans{0}, g_copies{0};
+
+// A SIMD-aligned buffer.
+struct AlignedBuffer {
+    void* ptr;
+    explicit AlignedBuffer(size_t nbytes) : ptr(fftwf_malloc(nbytes)) {
+        if (!ptr) {
+            THROW(RuntimeError() << errmsg{"FftwDFT: failed to allocate aligned buffer"});
+        }
+    }
+    ~AlignedBuffer() { fftwf_free(ptr); }
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+};
+
 static
-plan_key_t make_key(const void * src, void * dst, int nrows, int ncols, int dir, int axis=-1)
+bool is_aligned(const void* ptr)
 {
-    ++axis;                     // need three positive values, default is both axis 
-    bool inverse = dir == FFTW_BACKWARD;
-    bool inplace = (dst==src);
-    bool aligned = ( (reinterpret_cast<size_t>(src)&15) | (reinterpret_cast<size_t>(dst)&15) ) == 0;
-    int64_t key = ( ( (((int64_t)nrows) << 32)| (ncols<<5 ) | (axis<<3) | (inverse<<2) | (inplace<<1) | aligned ) << 1 ) + 1;
-    return key;
+    return fftwf_alignment_of(reinterpret_cast<float*>(const_cast<void*>(ptr))) == 0;
 }
 
+// Plans are made on aligned scratch arrays with the in-place-ness of
+// the user arrays.  This keeps the planner, which overwrites its
+// arrays when it measures, away from user data.
+template<typename InType, typename OutType>
+struct PlanArrays {
+    InType* in;
+    OutType* out;
+    unsigned flags;
+
+    PlanArrays(InType* src, OutType* dst, size_t nin, size_t nout, unsigned flags = FFTW_ESTIMATE)
+        : flags(flags)
+    {
+        if ((void*)src == (void*)dst) {
+            const size_t nbytes = std::max(nin*sizeof(InType), nout*sizeof(OutType));
+            in = reinterpret_cast<InType*>(fftwf_malloc(nbytes));
+            out = reinterpret_cast<OutType*>(in);
+            return;
+        }
+        in = reinterpret_cast<InType*>(fftwf_malloc(nin*sizeof(InType)));
+        out = reinterpret_cast<OutType*>(fftwf_malloc(nout*sizeof(OutType)));
+    }
+    ~PlanArrays() {
+        if ((void*)in != (void*)out) {
+            fftwf_free(out);
+        }
+        fftwf_free(in);
+    }
+};
+using c2c_arrays = PlanArrays<plan_val_t, plan_val_t>;
+
 // Look up a plan by key or return NULL
 static
-plan_type get_plan(std::shared_mutex& mutex, plan_map_t& plans, plan_key_t key)
+plan_type get_plan(std::shared_mutex& mutex, plan_map_t& plans, const plan_key_t& key)
 {
     std::shared_lock lock(mutex);
     auto it = plans.find(key);
@@ -52,29 +132,56 @@ plan_type get_plan(std::shared_mutex& mutex, plan_map_t& plans, plan_key_t key)
 using planner_function = std::function<plan_type()>;
 
 // This wraps plan lookup, possible plan creation and subsequent plan
-// execution so that we get thread-safe plan caching.
-template<typename ValueType>
-void doit(std::shared_mutex& mutex, plan_map_t& plans, plan_key_t key,
-          ValueType* src, ValueType* dst,
-          planner_function make_plan,
-          std::function<void(const plan_type, ValueType*, ValueType*)> exec_plan)
+// execution so that we get thread-safe plan caching.  The src/dst
+// hold nin/nout elements.  When either is not SIMD-aligned the plan
+// is executed on aligned copies.
+template<typename InType, typename OutType, typename Executor>
+void doit(std::shared_mutex& mutex, plan_map_t& plans, const plan_key_t& key,
+          InType* src, OutType* dst, size_t nin, size_t nout,
+          planner_function make_plan, Executor exec_plan)
 {
     auto plan = get_plan(mutex, plans, key);
-    if (!plan) {
+    if (plan) {
+        ++g_hits;
+    }
+    else {
+        ++g_misses;
         std::unique_lock lock(mutex);
         // Check again in case another thread snakes us.
         auto it = plans.find(key);
         if (it == plans.end()) {
             //std::cerr << "make plan for " << key << std::endl;
+            std::lock_guard<std::mutex> plock(g_planner_mutex);
             plan = make_plan();
+            if (!plan) {
+                THROW(RuntimeError() << errmsg{"FftwDFT: failed to make plan"});
+            }
             plans[key] = plan;
+            ++g_plans;
         }
         else {
             plan = it->second;
         }
     }
-    //fftwf_execute_dft(plan, src, dst);
-    exec_plan(plan, src, dst);
+
+    if (is_aligned(src) and is_aligned(dst)) {
+        exec_plan(plan, src, dst);
+        return;
+    }
+
+    ++g_copies;
+    const size_t nbin = nin*sizeof(InType), nbout = nout*sizeof(OutType);
+    if (key.inplace) {
+        AlignedBuffer buf(std::max(nbin, nbout));
+        std::memcpy(buf.ptr, src, nbin);
+        exec_plan(plan, reinterpret_cast<InType*>(buf.ptr), reinterpret_cast<OutType*>(buf.ptr));
+        std::memcpy(dst, buf.ptr, nbout);
+        return;
+    }
+    AlignedBuffer ibuf(nbin), obuf(nbout);
+    std::memcpy(ibuf.ptr, src, nbin);
+    exec_plan(plan, reinterpret_cast<InType*>(ibuf.ptr), reinterpret_cast<OutType*>(obuf.ptr));
+    std::memcpy(dst, obuf.ptr, nbout);
 }
 
 
@@ -92,9 +199,10 @@ void Aux::FftwDFT::fwd1d(const complex_t* in, complex_t* out, int ncols) const
     static const int dir = FFTW_FORWARD;
     auto src = pval_cast(in);
     auto dst = pval_cast(out);
-    auto key = make_key(src, dst, 1, ncols, dir);
-    doit<plan_val_t>(mutex, plans, key, src, dst, [&]( ) {
-        return fftwf_plan_dft_1d(ncols, src, dst, dir, FFTW_ESTIMATE|FFTW_PRESERVE_INPUT);
+    auto key = make_key(m_rigor, src, dst, 1, ncols);
+    doit(mutex, plans, key, src, dst, ncols, ncols, [&]( ) {
+        c2c_arrays pa(src, dst, ncols, ncols, key.rigor | FFTW_PRESERVE_INPUT);
+        return fftwf_plan_dft_1d(ncols, pa.in, pa.out, dir, pa.flags);
     }, fftwf_execute_dft);
 }
 void Aux::FftwDFT::inv1d(const complex_t* in, complex_t* out, int ncols) const
@@ -104,10 +212,11 @@ void Aux::FftwDFT::inv1d(const complex_t* in, complex_t* out, int ncols) const
     static const int dir = FFTW_BACKWARD;
     auto src = pval_cast(in);
     auto dst = pval_cast(out);
-    auto key = make_key(src, dst, 1, ncols, dir);
+    auto key = make_key(m_rigor, src, dst, 1, ncols);
 
-    doit<plan_val_t>(mutex, plans, key, src, dst, [&]( ) {
-        return fftwf_plan_dft_1d(ncols, src, dst, dir, FFTW_ESTIMATE|FFTW_PRESERVE_INPUT);
+    doit(mutex, plans, key, src, dst, ncols, ncols, [&]( ) {
+        c2c_arrays pa(src, dst, ncols, ncols, key.rigor | FFTW_PRESERVE_INPUT);
+        return fftwf_plan_dft_1d(ncols, pa.in, pa.out, dir, pa.flags);
     }, fftwf_execute_dft);
 
     // Apply 1/n normalization
@@ -117,8 +226,9 @@ void Aux::FftwDFT::inv1d(const complex_t* in, complex_t* out, int ncols) const
 }
 
 
+static
 fftwf_plan plan_1b(fftwf_complex *in, fftwf_complex *out,
-                   int nrows, int ncols, int sign, int axis)
+                   int nrows, int ncols, int sign, int axis, unsigned rigor)
 {
     // (r,c) element at in + r*stride + c*dist
 
@@ -135,14 +245,14 @@ fftwf_plan plan_1b(fftwf_complex *in, fftwf_complex *out,
     }
     int *inembed=&n, *onembed=&n;
 
-    unsigned int flags =  FFTW_ESTIMATE|FFTW_PRESERVE_INPUT;
+    c2c_arrays pa(in, out, nrows*ncols, nrows*ncols, rigor | FFTW_PRESERVE_INPUT);
 
     return fftwf_plan_many_dft(rank, &n, howmany,
-                               in, inembed,
+                               pa.in, inembed,
                                stride, dist,
-                               out, onembed,
+                               pa.out, onembed,
                                stride, dist,
-                               sign, flags);
+                               sign, pa.flags);
 }
 
 
@@ -153,10 +263,10 @@ void Aux::FftwDFT::fwd1b(const complex_t* in, complex_t* out, int nrows, int nco
     static const int dir = FFTW_FORWARD;
     auto src = pval_cast(in);
     auto dst = pval_cast(out);
-    auto key = make_key(src, dst, nrows, ncols, dir, axis);
+    auto key = make_key(m_rigor, src, dst, nrows, ncols, axis);
 
-    doit<plan_val_t>(mutex, plans, key, src, dst, [&]( ) {
-        return plan_1b(src, dst, nrows, ncols, dir, axis);
+    doit(mutex, plans, key, src, dst, nrows*ncols, nrows*ncols, [&]( ) {
+        return plan_1b(src, dst, nrows, ncols, dir, axis, key.rigor);
     }, fftwf_execute_dft);
 }
 
@@ -168,10 +278,10 @@ void Aux::FftwDFT::inv1b(const complex_t* in, complex_t* out, int nrows, int nco
     static const int dir = FFTW_BACKWARD;
     auto src = pval_cast(in);
     auto dst = pval_cast(out);
-    auto key = make_key(src, dst, nrows, ncols, dir, axis);
+    auto key = make_key(m_rigor, src, dst, nrows, ncols, axis);
 
-    doit<plan_val_t>(mutex, plans, key, src, dst, [&]( ) {
-        return plan_1b(src, dst, nrows, ncols, dir, axis);
+    doit(mutex, plans, key, src, dst, nrows*ncols, nrows*ncols, [&]( ) {
+        return plan_1b(src, dst, nrows, ncols, dir, axis, key.rigor);
     }, fftwf_execute_dft);
 
     // 1/n normalization
@@ -190,9 +300,10 @@ void Aux::FftwDFT::fwd2d(const complex_t* in, complex_t* out, int nrows, int nco
     static const int dir = FFTW_FORWARD;
     auto src = pval_cast(in);
     auto dst = pval_cast(out);
-    auto key = make_key(src, dst, nrows, ncols, dir);
-    doit<plan_val_t>(mutex, plans, key, src, dst, [&]( ) {
-        return fftwf_plan_dft_2d(ncols, nrows, src, dst, dir, FFTW_ESTIMATE|FFTW_PRESERVE_INPUT);
+    auto key = make_key(m_rigor, src, dst, nrows, ncols);
+    doit(mutex, plans, key, src, dst, nrows*ncols, nrows*ncols, [&]( ) {
+        c2c_arrays pa(src, dst, nrows*ncols, nrows*ncols, key.rigor | FFTW_PRESERVE_INPUT);
+        return fftwf_plan_dft_2d(ncols, nrows, pa.in, pa.out, dir, pa.flags);
     }, fftwf_execute_dft);
 }
 
@@ -204,9 +315,10 @@ void Aux::FftwDFT::inv2d(const complex_t* in, complex_t* out, int nrows, int nco
     static const int dir = FFTW_BACKWARD;
     auto src = pval_cast(in);
     auto dst = pval_cast(out);
-    auto key = make_key(src, dst, nrows, ncols, dir);
-    doit<plan_val_t>(mutex, plans, key, src, dst, [&]( ) {
-        return fftwf_plan_dft_2d(ncols, nrows, src, dst, dir, FFTW_ESTIMATE|FFTW_PRESERVE_INPUT);
+    auto key = make_key(m_rigor, src, dst, nrows, ncols);
+    doit(mutex, plans, key, src, dst, nrows*ncols, nrows*ncols, [&]( ) {
+        c2c_arrays pa(src, dst, nrows*ncols, nrows*ncols, key.rigor | FFTW_PRESERVE_INPUT);
+        return fftwf_plan_dft_2d(ncols, nrows, pa.in, pa.out, dir, pa.flags);
     }, fftwf_execute_dft);
 
     // reverse normalization
@@ -217,6 +329,147 @@ void Aux::FftwDFT::inv2d(const complex_t* in, complex_t* out, int nrows, int nco
 }
 
 
+// Real input / half-spectrum.  All use the advanced interface with a
+// single rank=1 or rank=2 transform or a batch of rank=1 transforms
+// along one axis.
+
+// Plan a batch of r2c (sign=FFTW_FORWARD) or c2r transforms along the
+// given axis of a real (nrows,ncols) array.  For 1d use nrows=1.
+static
+plan_type plan_1b_real(float* real, plan_val_t* cplx,
+                       int nrows, int ncols, int axis, int sign, unsigned flags)
+{
+    int n = ncols;              // along rows
+    int howmany = nrows;
+    int stride = 1;
+    int rdist = ncols;
+    int cdist = ncols/2 + 1;
+    int nhalf = nrows*cdist;
+    if (axis == 0) {            // along columns
+        n = nrows;
+        howmany = ncols;
+        stride = ncols;
+        rdist = cdist = 1;
+        nhalf = (nrows/2 + 1)*ncols;
+    }
+
+    if (sign == FFTW_FORWARD) {
+        PlanArrays<float, plan_val_t> pa(real, cplx, nrows*ncols, nhalf, flags);
+        return fftwf_plan_many_dft_r2c(1, &n, howmany,
+                                       pa.in, NULL, stride, rdist,
+                                       pa.out, NULL, stride, cdist,
+                                       pa.flags);
+    }
+    PlanArrays<plan_val_t, float> pa(cplx, real, nhalf, nrows*ncols, flags);
+    return fftwf_plan_many_dft_c2r(1, &n, howmany,
+                                   pa.in, NULL, stride, cdist,
+                                   pa.out, NULL, stride, rdist,
+                                   pa.flags);
+}
+
+// Divide by n
+static
+void normalize(float* out, int size, int norm)
+{
+    const float scale = 1.0/norm;
+    for (int ind=0; ind<size; ++ind) {
+        out[ind] *= scale;
+    }
+}
+
+void Aux::FftwDFT::fwd1d_r2c(const scalar_t* in, complex_t* out, int size) const
+{
+    fwd1b_r2c(in, out, 1, size, 1);
+}
+
+void Aux::FftwDFT::inv1d_c2r(const complex_t* in, scalar_t* out, int size) const
+{
+    inv1b_c2r(in, out, 1, size, 1);
+}
+
+void Aux::FftwDFT::fwd1b_r2c(const scalar_t* in, complex_t* out,
+                             int nrows, int ncols, int axis) const
+{
+    static std::shared_mutex mutex;
+    static plan_map_t plans;
+    static const int dir = FFTW_FORWARD;
+    auto src = const_cast<float*>(in);
+    auto dst = pval_cast(out);
+    auto key = make_key(m_rigor, src, dst, nrows, ncols, axis);
+
+    const int nhalf = axis ? nrows*(ncols/2+1) : (nrows/2+1)*ncols;
+    doit(mutex, plans, key, src, dst, nrows*ncols, nhalf, [&]( ) {
+        return plan_1b_real(src, dst, nrows, ncols, axis, dir, key.rigor | FFTW_PRESERVE_INPUT);
+    }, fftwf_execute_dft_r2c);
+}
+
+void Aux::FftwDFT::inv1b_c2r(const complex_t* in, scalar_t* out,
+                             int nrows, int ncols, int axis) const
+{
+    static std::shared_mutex mutex;
+    static plan_map_t plans;
+    static const int dir = FFTW_BACKWARD;
+    auto src = pval_cast(in);
+    auto dst = out;
+    auto key = make_key(m_rigor, src, dst, nrows, ncols, axis);
+
+    // Rank=1 c2r supports preserving the input.
+    const int nhalf = axis ? nrows*(ncols/2+1) : (nrows/2+1)*ncols;
+    doit(mutex, plans, key, src, dst, nhalf, nrows*ncols, [&]( ) {
+        return plan_1b_real(dst, src, nrows, ncols, axis, dir, key.rigor | FFTW_PRESERVE_INPUT);
+    }, fftwf_execute_dft_c2r);
+
+    normalize(out, nrows*ncols, axis ? ncols : nrows);
+}
+
+void Aux::FftwDFT::fwd2d_r2c(const scalar_t* in, complex_t* out,
+                             int nrows, int ncols) const
+{
+    static std::shared_mutex mutex;
+    static plan_map_t plans;
+    auto src = const_cast<float*>(in);
+    auto dst = pval_cast(out);
+    auto key = make_key(m_rigor, src, dst, nrows, ncols);
+
+    const int nhalf = nrows*(ncols/2+1);
+    doit(mutex, plans, key, src, dst, nrows*ncols, nhalf, [&]( ) {
+        int n[2] = {nrows, ncols};
+        PlanArrays<float, plan_val_t> pa(src, dst, nrows*ncols, nhalf, key.rigor | FFTW_PRESERVE_INPUT);
+        return fftwf_plan_many_dft_r2c(2, n, 1,
+                                       pa.in, NULL, 1, 0,
+                                       pa.out, NULL, 1, 0,
+                                       pa.flags);
+    }, fftwf_execute_dft_r2c);
+}
+
+void Aux::FftwDFT::inv2d_c2r(const complex_t* in, scalar_t* out,
+                             int nrows, int ncols) const
+{
+    static std::shared_mutex mutex;
+    static plan_map_t plans;
+
+    // Multi-dimensional c2r can not preserve its input so transform
+    // a copy.  The copy is always SIMD-aligned.
+    const int nhalf = nrows*(ncols/2+1);
+    AlignedBuffer copy(nhalf*sizeof(plan_val_t));
+    auto src = reinterpret_cast<plan_val_t*>(copy.ptr);
+    std::copy(in, in+nhalf, reinterpret_cast<complex_t*>(src));
+    auto dst = out;
+    auto key = make_key(m_rigor, src, dst, nrows, ncols);
+
+    doit(mutex, plans, key, src, dst, nhalf, nrows*ncols, [&]( ) {
+        int n[2] = {nrows, ncols};
+        PlanArrays<plan_val_t, float> pa(src, dst, nhalf, nrows*ncols, key.rigor | FFTW_DESTROY_INPUT);
+        return fftwf_plan_many_dft_c2r(2, n, 1,
+                                       pa.in, NULL, 1, 0,
+                                       pa.out, NULL, 1, 0,
+                                       pa.flags);
+    }, fftwf_execute_dft_c2r);
+
+    normalize(out, nrows*ncols, nrows*ncols);
+}
+
+
 // based on example from fftw3 faq
 static
 plan_type transpose_plan_complex(plan_val_t *in, plan_val_t *out, int rows, int cols)
@@ -241,12 +494,12 @@ void Aux::FftwDFT::transpose(const complex_t* in, complex_t* out,
 {
     static std::shared_mutex mutex;
     static plan_map_t plans;
-    static const int dir = 0;
     auto src = pval_cast(in);
     auto dst = pval_cast(out);
-    auto key = make_key(src, dst, nrows, ncols, dir);
-    doit<plan_val_t>(mutex, plans, key, src, dst, [&]( ) {
-        return transpose_plan_complex(src, dst, nrows, ncols);
+    auto key = make_key(FFTW_ESTIMATE, src, dst, nrows, ncols);
+    doit(mutex, plans, key, src, dst, nrows*ncols, nrows*ncols, [&]( ) {
+        c2c_arrays pa(src, dst, nrows*ncols, nrows*ncols);
+        return transpose_plan_complex(pa.in, pa.out, nrows, ncols);
     }, fftwf_execute_dft);
 }
 
@@ -273,19 +526,91 @@ void Aux::FftwDFT::transpose(const scalar_t* in, scalar_t* out,
 {
     static std::shared_mutex mutex;
     static plan_map_t plans;
-    static const int dir = 0;
     auto src = const_cast<scalar_t*>(in);
     auto dst = out;
-    auto key = make_key(src, dst, nrows, ncols, dir);
-    doit<float>(mutex, plans, key, src, dst, [&]( ) {
-        return transpose_plan_real(src, dst, nrows, ncols);
+    auto key = make_key(FFTW_ESTIMATE, src, dst, nrows, ncols);
+    doit(mutex, plans, key, src, dst, nrows*ncols, nrows*ncols, [&]( ) {
+        PlanArrays<float, float> pa(src, dst, nrows*ncols, nrows*ncols);
+        return transpose_plan_real(pa.in, pa.out, nrows, ncols);
     }, fftwf_execute_r2r);
 }
 
 Aux::FftwDFT::FftwDFT()
+    : Aux::Logger("FftwDFT", "aux")
+    , m_rigor(FFTW_ESTIMATE)
 {
 }
 Aux::FftwDFT::~FftwDFT()
 {
 }
 
+WireCell::Configuration Aux::FftwDFT::default_configuration() const
+{
+    Configuration cfg;
+    // The rigor with which new plans are made.  One of "estimate",
+    // "measure" or "patient".  More rigor takes more time to plan
+    // but may find faster plans.  Plans are shared by all instances
+    // configured with the same planning.
+    cfg["planning"] = "estimate";
+    // If nonempty, name a FFTW wisdom file to load on configuration.
+    // A file that does not exist is not an error.
+    cfg["wisdom"] = m_wisdom;
+    // If true and "wisdom" is set, save accumulated wisdom back to
+    // the file on finalize.
+    cfg["save_wisdom"] = m_save_wisdom;
+    return cfg;
+}
+
+void Aux::FftwDFT::configure(const WireCell::Configuration& cfg)
+{
+    const std::string planning = get<std::string>(cfg, "planning", "estimate");
+    if (planning == "estimate") {
+        m_rigor = FFTW_ESTIMATE;
+    }
+    else if (planning == "measure") {
+        m_rigor = FFTW_MEASURE;
+    }
+    else if (planning == "patient") {
+        m_rigor = FFTW_PATIENT;
+    }
+    else {
+        raise<ValueError>("FftwDFT: unknown planning \"%s\"", planning);
+    }
+
+    m_wisdom = get(cfg, "wisdom", m_wisdom);
+    m_save_wisdom = get(cfg, "save_wisdom", m_save_wisdom);
+    if (m_wisdom.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> plock(g_planner_mutex);
+    if (fftwf_import_wisdom_from_filename(m_wisdom.c_str())) {
+        log->debug("loaded wisdom from {}, planning: {}", m_wisdom, planning);
+    }
+    else {
+        log->debug("no wisdom loaded from {}, planning: {}", m_wisdom, planning);
+    }
+}
+
+Aux::FftwDFT::PlanStats Aux::FftwDFT::plan_stats()
+{
+    return PlanStats{g_hits, g_misses, g_plans, g_copies};
+}
+
+void Aux::FftwDFT::finalize()
+{
+    const auto ps = plan_stats();
+    log->debug("plan cache: hits={} misses={} plans={} unaligned={}",
+               ps.hits, ps.misses, ps.plans, ps.copies);
+
+    if (m_wisdom.empty() or !m_save_wisdom) {
+        return;
+    }
+    std::lock_guard<std::mutex> plock(g_planner_mutex);
+    if (fftwf_export_wisdom_to_filename(m_wisdom.c_str())) {
+        log->debug("saved wisdom to {}", m_wisdom);
+    }
+    else {
+        log->warn("failed to save wisdom to {}", m_wisdom);
+    }
+}
+
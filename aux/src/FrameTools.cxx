@@ -172,7 +172,7 @@ std::pair<int, int> Aux::tbin_range(const ITrace::vector& traces)
         const auto& trace = traces[ind];
         const int tbin = trace->tbin();
         tbins[ind] = tbin;
-        tlens[ind] = tbin + trace->charge().size();
+        tlens[ind] = tbin + trace->nsamples();
     }
     return std::pair<int, int>(*std::min_element(tbins.begin(), tbins.end()),
                                *std::max_element(tlens.begin(), tlens.end()));
@@ -199,8 +199,8 @@ void Aux::fill(Array::array_xxf& array, const ITrace::vector& traces, channel_li
         }
         const int irow = it->second;
 
-        const auto& charge = trace->charge();
-        const int nticks = charge.size();
+        const float* charge = trace->samples();
+        const int nticks = trace->nsamples();
         const int dtbin = trace->tbin() - tbin;
         int icol0 = 0, itick0 = 0;
         if (dtbin < 0) {
@@ -217,7 +217,7 @@ void Aux::fill(Array::array_xxf& array, const ITrace::vector& traces, channel_li
         }
         const int nleft = std::min(ncols_left, nticks_left);
         for (int ind = 0; ind != nleft; ++ind) {
-            array(irow, icol0 + ind) += charge.at(itick0 + ind);
+            array(irow, icol0 + ind) += charge[itick0 + ind];
         }
     }
 }
@@ -335,8 +335,8 @@ void Aux::raster(WireCell::Array::array_xxf& block, WireCell::ITrace::vector tra
 
     const size_t ncols = block.cols();
     for (auto trace : traces) {
-        const auto& samples = trace->charge();
-        const size_t nsamples = samples.size();
+        const float* samples = trace->samples();
+        const size_t nsamples = trace->nsamples();
         const size_t tbin = trace->tbin();
 
         if (tbin >= ncols) {  // underflow impossible as they are unsigned.
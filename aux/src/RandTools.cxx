@@ -6,8 +6,9 @@ using namespace WireCell::Aux::RandTools;
 
 
 Recycling::Recycling(generator_f gen, generator_f uni,
-                     size_t capacity, double replacement_fraction)
-    : gen(gen), uni(uni), repfrac(replacement_fraction)
+                     size_t capacity, double replacement_fraction,
+                     filler_f fill)
+    : gen(gen), uni(uni), fill(fill), repfrac(replacement_fraction)
 {
     resize(capacity);
 }
@@ -17,8 +18,13 @@ void Recycling::resize(size_t capacity)
     const size_t oldsize = ring.size();
     ring.resize(capacity, 0);
     if (capacity > oldsize) {
-        for (size_t ind=oldsize; ind<capacity; ++ind) {
-            ring[ind] = gen();
+        if (fill) {
+            fill(ring.data() + oldsize, capacity - oldsize);
+        }
+        else {
+            for (size_t ind=oldsize; ind<capacity; ++ind) {
+                ring[ind] = gen();
+            }
         }
     }
     size_t jump = 1/repfrac;
@@ -75,8 +81,8 @@ real_vector_t Recycling::operator()(size_t size)
 
 
 
-Fresh::Fresh(generator_f  gen)
-    : gen(gen)
+Fresh::Fresh(generator_f  gen, filler_f fill)
+    : gen(gen), fill(fill)
 {
 }
 
@@ -87,6 +93,11 @@ float Fresh::operator()() {
 real_vector_t Fresh::operator()(size_t size)
 {
     real_vector_t ret(size, 0);
-    std::generate(ret.begin(), ret.end(), gen);
+    if (fill) {
+        fill(ret.data(), size);
+    }
+    else {
+        std::generate(ret.begin(), ret.end(), gen);
+    }
     return ret;
 }
@@ -355,7 +355,8 @@ IFrame::pointer WireCell::Aux::TensorDM::as_frame(const TensorIndex& ti,
                 raise<ValueError>("malformed tracedata datapath in frame tensor");
             }
             auto tdpath = jtdpath.asString();
-            const bool share = false; // was true
+            // td is only read here and does not outlive ti.
+            const bool share = true;
             PC::Dataset td = as_dataset(ti, tdpath, share);
             // dump_dataset(td, tdpath);
             auto tdmd = td.metadata();
@@ -10,14 +10,16 @@ using namespace WireCell::Aux;
 using namespace WireCell::Aux::TensorDM;
 
 WireCell::Aux::TensorDM::named_pointclouds_t
-WireCell::Aux::TensorDM::as_pcnamedset(const ITensor::vector& tens, const std::string& datapath)
+WireCell::Aux::TensorDM::as_pcnamedset(const ITensor::vector& tens, const std::string& datapath,
+                                       bool share)
 {
     TensorIndex ti(tens);
-    return as_pcnamedset(ti, datapath);
+    return as_pcnamedset(ti, datapath, share);
 }
 
 WireCell::Aux::TensorDM::named_pointclouds_t
-WireCell::Aux::TensorDM::as_pcnamedset(const TensorIndex& ti, const std::string& datapath)
+WireCell::Aux::TensorDM::as_pcnamedset(const TensorIndex& ti, const std::string& datapath,
+                                       bool share)
 {
     named_pointclouds_t ret;
     auto top = ti.at(datapath, "pcnamedset");
@@ -26,7 +28,7 @@ WireCell::Aux::TensorDM::as_pcnamedset(const TensorIndex& ti, const std::string&
     for (const auto& name : items.getMemberNames()) {
         const auto path = items[name].asString();
 
-        auto ds = as_dataset(ti, path);
+        auto ds = as_dataset(ti, path, share);
         ret.emplace(name, ds);
     }
     return ret;
@@ -159,9 +161,12 @@ WireCell::Aux::TensorDM::as_pctree(const TensorIndex& ti,
         nodes.push_back(node);
     }
 
+    // The aggregate point clouds only live in this scope and each
+    // local PC copies its slice so they may share the tensor arrays.
+    const bool share = true;
     auto const& md = top->metadata();        
-    auto pointclouds = as_pcnamedset(ti, md["pointclouds"].asString());
-    auto lpcmaps_ds = as_dataset(ti, md["lpcmaps"].asString());
+    const auto pointclouds = as_pcnamedset(ti, md["pointclouds"].asString(), share);
+    const auto lpcmaps_ds = as_dataset(ti, md["lpcmaps"].asString(), share);
 
     // Loop cross product of (PC name,node)
     for (const auto& [pcname, pcds] : pointclouds) {
@@ -3,7 +3,11 @@
 #include "WireCellUtil/Testing.h"
 #include "WireCellUtil/NamedFactory.h"
 
+#include "WireCellAux/SimpleChannel.h"
+#include "WireCellAux/SimpleWire.h"
+
 #include "WireCellIface/IWireSchema.h"
+#include "WireCellUtil/Pimpos.h"
 
 #include <algorithm>            // find
 
@@ -101,3 +105,132 @@ IAnodePlane::vector Testing::anodes(std::string detector)
 }
 
 
+namespace {
+
+    using namespace WireCell;
+
+    class FakePlane : public IWirePlane {
+      public:
+        FakePlane(int ident, int nwires, double pitch)
+          : m_ident(ident)
+          , m_pimpos(nwires, -0.5 * nwires * pitch, 0.5 * nwires * pitch)
+        {
+            for (int ind = 0; ind < nwires; ++ind) {
+                const int chid = 100 * ident + ind;
+                const double z = (ind + 0.5 - 0.5 * nwires) * pitch;
+                const Ray ray(Point(0, -1 * units::m, z), Point(0, 1 * units::m, z));
+                IWire::pointer wire = std::make_shared<Aux::SimpleWire>(WirePlaneId(iplane2layer[ident]),
+                                                                        ind, ind, chid, ray);
+                m_wires.push_back(wire);
+                m_channels.push_back(std::make_shared<Aux::SimpleChannel>(chid, ind, IWire::vector{wire}));
+            }
+        }
+        virtual ~FakePlane() {}
+        virtual int ident() const { return m_ident; }
+        virtual const Pimpos* pimpos() const { return &m_pimpos; }
+        virtual const IWire::vector& wires() const { return m_wires; }
+        virtual const IChannel::vector& channels() const { return m_channels; }
+
+      private:
+        int m_ident;
+        Pimpos m_pimpos;
+        IWire::vector m_wires;
+        IChannel::vector m_channels;
+    };
+
+    class FakeFace : public IAnodeFace {
+      public:
+        FakeFace(int nwires, double pitch)
+        {
+            for (int ind = 0; ind < 3; ++ind) {
+                m_planes.push_back(std::make_shared<FakePlane>(ind, nwires, pitch));
+            }
+        }
+        virtual ~FakeFace() {}
+        virtual int ident() const { return 0; }
+        virtual int which() const { return 0; }
+        virtual int dirx() const { return 1; }
+        virtual int anode() const { return 0; }
+        virtual int nplanes() const { return m_planes.size(); }
+        virtual IWirePlane::pointer plane(int ident) const { return m_planes.at(ident); }
+        virtual IWirePlane::vector planes() const { return m_planes; }
+        virtual BoundingBox sensitive() const
+        {
+            return BoundingBox(Ray(Point(-1 * units::m, -1 * units::m, -1 * units::m),
+                                   Point(1 * units::m, 1 * units::m, 1 * units::m)));
+        }
+        virtual const RayGrid::Coordinates& raygrid() const { return m_coords; }
+
+      private:
+        IWirePlane::vector m_planes;
+        RayGrid::Coordinates m_coords;
+    };
+
+    class FakeAnode : public IAnodePlane {
+      public:
+        virtual ~FakeAnode() {}
+
+        void reshape(int nwires, double pitch)
+        {
+            if (nwires < 1 or nwires > 100) {
+                raise<ValueError>("fake anode needs 1 to 100 wires per plane, got %d", nwires);
+            }
+            m_face = std::make_shared<FakeFace>(nwires, pitch);
+        }
+
+        virtual int ident() const { return 0; }
+        virtual int nfaces() const { return 1; }
+        virtual IAnodeFace::pointer face(int ident) const { return ident ? nullptr : m_face; }
+        virtual IAnodeFace::vector faces() const { return {m_face}; }
+        virtual WirePlaneId resolve(int channel) const
+        {
+            if (!channel_or_null(channel)) {
+                return WirePlaneId(kUnknownLayer);
+            }
+            return WirePlaneId(iplane2layer[channel / 100]);
+        }
+        virtual std::vector<int> channels() const
+        {
+            std::vector<int> ret;
+            for (const auto& plane : m_face->planes()) {
+                for (const auto& ch : plane->channels()) {
+                    ret.push_back(ch->ident());
+                }
+            }
+            return ret;
+        }
+        virtual IChannel::pointer channel(int chident) const { return channel_or_null(chident); }
+        virtual IWire::vector wires(int chident) const
+        {
+            auto ch = channel_or_null(chident);
+            if (!ch) {
+                return {};
+            }
+            return ch->wires();
+        }
+
+      private:
+        IAnodeFace::pointer m_face;
+
+        IChannel::pointer channel_or_null(int chident) const
+        {
+            if (chident < 0 or chident / 100 >= 3) {
+                return nullptr;
+            }
+            const auto& chans = m_face->plane(chident / 100)->channels();
+            const size_t ind = chident % 100;
+            if (ind >= chans.size()) {
+                return nullptr;
+            }
+            return chans[ind];
+        }
+    };
+}
+
+IAnodePlane::pointer Testing::fake_anode(int nwires, double pitch)
+{
+    make_named_factory_factory<FakeAnode, IAnodePlane>("FakeAnode");
+    auto anode = Factory::lookup_tn<IAnodePlane>("FakeAnode");
+    std::dynamic_pointer_cast<FakeAnode>(anode)->reshape(nwires, pitch);
+    return anode;
+}
@@ -0,0 +1,77 @@
+#include "WireCellAux/DenseFrame.h"
+#include "WireCellAux/FrameTools.h"
+#include "WireCellUtil/doctest.h"
+
+#include <vector>
+
+using namespace WireCell;
+using namespace WireCell::Aux;
+
+TEST_CASE("aux dense frame")
+{
+    const std::vector<int> chans = {10, 11, 12};
+    const size_t nticks = 5;
+    const int tbin = 2;
+
+    auto block = std::make_shared<DenseBlock>(chans, nticks, tbin);
+    for (size_t irow = 0; irow < chans.size(); ++irow) {
+        for (size_t icol = 0; icol < nticks; ++icol) {
+            block->row(irow)[icol] = 100 * irow + icol;
+        }
+    }
+    const float* payload = block->data.data();
+
+    auto frame = std::make_shared<DenseFrame>(1, 0.0, block);
+    IFrame::pointer iframe = frame;
+    frame->tag_traces("odd", IFrame::trace_list_t{1});
+
+    auto view = iframe->dense();
+    REQUIRE(view);
+    CHECK(view.data == payload);
+    CHECK(view.nrows == chans.size());
+    CHECK(view.ncols == nticks);
+    CHECK(view.tbin == tbin);
+    CHECK(*view.channels == chans);
+
+    auto arr = dense_map(view);
+    CHECK(arr(2, 3) == 203);
+
+    auto traces = iframe->traces();
+    REQUIRE(traces->size() == chans.size());
+    for (size_t irow = 0; irow < chans.size(); ++irow) {
+        auto trace = traces->at(irow);
+        CHECK(trace->channel() == chans[irow]);
+        CHECK(trace->tbin() == tbin);
+        CHECK(trace->nsamples() == nticks);
+        // zero-copy row view
+        CHECK(trace->samples() == payload + irow * nticks);
+        // legacy access materializes a copy
+        auto dtrace = std::dynamic_pointer_cast<const DenseTrace>(trace);
+        REQUIRE(dtrace);
+        CHECK(!dtrace->charged());
+        const auto& charge = trace->charge();
+        CHECK(dtrace->charged());
+        REQUIRE(charge.size() == nticks);
+        CHECK(charge[4] == 100 * irow + 4);
+        CHECK(&trace->charge() == &charge);
+    }
+    CHECK(iframe->tagged_traces("odd").size() == 1);
+
+    // Round trip through the generic trace tools.
+    Array::array_xxf filled;
+    auto got = Aux::fill(filled, *traces);
+    CHECK(got == chans);
+    CHECK(filled.rows() == 3);
+    CHECK(filled.cols() == (int) nticks);
+    CHECK(filled(1, 2) == 102);
+
+    DenseFrame other(2, 0.0, filled, got, tbin);
+    auto oview = other.dense();
+    CHECK(dense_map(oview).isApprox(arr));
+}
+
+TEST_CASE("aux non-dense frame")
+{
+    SimpleFrame frame(1);
+    CHECK(!frame.dense());
+}
@@ -0,0 +1,193 @@
+#include "WireCellAux/FftwDFT.h"
+#include "WireCellUtil/Persist.h"
+#include "WireCellUtil/doctest.h"
+
+#include <fftw3.h>
+#include <boost/filesystem.hpp>
+
+#include <complex>
+#include <vector>
+
+using namespace WireCell;
+using complex_t = IDFT::complex_t;
+
+static std::shared_ptr<Aux::FftwDFT> make_fftw(const std::string& planning, const std::string& wisdom = "")
+{
+    auto dft = std::make_shared<Aux::FftwDFT>();
+    auto cfg = dft->default_configuration();
+    cfg["planning"] = planning;
+    cfg["wisdom"] = wisdom;
+    dft->configure(cfg);
+    return dft;
+}
+
+static std::vector<complex_t> make_cdata(size_t size)
+{
+    std::vector<complex_t> data(size);
+    for (size_t ind = 0; ind < size; ++ind) {
+        data[ind] = complex_t(std::sin(0.1 * ind), std::cos(0.37 * ind));
+    }
+    return data;
+}
+
+static std::vector<float> make_rdata(size_t size)
+{
+    std::vector<float> data(size);
+    for (size_t ind = 0; ind < size; ++ind) {
+        data[ind] = std::sin(0.1 * ind) + 0.01 * ind;
+    }
+    return data;
+}
+
+template <typename T>
+static void require_close(const std::vector<T>& a, const std::vector<T>& b)
+{
+    REQUIRE(a.size() == b.size());
+    for (size_t ind = 0; ind < a.size(); ++ind) {
+        REQUIRE(std::abs(a[ind] - b[ind]) < 1e-3);
+    }
+}
+
+TEST_CASE("fftwdft measured plans leave input intact")
+{
+    auto est = make_fftw("estimate");
+    auto mea = make_fftw("measure");
+
+    const int nrows = 16, ncols = 24, size = nrows * ncols;
+    const auto cin = make_cdata(size);
+    const auto rin = make_rdata(size);
+
+    // Each call is given a fresh copy of the input which must come
+    // back unchanged and give the same result as an estimated plan.
+    auto check_c2c = [&](auto method) {
+        auto in = cin;
+        std::vector<complex_t> out(size), want(size);
+        method(*mea, in.data(), out.data());
+        REQUIRE(in == cin);
+        method(*est, in.data(), want.data());
+        require_close(out, want);
+    };
+    check_c2c([&](const IDFT& dft, const complex_t* in, complex_t* out) { dft.fwd1d(in, out, size); });
+    check_c2c([&](const IDFT& dft, const complex_t* in, complex_t* out) { dft.inv1d(in, out, size); });
+    check_c2c([&](const IDFT& dft, const complex_t* in, complex_t* out) { dft.fwd2d(in, out, nrows, ncols); });
+    check_c2c([&](const IDFT& dft, const complex_t* in, complex_t* out) { dft.inv2d(in, out, nrows, ncols); });
+    for (int axis : {0, 1}) {
+        check_c2c([&](const IDFT& dft, const complex_t* in, complex_t* out) { dft.fwd1b(in, out, nrows, ncols, axis); });
+        check_c2c([&](const IDFT& dft, const complex_t* in, complex_t* out) { dft.inv1b(in, out, nrows, ncols, axis); });
+    }
+
+    for (int axis : {0, 1}) {
+        auto in = rin;
+        const int nhalf = axis ? nrows * (ncols / 2 + 1) : (nrows / 2 + 1) * ncols;
+        std::vector<complex_t> spec(nhalf), want(nhalf);
+        mea->fwd1b_r2c(in.data(), spec.data(), nrows, ncols, axis);
+        REQUIRE(in == rin);
+        est->fwd1b_r2c(in.data(), want.data(), nrows, ncols, axis);
+        require_close(spec, want);
+
+        const auto spec0 = spec;
+        std::vector<float> back(size);
+        mea->inv1b_c2r(spec.data(), back.data(), nrows, ncols, axis);
+        REQUIRE(spec == spec0);
+        require_close(back, rin);
+    }
+    {
+        auto in = rin;
+        const int nhalf = nrows * (ncols / 2 + 1);
+        std::vector<complex_t> spec(nhalf);
+        mea->fwd2d_r2c(in.data(), spec.data(), nrows, ncols);
+        REQUIRE(in == rin);
+
+        const auto spec0 = spec;
+        std::vector<float> back(size);
+        mea->inv2d_c2r(spec.data(), back.data(), nrows, ncols);
+        REQUIRE(spec == spec0);
+        require_close(back, rin);
+    }
+}
+
+TEST_CASE("fftwdft wisdom round trip")
+{
+    Persist::TempDir td;
+    const std::string wisdom = (td.path / "fftw.wisdom").string();
+    const int size = 1000;
+
+    // The flags FftwDFT uses for an out-of-place measured 1d plan.
+    const unsigned flags = FFTW_MEASURE | FFTW_PRESERVE_INPUT | FFTW_WISDOM_ONLY;
+    auto in = (fftwf_complex*) fftwf_malloc(size * sizeof(fftwf_complex));
+    auto out = (fftwf_complex*) fftwf_malloc(size * sizeof(fftwf_complex));
+    auto have_wisdom = [&]() {
+        auto plan = fftwf_plan_dft_1d(size, in, out, FFTW_FORWARD, flags);
+        if (plan) {
+            fftwf_destroy_plan(plan);
+            return true;
+        }
+        return false;
+    };
+
+    fftwf_forget_wisdom();
+    REQUIRE(!have_wisdom());
+    {
+        auto dft = make_fftw("measure", wisdom);  // file absent, not an error
+        auto data = make_cdata(size);
+        std::vector<complex_t> spec(size);
+        dft->fwd1d(data.data(), spec.data(), size);
+        REQUIRE(have_wisdom());
+        dft->finalize();
+    }
+    REQUIRE(boost::filesystem::file_size(wisdom) > 0);
+
+    fftwf_forget_wisdom();
+    REQUIRE(!have_wisdom());
+    auto dft = make_fftw("measure", wisdom);
+    REQUIRE(have_wisdom());
+
+    fftwf_free(in);
+    fftwf_free(out);
+}
+
+TEST_CASE("fftwdft plan cache reuse")
+{
+    auto dft = make_fftw("estimate");
+    const int size = 777;   // a shape used nowhere else
+    auto data = make_cdata(size);
+    std::vector<complex_t> spec(size), other(size);
+
+    auto s0 = Aux::FftwDFT::plan_stats();
+    dft->fwd1d(data.data(), spec.data(), size);
+    auto s1 = Aux::FftwDFT::plan_stats();
+    CHECK(s1.plans - s0.plans == 1);
+    CHECK(s1.misses - s0.misses == 1);
+    CHECK(s1.hits - s0.hits == 0);
+
+    // Same shape on other arrays reuses the plan.
+    auto copy = data;
+    dft->fwd1d(copy.data(), other.data(), size);
+    auto s2 = Aux::FftwDFT::plan_stats();
+    CHECK(s2.plans - s1.plans == 0);
+    CHECK(s2.misses - s1.misses == 0);
+    CHECK(s2.hits - s1.hits == 1);
+    require_close(spec, other);
+
+    // In-place is a different key.
+    dft->fwd1d(copy.data(), copy.data(), size);
+    auto s3 = Aux::FftwDFT::plan_stats();
+    CHECK(s3.plans - s2.plans == 1);
+    require_close(copy, spec);
+
+    // As is a different rigor.
+    auto mea = make_fftw("measure");
+    mea->fwd1d(data.data(), other.data(), size);
+    auto s4 = Aux::FftwDFT::plan_stats();
+    CHECK(s4.plans - s3.plans == 1);
+
+    // Unaligned arrays reuse the plan via aligned copies.
+    std::vector<complex_t> shifted(size + 1);
+    std::copy(data.begin(), data.end(), shifted.begin() + 1);
+    dft->fwd1d(shifted.data() + 1, other.data(), size);
+    auto s5 = Aux::FftwDFT::plan_stats();
+    CHECK(s5.plans - s4.plans == 0);
+    CHECK(s5.hits - s4.hits == 1);
+    CHECK(s5.copies - s4.copies == 1);
+    require_close(spec, other);
+}
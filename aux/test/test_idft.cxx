@@ -7,6 +7,7 @@
 #include <vector>
 #include <thread>
 #include <numeric>
+#include <cmath>
 #include <iostream>
 
 using namespace WireCell;
@@ -202,6 +203,54 @@ void test_2d_transpose(IDFT::pointer dft, int nrows, int ncols)
 }
 
 
+// Compare r2c/c2r against the complex transforms of the same real
+// array.  The 1d case is nrows=1, axis=1 and axis=-1 means 2d.
+static
+void test_r2c(IDFT::pointer dft, int nrows, int ncols, int axis)
+{
+    std::cerr << "r2c axis="<<axis << " nrows="<<nrows<<" ncols="<<ncols<<"\n";
+    const int size = nrows*ncols;
+    std::vector<IDFT::scalar_t> wave(size), back(size, 0);
+    for (int ind=0; ind<size; ++ind) {
+        wave[ind] = std::sin(0.3*ind) + 0.01*ind;
+    }
+    std::vector<IDFT::complex_t> cwave(wave.begin(), wave.end()), spec(size, 0);
+
+    // half shape
+    int hrows = nrows, hcols = ncols/2 + 1;
+    if (axis == 0) {
+        hrows = nrows/2 + 1;
+        hcols = ncols;
+    }
+    std::vector<IDFT::complex_t> half(hrows*hcols, 0);
+
+    if (axis < 0) {
+        dft->fwd2d(cwave.data(), spec.data(), nrows, ncols);
+        dft->fwd2d_r2c(wave.data(), half.data(), nrows, ncols);
+        dft->inv2d_c2r(half.data(), back.data(), nrows, ncols);
+    }
+    else if (nrows == 1) {
+        dft->fwd1d(cwave.data(), spec.data(), ncols);
+        dft->fwd1d_r2c(wave.data(), half.data(), ncols);
+        dft->inv1d_c2r(half.data(), back.data(), ncols);
+    }
+    else {
+        dft->fwd1b(cwave.data(), spec.data(), nrows, ncols, axis);
+        dft->fwd1b_r2c(wave.data(), half.data(), nrows, ncols, axis);
+        dft->inv1b_c2r(half.data(), back.data(), nrows, ncols, axis);
+    }
+
+    for (int irow=0; irow<hrows; ++irow) {
+        for (int icol=0; icol<hcols; ++icol) {
+            auto diff = spec[irow*ncols + icol] - half[irow*hcols + icol];
+            assert_small(std::abs(diff), 1e-3);
+        }
+    }
+    for (int ind=0; ind<size; ++ind) {
+        assert_small(std::abs(wave[ind] - back[ind]), 1e-3);
+    }
+}
+
 int main(int argc, char* argv[])
 {
     DftArgs args;
@@ -219,6 +268,14 @@ int main(int argc, char* argv[])
     test_1b_impulse(idft, 0, 8, 2);
     test_1b_impulse(idft, 1, 8, 2);
 
+    for (int size : {7, 8}) {
+        test_r2c(idft, 1, size, 1);
+        test_r2c(idft, size, 6, 0);
+        test_r2c(idft, size, 6, 1);
+        test_r2c(idft, size, 6, -1);
+        test_r2c(idft, 6, size, -1);
+    }
+
     test_2d_transpose<IDFT::scalar_t>(idft, 2, 8);
     test_2d_transpose<IDFT::scalar_t>(idft, 8, 2);
     test_2d_transpose<IDFT::complex_t>(idft, 2, 8);
@@ -13,6 +13,7 @@
 
 
 #include <fstream>
+#include <functional>
 
 namespace WireCell::PointCloud::Facade {
     using namespace WireCell::PointCloud::Tree;
@@ -31,6 +32,39 @@ namespace WireCell::PointCloud::Facade {
 
     using cluster_vector_t = std::vector<Cluster*>;
 
+    // clustering_util.cxx
+    //
+    // A broad-phase for pairwise passes.  It holds the axis-aligned bounding
+    // box of each cluster's 3D points and finds, by sweep-and-prune, all pairs
+    // whose boxes are closer than "reach".  No two points of clusters with
+    // boxes further apart can be closer than reach, so a pass that only acts
+    // on pairs with Find_Closest_Points() or get_closest_points() distance
+    // below reach may visit the candidates alone and get identical results.
+    //
+    // Clusters for which "use" returns false are never candidates.  Empty
+    // clusters have no box and pair with every other cluster so that any
+    // complaint about them is raised as before.
+    class ClusterBroadPhase {
+       public:
+        using use_f = std::function<bool(const Cluster*)>;
+
+        ClusterBroadPhase(const cluster_vector_t& clusters, double reach, use_f use = nullptr);
+
+        // Return indices j>i, ascending, of candidate partners of the i'th
+        // cluster.  Visiting these in place of all j>i keeps pair order.
+        const std::vector<size_t>& later(size_t ind) const { return m_later.at(ind); }
+
+        // Total number of candidate pairs.
+        size_t npairs() const { return m_npairs; }
+
+        double reach() const { return m_reach; }
+
+       private:
+        double m_reach;
+        size_t m_npairs{0};
+        std::vector<std::vector<size_t>> m_later;
+    };
+
 
     // clustering_util.cxx
     //
@@ -17,6 +17,9 @@
 #include "WireCellClus/Facade_Util.h"
 #include "WireCellClus/Facade_Blob.h"
 
+#include <array>
+#include <memory>
+
 
 // using namespace WireCell;  NO!  do not open up namespaces in header files!
 
@@ -26,6 +29,39 @@ namespace WireCell::PointCloud::Facade {
 
     struct ClusterCache { };
 
+    // Point moments and extent of a cluster.  When disjoint clusters merge,
+    // counts, sums and extent combine exactly and the scatter combines to
+    // within round-off so a merged cluster may be seeded from its donors.
+    struct ClusterMoments {
+        size_t npoints{0};
+        // Sum of the points.
+        std::array<double, 3> sum{0, 0, 0};
+        // Sum of outer products of point offsets from their mean.
+        std::array<std::array<double, 3>, 3> scatter{};
+        // Axis-aligned bounding box of the points.  Valid if npoints>0.
+        geo_point_t lo, hi;
+
+        // Combine with the moments of a disjoint set of points.
+        void merge(const ClusterMoments& other);
+    };
+
+    // The u, v, w wire and t slice indices covered by a cluster's blobs as
+    // sorted, disjoint and non-adjacent [begin,end) intervals.
+    struct ClusterCoverage {
+        using intervals_t = std::vector<std::pair<int, int>>;
+        std::array<intervals_t, 4> uvwt;
+
+        // Add one [begin,end) interval to the given view.  Call normalize()
+        // after adding.
+        void add(size_t view, int begin, int end);
+        // Restore sorted, disjoint order.
+        void normalize();
+        // Combine with the coverage of another cluster.
+        void merge(const ClusterCoverage& other);
+        // The number of indices covered in each of u, v, w, t.
+        std::tuple<int, int, int, int> counts() const;
+    };
+
     // Give a node "Cluster" semantics.  A cluster node's children are blob nodes.
     class Cluster : public NaryTree::FacadeParent<Blob, points_t>, public Mixin<Cluster, ClusterCache> {
 
@@ -45,6 +81,11 @@ namespace WireCell::PointCloud::Facade {
         // Override Mixin
         virtual void clear_cache() const;
 
+        // Override FacadeParent to also drop the summaries of our blobs
+        // when a blob is added or removed.
+        virtual bool on_insert(const std::vector<node_type*>& path);
+        virtual bool on_remove(const std::vector<node_type*>& path);
+
         // Return the grouping to which this cluster is a child.  May be nullptr.
         Grouping* grouping();
         const Grouping* grouping() const;
@@ -248,6 +289,12 @@ namespace WireCell::PointCloud::Facade {
         // extents in each view and in time.
         double get_length() const;
 
+        // Return the moments and extent of the points of all blobs.  Lazy.
+        const ClusterMoments& moments() const;
+
+        // Return the wire and slice index coverage of all blobs.  Lazy.
+        const ClusterCoverage& coverage() const;
+
         // Return blob at the front of the time blob map.  Raises ValueError if cluster is empty.
         const Blob* get_first_blob() const;
 
@@ -311,6 +358,23 @@ namespace WireCell::PointCloud::Facade {
         using BlobSet = std::set<const Blob*, blob_less_functor>;
         using time_blob_map_t = std::map<int, BlobSet>;
         const time_blob_map_t& time_blob_map() const;
+
+        // The mergeable caches held by a cluster.  Any may be absent.
+        struct Summaries {
+            std::unique_ptr<ClusterMoments> moments;
+            std::unique_ptr<ClusterCoverage> coverage;
+            time_blob_map_t time_blob_map;
+            int npoints{0};
+        };
+
+        // Move out the mergeable caches this cluster holds.  Call on a
+        // donor before its children are taken as that drops them.
+        Summaries take_summaries();
+
+        // Seed the caches of this cluster after it has taken all children
+        // of the donors whose summaries are given.  A cache is seeded only
+        // if every donor held it, else it stays lazy.
+        void seed_merged_caches(const std::vector<Summaries>& donors) const;
    
         // PCA helper functions
         void Calc_PCA(std::vector<geo_point_t>& points) const;
@@ -388,6 +452,12 @@ namespace WireCell::PointCloud::Facade {
         // Cached and lazily calculated in npoints()
         mutable int m_npoints{0};
 
+        // Lazy, do not access directly.  See moments() and coverage().
+        mutable std::unique_ptr<ClusterMoments> m_moments;
+        mutable std::unique_ptr<ClusterCoverage> m_coverage;
+        // Reset these and the length and PCA derived from them.
+        void drop_blob_summaries() const;
+
         void Calc_PCA() const;
         
 
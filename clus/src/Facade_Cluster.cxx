@@ -81,6 +81,10 @@ void Cluster::clear_cache() const {
     // Reset length and point count
     m_length = 0;
     m_npoints = 0;
+
+    // Reset mergeable summaries
+    m_moments.reset();
+    m_coverage.reset();
     
     // Reset PCA data
     m_pca_calculated = false;
@@ -99,6 +103,28 @@ void Cluster::clear_cache() const {
     m_path_mcells.clear();
 }
 
+// Blobs come and go by insert and removal notices which take_children(),
+// separate() and merging all emit.  Seeding after a merge must follow these.
+void Cluster::drop_blob_summaries() const
+{
+    m_moments.reset();
+    m_coverage.reset();
+    m_length = 0;
+    m_pca_calculated = false;
+}
+
+bool Cluster::on_insert(const std::vector<node_type*>& path)
+{
+    drop_blob_summaries();
+    return this->FacadeParent<Blob, points_t>::on_insert(path);
+}
+
+bool Cluster::on_remove(const std::vector<node_type*>& path)
+{
+    drop_blob_summaries();
+    return this->FacadeParent<Blob, points_t>::on_remove(path);
+}
+
 void Cluster::print_blobs_info() const{
     for (const Blob* blob : children()) {
         std::cout << "U: " << blob->u_wire_index_min() << " " << blob->u_wire_index_max() 
@@ -1288,25 +1314,7 @@ std::tuple<int, int, int, int> Cluster::get_uvwt_max() const
 // be "smaller" than a small but dense cluster.
 std::tuple<int, int, int, int> Cluster::get_uvwt_range() const
 {
-    std::set<int> u_set;
-    std::set<int> v_set;
-    std::set<int> w_set;
-    std::set<int> t_set;
-    for (const auto* blob : children()) {
-        for (int i = blob->u_wire_index_min(); i < blob->u_wire_index_max(); ++i) {
-            u_set.insert(i);
-        }
-        for (int i = blob->v_wire_index_min(); i < blob->v_wire_index_max(); ++i) {
-            v_set.insert(i);
-        }
-        for (int i = blob->w_wire_index_min(); i < blob->w_wire_index_max(); ++i) {
-            w_set.insert(i);
-        }
-        for (int i = blob->slice_index_min(); i < blob->slice_index_max(); ++i) {
-            t_set.insert(i);
-        }
-    }
-    return {u_set.size(), v_set.size(), w_set.size(), t_set.size()};
+    return coverage().counts();
 }
 
 double Cluster::get_length() const
@@ -1361,6 +1369,188 @@ double Facade::get_length(const Cluster* cluster, const std::vector<int>& b2id,
 }
 
 
+void ClusterMoments::merge(const ClusterMoments& other)
+{
+    if (!other.npoints) {
+        return;
+    }
+    if (!npoints) {
+        *this = other;
+        return;
+    }
+    // Pairwise update of Chan, Golub and LeVeque.
+    const double na = npoints, nb = other.npoints;
+    const double fac = na * nb / (na + nb);
+    std::array<double, 3> delta;
+    for (int i = 0; i != 3; i++) {
+        delta[i] = other.sum[i] / nb - sum[i] / na;
+    }
+    for (int i = 0; i != 3; i++) {
+        for (int j = 0; j != 3; j++) {
+            scatter[i][j] += other.scatter[i][j] + fac * delta[i] * delta[j];
+        }
+        sum[i] += other.sum[i];
+        lo[i] = std::min(lo[i], other.lo[i]);
+        hi[i] = std::max(hi[i], other.hi[i]);
+    }
+    npoints += other.npoints;
+}
+
+void ClusterCoverage::add(size_t view, int begin, int end)
+{
+    if (begin < end) {
+        uvwt[view].emplace_back(begin, end);
+    }
+}
+
+void ClusterCoverage::normalize()
+{
+    for (auto& ivs : uvwt) {
+        std::sort(ivs.begin(), ivs.end());
+        intervals_t out;
+        for (const auto& iv : ivs) {
+            if (!out.empty() && iv.first <= out.back().second) {
+                out.back().second = std::max(out.back().second, iv.second);
+                continue;
+            }
+            out.push_back(iv);
+        }
+        ivs.swap(out);
+    }
+}
+
+void ClusterCoverage::merge(const ClusterCoverage& other)
+{
+    for (size_t view = 0; view != 4; ++view) {
+        uvwt[view].insert(uvwt[view].end(), other.uvwt[view].begin(), other.uvwt[view].end());
+    }
+    normalize();
+}
+
+std::tuple<int, int, int, int> ClusterCoverage::counts() const
+{
+    std::array<int, 4> num{0, 0, 0, 0};
+    for (size_t view = 0; view != 4; ++view) {
+        for (const auto& iv : uvwt[view]) {
+            num[view] += iv.second - iv.first;
+        }
+    }
+    return {num[0], num[1], num[2], num[3]};
+}
+
+const ClusterMoments& Cluster::moments() const
+{
+    if (m_moments) {
+        return *m_moments;
+    }
+    m_moments = std::make_unique<ClusterMoments>();
+    auto& mom = *m_moments;
+
+    std::vector<geo_point_t> points;
+    for (const Blob* blob : children()) {
+        const auto bpoints = blob->points();
+        points.insert(points.end(), bpoints.begin(), bpoints.end());
+    }
+    mom.npoints = points.size();
+    if (points.empty()) {
+        return mom;
+    }
+
+    // Two passes, in blob order, so the PCA matches a direct calculation.
+    geo_point_t total(0, 0, 0);
+    mom.lo = mom.hi = points.front();
+    for (const auto& p : points) {
+        total += p;
+        for (int i = 0; i != 3; i++) {
+            mom.lo[i] = std::min(mom.lo[i], p[i]);
+            mom.hi[i] = std::max(mom.hi[i], p[i]);
+        }
+    }
+    const geo_point_t center = total / mom.npoints;
+    for (const auto& p : points) {
+        for (int i = 0; i != 3; i++) {
+            for (int j = i; j != 3; j++) {
+                mom.scatter[i][j] += (p[i] - center[i]) * (p[j] - center[j]);
+            }
+        }
+    }
+    for (int i = 0; i != 3; i++) {
+        mom.sum[i] = total[i];
+        for (int j = 0; j != i; j++) {
+            mom.scatter[i][j] = mom.scatter[j][i];
+        }
+    }
+    return mom;
+}
+
+const ClusterCoverage& Cluster::coverage() const
+{
+    if (m_coverage) {
+        return *m_coverage;
+    }
+    m_coverage = std::make_unique<ClusterCoverage>();
+    for (const auto* blob : children()) {
+        m_coverage->add(0, blob->u_wire_index_min(), blob->u_wire_index_max());
+        m_coverage->add(1, blob->v_wire_index_min(), blob->v_wire_index_max());
+        m_coverage->add(2, blob->w_wire_index_min(), blob->w_wire_index_max());
+        m_coverage->add(3, blob->slice_index_min(), blob->slice_index_max());
+    }
+    m_coverage->normalize();
+    return *m_coverage;
+}
+
+Cluster::Summaries Cluster::take_summaries()
+{
+    Summaries ret;
+    ret.moments = std::move(m_moments);
+    ret.coverage = std::move(m_coverage);
+    ret.time_blob_map.swap(m_time_blob_map);
+    ret.npoints = m_npoints;
+    return ret;
+}
+
+void Cluster::seed_merged_caches(const std::vector<Summaries>& donors) const
+{
+    if (donors.empty()) {
+        return;
+    }
+    bool have_moments = true, have_coverage = true, have_tbm = true, have_npoints = true;
+    for (const auto& donor : donors) {
+        have_moments = have_moments && donor.moments;
+        have_coverage = have_coverage && donor.coverage;
+        have_tbm = have_tbm && !donor.time_blob_map.empty();
+        have_npoints = have_npoints && donor.npoints;
+    }
+    if (have_moments) {
+        m_moments = std::make_unique<ClusterMoments>();
+        for (const auto& donor : donors) {
+            m_moments->merge(*donor.moments);
+        }
+        m_pca_calculated = false;
+    }
+    if (have_coverage) {
+        m_coverage = std::make_unique<ClusterCoverage>();
+        for (const auto& donor : donors) {
+            m_coverage->merge(*donor.coverage);
+        }
+        m_length = 0;
+    }
+    if (have_tbm) {
+        m_time_blob_map.clear();
+        for (const auto& donor : donors) {
+            for (const auto& [time, blobs] : donor.time_blob_map) {
+                m_time_blob_map[time].insert(blobs.begin(), blobs.end());
+            }
+        }
+    }
+    if (have_npoints) {
+        m_npoints = 0;
+        for (const auto& donor : donors) {
+            m_npoints += donor.npoints;
+        }
+    }
+}
+
 std::pair<geo_point_t, geo_point_t> Cluster::get_highest_lowest_points(size_t axis) const
 {
     const auto& points = this->points();
@@ -3506,14 +3696,9 @@ void Cluster::Calc_PCA() const
 {
     if (m_pca_calculated) return;
 
-    m_center.set(0, 0, 0);
-    int nsum = 0;
-    for (const Blob* blob : children()) {
-        for (const geo_point_t& p : blob->points()) {
-            m_center += p;
-            nsum++;
-        }
-    }
+    const auto& mom = moments();
+    m_center.set(mom.sum[0], mom.sum[1], mom.sum[2]);
+    const int nsum = mom.npoints;
 
     for (int i = 0; i != 3; i++) {
         m_pca_axis[i].set(0, 0, 0);
@@ -3529,12 +3714,7 @@ void Cluster::Calc_PCA() const
 
     for (int i = 0; i != 3; i++) {
         for (int j = i; j != 3; j++) {
-            cov_matrix(i, j) = 0;
-            for (const Blob* blob : children()) {
-                for (const geo_point_t& p : blob->points()) {
-                    cov_matrix(i, j) += (p[i] - m_center[i]) * (p[j] - m_center[j]);
-                }
-            }
+            cov_matrix(i, j) = mom.scatter[i][j];
         }
     }
     cov_matrix(1, 0) = cov_matrix(0, 1);
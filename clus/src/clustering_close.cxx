@@ -34,11 +34,18 @@ void WireCell::PointCloud::Facade::clustering_close(
     ilive2desc[ilive] = boost::add_vertex(ilive, g);
   }
 
+  // Clustering_3rd_round() accepts pairs closer than length_cut or, when
+  // either cluster is at least 12 cm long, 2 cm.
+  ClusterBroadPhase broad(live_clusters, std::max(length_cut, 2.0*units::cm),
+                          [](const Cluster* cluster) {
+                            return cluster->get_length() >= 1.5*units::cm;
+                          });
+
   for (size_t i=0;i!=live_clusters.size();i++){
     auto cluster_1 = live_clusters.at(i);
     if (cluster_1->get_length() < 1.5*units::cm) continue;
     if (used_clusters.find(cluster_1)!=used_clusters.end()) continue;
-    for (size_t j=i+1;j<live_clusters.size();j++){
+    for (size_t j : broad.later(i)){
       auto cluster_2 = live_clusters.at(j);
       if (used_clusters.find(cluster_2)!=used_clusters.end()) continue;
       if (cluster_2->get_length() < 1.5*units::cm) continue;
@@ -148,10 +148,11 @@ void WireCell::PointCloud::Facade::clustering_isolated(Grouping& live_grouping)
 
     // small distance ...
     double small_small_dis_cut = 5 * units::cm;
+    ClusterBroadPhase small_broad(small_clusters, small_small_dis_cut);
     for (size_t i = 0; i != small_clusters.size(); i++) {
         Cluster *cluster1 = small_clusters.at(i);
         // ToyPointCloud *cloud1 = cluster1->get_point_cloud();
-        for (size_t j = i + 1; j != small_clusters.size(); j++) {
+        for (size_t j : small_broad.later(i)) {
             Cluster *cluster2 = small_clusters.at(j);
             // ToyPointCloud *cloud2 = cluster2->get_point_cloud();
             // std::tuple<int, int, double> results = cloud2->get_closest_points(cloud1);
@@ -180,10 +181,11 @@ void WireCell::PointCloud::Facade::clustering_isolated(Grouping& live_grouping)
 
     // clustering small with small ones ...
     small_small_dis_cut = 50 * units::cm;
+    ClusterBroadPhase remaining_broad(remaining_small_clusters, small_small_dis_cut);
     for (size_t i = 0; i != remaining_small_clusters.size(); i++) {
         Cluster *cluster1 = remaining_small_clusters.at(i);
         // ToyPointCloud *cloud1 = cluster1->get_point_cloud();
-        for (size_t j = i + 1; j != remaining_small_clusters.size(); j++) {
+        for (size_t j : remaining_broad.later(i)) {
             Cluster *cluster2 = remaining_small_clusters.at(j);
             // ToyPointCloud *cloud2 = cluster2->get_point_cloud();
             // std::tuple<int, int, double> results = cloud2->get_closest_points(cloud1);
@@ -32,9 +32,13 @@ void WireCell::PointCloud::Facade::clustering_parallel_prolong(
   // original algorithm ... (establish edges ... )
 
 
+  // Clustering_2nd_round() accepts pairs closer than length_cut or, for
+  // long clusters, closer than 80 cm.
+  ClusterBroadPhase broad(live_clusters, std::max(length_cut, 80*units::cm));
+
   for (size_t i=0;i!=live_clusters.size();i++){
     auto cluster_1 = live_clusters.at(i);
-    for (size_t j=i+1;j<live_clusters.size();j++){
+    for (size_t j : broad.later(i)){
       auto cluster_2 = live_clusters.at(j);
       if (Clustering_2nd_round(*cluster_1,*cluster_2, cluster_1->get_length(), cluster_2->get_length(), length_cut)){
 
@@ -38,10 +38,15 @@ void WireCell::PointCloud::Facade::clustering_regular(
   // original algorithm ... (establish edges ... )
 
 
+  // Clustering_1st_round() only accepts pairs closer than length_cut.
+  ClusterBroadPhase broad(live_clusters, length_cut, [&](const Cluster* cluster) {
+    return cluster->get_length() >= internal_length_cut;
+  });
+
   for (size_t i=0;i!=live_clusters.size();i++){
     auto cluster_1 = live_clusters.at(i);
     if (cluster_1->get_length() < internal_length_cut) continue;
-    for (size_t j=i+1;j<live_clusters.size();j++){
+    for (size_t j : broad.later(i)){
       auto cluster_2 = live_clusters.at(j);
       if (cluster_2->get_length() < internal_length_cut) continue;
 
@@ -1,10 +1,107 @@
 #include <WireCellClus/ClusteringFuncs.h>
 
+#include <algorithm>
+#include <array>
 #include <iostream>              // temp debug
 
 using namespace WireCell::PointCloud::Facade;
 
 
+WireCell::PointCloud::Facade::ClusterBroadPhase::ClusterBroadPhase(
+    const cluster_vector_t& clusters, double reach, use_f use)
+    : m_reach(reach)
+    , m_later(clusters.size())
+{
+    // Allow for round-off between box and point distances.
+    const double reach_s = reach + 1e-9 * (std::abs(reach) + 1.0);
+
+    struct Box {
+        std::array<double, 3> lo, hi;
+    };
+    std::vector<Box> boxes(clusters.size());
+    std::vector<size_t> bounded, unbounded;
+    for (size_t ind = 0; ind < clusters.size(); ++ind) {
+        const Cluster* cluster = clusters[ind];
+        if (use && !use(cluster)) {
+            continue;
+        }
+        // The extent is held by the merge-friendly moments which, unlike
+        // points(), do not require building the k-d tree.
+        const auto& mom = cluster->moments();
+        if (mom.npoints == 0) {
+            unbounded.push_back(ind);
+            continue;
+        }
+        auto& box = boxes[ind];
+        for (size_t axis = 0; axis < 3; ++axis) {
+            box.lo[axis] = mom.lo[axis];
+            box.hi[axis] = mom.hi[axis];
+        }
+        bounded.push_back(ind);
+    }
+
+    auto add_pair = [&](size_t a, size_t b) {
+        if (a > b) std::swap(a, b);
+        m_later[a].push_back(b);
+        ++m_npairs;
+    };
+
+    // Sweep along the axis over which the boxes are most spread.
+    size_t sweep = 0;
+    if (bounded.size() > 1) {
+        double best = -1;
+        for (size_t axis = 0; axis < 3; ++axis) {
+            double lo = boxes[bounded[0]].lo[axis], hi = lo;
+            for (size_t ind : bounded) {
+                lo = std::min(lo, boxes[ind].lo[axis]);
+                hi = std::max(hi, boxes[ind].lo[axis]);
+            }
+            if (hi - lo > best) {
+                best = hi - lo;
+                sweep = axis;
+            }
+        }
+    }
+    std::sort(bounded.begin(), bounded.end(), [&](size_t a, size_t b) {
+        return boxes[a].lo[sweep] < boxes[b].lo[sweep];
+    });
+
+    const double reach2 = reach_s * reach_s;
+    for (size_t ia = 0; ia < bounded.size(); ++ia) {
+        const auto& abox = boxes[bounded[ia]];
+        const double stop = abox.hi[sweep] + reach_s;
+        for (size_t ib = ia + 1; ib < bounded.size(); ++ib) {
+            const auto& bbox = boxes[bounded[ib]];
+            if (bbox.lo[sweep] > stop) {
+                break;
+            }
+            double gap2 = 0;
+            for (size_t axis = 0; axis < 3; ++axis) {
+                const double gap = std::max({0.0, bbox.lo[axis] - abox.hi[axis], abox.lo[axis] - bbox.hi[axis]});
+                gap2 += gap * gap;
+            }
+            if (gap2 < reach2) {
+                add_pair(bounded[ia], bounded[ib]);
+            }
+        }
+    }
+
+    // Empty clusters can not be located, keep them paired with all.
+    for (size_t iu = 0; iu < unbounded.size(); ++iu) {
+        for (size_t ind : bounded) {
+            add_pair(unbounded[iu], ind);
+        }
+        for (size_t ju = iu + 1; ju < unbounded.size(); ++ju) {
+            add_pair(unbounded[iu], unbounded[ju]);
+        }
+    }
+
+    for (auto& later : m_later) {
+        std::sort(later.begin(), later.end());
+    }
+}
+
+
 void WireCell::PointCloud::Facade::merge_clusters(
     cluster_connectivity_graph_t& g,
     Grouping& grouping,
@@ -42,6 +139,9 @@ void WireCell::PointCloud::Facade::merge_clusters(
 
         std::vector<int> cc;
         int parent_id = 0;
+        // The fresh cluster is seeded from the cached summaries of the
+        // donors.  Taking children drops these so grab them first.
+        std::vector<Cluster::Summaries> summaries;
         for (const auto& desc : descs) {
             const int idx = g[desc];
             if (idx < 0) {  // no need anymore ...
@@ -49,6 +149,7 @@ void WireCell::PointCloud::Facade::merge_clusters(
             }
 
             auto live = orig_clusters[idx];
+            summaries.push_back(live->take_summaries());
             fresh_cluster.take_children(*live, true);
 
             if (savecc) {
@@ -63,6 +164,7 @@ void WireCell::PointCloud::Facade::merge_clusters(
         if (savecc) {
             fresh_cluster.put_pcarray(cc, aname, pcname);
         }
+        fresh_cluster.seed_merged_caches(summaries);
         known_clusters.insert(&fresh_cluster);
     }
 
@@ -0,0 +1,209 @@
+#include "WireCellClus/Facade_Cluster.h"
+#include "WireCellClus/Facade_Grouping.h"
+#include "WireCellClus/ClusteringFuncs.h"
+#include "WireCellUtil/doctest.h"
+
+#include <random>
+#include <vector>
+
+using namespace WireCell::PointCloud;
+using namespace WireCell::PointCloud::Facade;
+using fa_float_t = WireCell::PointCloud::Facade::float_t;
+using fa_int_t = WireCell::PointCloud::Facade::int_t;
+
+static ClusterMoments direct(const std::vector<geo_point_t>& pts)
+{
+    ClusterMoments m;
+    m.npoints = pts.size();
+    geo_point_t tot(0, 0, 0);
+    m.lo = m.hi = pts.front();
+    for (const auto& p : pts) {
+        tot += p;
+        for (int i = 0; i < 3; ++i) {
+            m.lo[i] = std::min(m.lo[i], p[i]);
+            m.hi[i] = std::max(m.hi[i], p[i]);
+        }
+    }
+    const geo_point_t c = tot / m.npoints;
+    for (const auto& p : pts) {
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                m.scatter[i][j] += (p[i] - c[i]) * (p[j] - c[j]);
+            }
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        m.sum[i] = tot[i];
+    }
+    return m;
+}
+
+TEST_CASE("clus cluster moments merge")
+{
+    std::mt19937 rng(1);
+    std::normal_distribution<double> g(0, 10);
+    std::vector<geo_point_t> a, b;
+    for (int k = 0; k < 100; ++k) a.emplace_back(g(rng), g(rng) + 50, g(rng));
+    for (int k = 0; k < 37; ++k) b.emplace_back(g(rng) + 30, g(rng), g(rng) - 20);
+    auto ma = direct(a);
+    ma.merge(direct(b));
+    std::vector<geo_point_t> ab = a;
+    ab.insert(ab.end(), b.begin(), b.end());
+    auto want = direct(ab);
+    CHECK(ma.npoints == want.npoints);
+    for (int i = 0; i < 3; ++i) {
+        CHECK(ma.sum[i] == doctest::Approx(want.sum[i]));
+        CHECK(ma.lo[i] == want.lo[i]);
+        CHECK(ma.hi[i] == want.hi[i]);
+        for (int j = 0; j < 3; ++j) {
+            CHECK(ma.scatter[i][j] == doctest::Approx(want.scatter[i][j]));
+        }
+    }
+    ClusterMoments empty;
+    empty.merge(want);
+    CHECK(empty.npoints == want.npoints);
+}
+
+TEST_CASE("clus cluster coverage merge")
+{
+    ClusterCoverage a, b;
+    a.add(0, 0, 5);
+    a.add(0, 3, 8);
+    a.add(3, 10, 10);  // empty
+    a.normalize();
+    CHECK(a.uvwt[0].size() == 1);
+    CHECK(std::get<0>(a.counts()) == 8);
+    CHECK(std::get<3>(a.counts()) == 0);
+    b.add(0, 8, 10);
+    b.add(0, 20, 22);
+    b.add(3, 1, 4);
+    b.normalize();
+    a.merge(b);
+    CHECK(a.uvwt[0].size() == 2);
+    CHECK(std::get<0>(a.counts()) == 12);
+    CHECK(std::get<3>(a.counts()) == 3);
+}
+
+// A blob node with points along x from x0 to x0+1 on wires [w0,w0+n).
+static node_ptr make_blob(double x0, int w0, int n)
+{
+    std::vector<double> x, y, z;
+    for (int ind = 0; ind < 10; ++ind) {
+        x.push_back(x0 + 0.1 * ind);
+        y.push_back(w0);
+        z.push_back(0);
+    }
+    return std::make_unique<node_t>(Tree::Points({
+        {"scalar", Dataset({
+            {"charge", Array({(fa_float_t) 1.0})},
+            {"center_x", Array({(fa_float_t) x0 + 0.5})},
+            {"center_y", Array({(fa_float_t) w0})},
+            {"center_z", Array({(fa_float_t) 0})},
+            {"face", Array({(fa_int_t) 0})},
+            {"npoints", Array({(fa_int_t) 10})},
+            {"slice_index_min", Array({(fa_int_t) x0})},
+            {"slice_index_max", Array({(fa_int_t) x0 + 1})},
+            {"u_wire_index_min", Array({(fa_int_t) w0})},
+            {"u_wire_index_max", Array({(fa_int_t) w0 + n})},
+            {"v_wire_index_min", Array({(fa_int_t) w0})},
+            {"v_wire_index_max", Array({(fa_int_t) w0 + n})},
+            {"w_wire_index_min", Array({(fa_int_t) w0})},
+            {"w_wire_index_max", Array({(fa_int_t) w0 + n})},
+            {"max_wire_interval", Array({(fa_int_t) 1})},
+            {"min_wire_interval", Array({(fa_int_t) 1})},
+            {"max_wire_type", Array({(fa_int_t) 0})},
+            {"min_wire_type", Array({(fa_int_t) 0})},
+        })},
+        {"corner", Dataset({
+            {"x", Array(std::vector<double>{x0})},
+            {"y", Array(std::vector<double>{(double) w0})},
+            {"z", Array(std::vector<double>{0.0})},
+        })},
+        {"3d", Dataset({{"x", Array(x)}, {"y", Array(y)}, {"z", Array(z)}})},
+    }));
+}
+
+TEST_CASE("clus cluster summaries follow children")
+{
+    node_t root;
+    Grouping* grouping = root.value.facade<Grouping>();
+    REQUIRE(grouping);
+    Cluster& c1 = grouping->make_child();
+    Cluster& c2 = grouping->make_child();
+    c1.node()->insert(make_blob(0, 0, 4));
+    c2.node()->insert(make_blob(10, 20, 3));
+
+    // Fill the caches before the merge.
+    CHECK(c1.moments().npoints == 10);
+    CHECK(c1.moments().hi[0] == doctest::Approx(0.9));
+    CHECK(c1.get_uvwt_range() == std::make_tuple(4, 4, 4, 1));
+    CHECK(c2.get_uvwt_range() == std::make_tuple(3, 3, 3, 1));
+
+    c1.take_children(c2);
+    CHECK(c1.nchildren() == 2);
+    CHECK(c2.nchildren() == 0);
+
+    const auto& mom = c1.moments();
+    CHECK(mom.npoints == 20);
+    CHECK(mom.lo[0] == doctest::Approx(0));
+    CHECK(mom.hi[0] == doctest::Approx(10.9));
+    CHECK(mom.hi[1] == doctest::Approx(20));
+    CHECK(c1.get_uvwt_range() == std::make_tuple(7, 7, 7, 2));
+    CHECK(c2.moments().npoints == 0);
+    CHECK(c2.get_uvwt_range() == std::make_tuple(0, 0, 0, 0));
+
+    // And back out again.
+    Blob* blob = c1.children()[1];
+    auto orphan = c1.remove_child(*blob);
+    REQUIRE(orphan);
+    CHECK(c1.moments().npoints == 10);
+    CHECK(c1.moments().hi[0] == doctest::Approx(0.9));
+    CHECK(c1.get_uvwt_range() == std::make_tuple(4, 4, 4, 1));
+}
+
+TEST_CASE("clus merge clusters seeds summaries")
+{
+    node_t root;
+    Grouping* grouping = root.value.facade<Grouping>();
+    REQUIRE(grouping);
+    Cluster& c1 = grouping->make_child();
+    Cluster& c2 = grouping->make_child();
+    c1.node()->insert(make_blob(0, 0, 4));
+    c1.node()->insert(make_blob(3, 2, 5));
+    c2.node()->insert(make_blob(10, 20, 3));
+
+    // Fill the donor caches.
+    CHECK(c1.moments().npoints == 20);
+    CHECK(c2.moments().npoints == 10);
+    c1.coverage();
+    c2.coverage();
+
+    cluster_connectivity_graph_t g;
+    const auto d1 = boost::add_vertex(0, g);
+    const auto d2 = boost::add_vertex(1, g);
+    boost::add_edge(d1, d2, g);
+    cluster_set_t known{&c1, &c2};
+    merge_clusters(g, *grouping, known);
+
+    REQUIRE(grouping->nchildren() == 1);
+    Cluster* merged = grouping->children()[0];
+    REQUIRE(merged->nchildren() == 3);
+    CHECK(known.size() == 1);
+
+    // The seeded caches are taken out so that a fresh calculation follows.
+    auto seeded = merged->take_summaries();
+    REQUIRE(seeded.moments);
+    REQUIRE(seeded.coverage);
+    const auto& want = merged->moments();
+    CHECK(seeded.moments->npoints == want.npoints);
+    for (int i = 0; i < 3; ++i) {
+        CHECK(seeded.moments->sum[i] == doctest::Approx(want.sum[i]));
+        CHECK(seeded.moments->lo[i] == want.lo[i]);
+        CHECK(seeded.moments->hi[i] == want.hi[i]);
+        for (int j = 0; j < 3; ++j) {
+            CHECK(seeded.moments->scatter[i][j] == doctest::Approx(want.scatter[i][j]));
+        }
+    }
+    CHECK(seeded.coverage->counts() == merged->coverage().counts());
+    CHECK(seeded.coverage->uvwt == merged->coverage().uvwt);
+}
@@ -0,0 +1,79 @@
+#include "WireCellClus/ClusteringFuncs.h"
+#include "WireCellUtil/doctest.h"
+
+using namespace WireCell;
+using namespace WireCell::PointCloud;
+using namespace WireCell::PointCloud::Facade;
+using fa_float_t = WireCell::PointCloud::Facade::float_t;
+using fa_int_t = WireCell::PointCloud::Facade::int_t;
+
+// A blob node with points along z from z0 to z0+1cm on wires [w0,w0+n).
+static node_ptr make_zblob(double z0, int w0, int n)
+{
+    std::vector<double> x, y, z;
+    for (int ind = 0; ind < 10; ++ind) {
+        x.push_back(0);
+        y.push_back(0);
+        z.push_back(z0 + 0.1 * ind * units::cm);
+    }
+    return std::make_unique<node_t>(Tree::Points({
+        {"scalar", Dataset({
+            {"charge", Array({(fa_float_t) 1.0})},
+            {"center_x", Array({(fa_float_t) 0})},
+            {"center_y", Array({(fa_float_t) 0})},
+            {"center_z", Array({(fa_float_t) (z0 + 0.5 * units::cm)})},
+            {"face", Array({(fa_int_t) 0})},
+            {"npoints", Array({(fa_int_t) 10})},
+            {"slice_index_min", Array({(fa_int_t) 0})},
+            {"slice_index_max", Array({(fa_int_t) 1})},
+            {"u_wire_index_min", Array({(fa_int_t) w0})},
+            {"u_wire_index_max", Array({(fa_int_t) w0 + n})},
+            {"v_wire_index_min", Array({(fa_int_t) w0})},
+            {"v_wire_index_max", Array({(fa_int_t) w0 + n})},
+            {"w_wire_index_min", Array({(fa_int_t) w0})},
+            {"w_wire_index_max", Array({(fa_int_t) w0 + n})},
+            {"max_wire_interval", Array({(fa_int_t) 1})},
+            {"min_wire_interval", Array({(fa_int_t) 1})},
+            {"max_wire_type", Array({(fa_int_t) 0})},
+            {"min_wire_type", Array({(fa_int_t) 0})},
+        })},
+        {"corner", Dataset({
+            {"x", Array(std::vector<double>{0.0})},
+            {"y", Array(std::vector<double>{0.0})},
+            {"z", Array(std::vector<double>{z0})},
+        })},
+        {"3d", Dataset({{"x", Array(x)}, {"y", Array(y)}, {"z", Array(z)}})},
+    }));
+}
+
+// Add a straight track cluster of nblobs 1 cm blobs starting at z0.
+static Cluster& make_track(Grouping& grouping, double z0, int nblobs)
+{
+    Cluster& cluster = grouping.make_child();
+    const int w0 = z0 / (3 * units::mm);
+    for (int ind = 0; ind < nblobs; ++ind) {
+        cluster.node()->insert(make_zblob(z0 + ind * units::cm, w0 + 3 * ind, 3));
+    }
+    return cluster;
+}
+
+TEST_CASE("clus clustering close reaches 2 cm for long clusters")
+{
+    // The sbnd and dune-vd configurations use a 1.2 cm length_cut.  A long
+    // cluster must still merge across a 1.5 cm gap.
+    const double length_cut = 1.2 * units::cm;
+    const double gap = 1.5 * units::cm;
+
+    node_t root;
+    Grouping* grouping = root.value.facade<Grouping>();
+    REQUIRE(grouping);
+    Cluster& c1 = make_track(*grouping, 0, 30);
+    Cluster& c2 = make_track(*grouping, 30 * units::cm - 0.1 * units::cm + gap, 30);
+    REQUIRE(c1.get_length() >= 12 * units::cm);
+    REQUIRE(c2.get_length() >= 12 * units::cm);
+
+    cluster_set_t dead;
+    clustering_close(*grouping, dead, length_cut);
+    CHECK(grouping->nchildren() == 1);
+    CHECK(grouping->children()[0]->nchildren() == 60);
+}
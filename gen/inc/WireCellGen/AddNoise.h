@@ -13,6 +13,12 @@
 #include "WireCellIface/IChannelSpectrum.h"
 #include "WireCellIface/IGroupSpectrum.h"
 
+#include "WireCellAux/NoiseTools.h"
+
+#include <map>
+#include <string>
+#include <unordered_map>
+
 namespace WireCell::Gen {
 
 
@@ -27,6 +33,29 @@ namespace WireCell::Gen {
 
         /// IFrameFilter
         virtual bool operator()(const input_pointer& inframe, output_pointer& outframe);
+
+        /// IConfigurable
+        virtual void configure(const WireCell::Configuration& config);
+        virtual WireCell::Configuration default_configuration() const;
+
+      private:
+
+        // If nonzero, inverse DFTs are done on blocks of this many
+        // noise spectra.
+        size_t m_nbatch{0};
+        // Threads over which blocks are spread in batch mode.
+        size_t m_nthreads{1};
+
+        // Noise sigmas by the spectrum they derive from, for batch
+        // mode.  Models share one spectrum among many channels so
+        // this holds one entry per distinct spectrum.
+        std::unordered_map<const IChannelSpectrum::amplitude_t*, Aux::NoiseTools::real_vector_t> m_sigmas;
+        const Aux::NoiseTools::real_vector_t& sigmas(const IChannelSpectrum::amplitude_t& spec);
+
+        void add_each(const ITrace::vector& intraces, ITrace::vector& outtraces,
+                      Aux::NoiseTools::GeneratorN& rwgen);
+        void add_batched(const ITrace::vector& intraces, ITrace::vector& outtraces,
+                         Aux::NoiseTools::GeneratorN& rwgen);
     };
 
     class CoherentAddNoise : public NoiseBaseT<IGroupSpectrum>,
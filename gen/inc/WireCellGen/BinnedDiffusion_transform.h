@@ -9,6 +9,7 @@
 #include "WireCellGen/ImpactData.h"
 
 #include <deque>
+#include <vector>
 #include "WireCellUtil/Eigen.h"
 
 namespace WireCell {
@@ -113,9 +114,11 @@ namespace WireCell {
             std::pair<int, int> m_window;
             // the content of the current window
             std::map<int, ImpactData::mutable_pointer> m_impacts;
-            // std::vector<std::shared_ptr<GaussianDiffusion> > m_diffs;
+            // In the order added.  A fluctuating sampling draws from
+            // the random stream in this order so it must not depend
+            // on where the diffusions land in memory.
             // std::set<std::shared_ptr<GaussianDiffusion>, GausDiffTimeCompare> m_diffs;
-            std::set<std::shared_ptr<GaussianDiffusion> > m_diffs;
+            std::vector<std::shared_ptr<GaussianDiffusion> > m_diffs;
 
             int m_outside_pitch;
             int m_outside_time;
@@ -16,13 +16,14 @@
 #include "WireCellIface/IAnodeFace.h"
 #include "WireCellIface/IAnodePlane.h"
 #include "WireCellIface/IRandom.h"
-#include "WireCellUtil/Logging.h"
+#include "WireCellAux/Logger.h"
 
+#include <unordered_map>
 #include <vector>
 
 namespace WireCell {
     namespace Gen {
-        class DepoSplat : public IDuctor, public IConfigurable {
+        class DepoSplat : public Aux::Logger, public IDuctor, public IConfigurable {
           public:
             DepoSplat();
             virtual ~DepoSplat();
@@ -57,10 +58,17 @@ namespace WireCell {
             // if non-empty, set as tag on output frame
             std::string m_frame_tag{""};
 
+            size_t m_nthreads{1};
+            bool m_rng_substreams{false};
+            size_t m_rng_stream{0};
+
+            using channel_charge_t = std::unordered_map<int, std::vector<float> >;
+
             void process(output_queue& frames);
             ITrace::vector process_face(IAnodeFace::pointer face, const IDepo::vector& face_depos);
+            void splat_plane(IWirePlane::pointer plane, int iplane, const IDepo::vector& depos,
+                             IRandom::pointer rng, channel_charge_t& chch);
             bool start_processing(const input_pointer& depo);
-            Log::logptr_t l;
         };
     }  // namespace Gen
 }  // namespace WireCell
@@ -3,6 +3,9 @@
  * Resulting waveforms are still in floating-point form and should be
  * round()'ed and truncated to whatever integer representation is
  * wanted by some subsequent node.
+ *
+ * The output is an Aux::DenseFrame holding one row per channel that
+ * resolves to a wire plane, in channel order.
  */
 
 #ifndef WIRECELL_DIGITIZER
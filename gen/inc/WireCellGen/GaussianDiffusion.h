@@ -7,6 +7,7 @@
 #include "WireCellIface/IRandom.h"
 
 #include <memory>
+#include <vector>
 
 namespace WireCell {
     namespace Gen {
@@ -56,10 +57,50 @@ namespace WireCell {
              * domain is 1.0. */
             std::vector<double> binint(double start, double step, int nbins) const;
 
+            /** As above but fill a caller provided vector, reusing its
+             * capacity. */
+            void binint(double start, double step, int nbins, std::vector<double>& bins) const;
+
             /** Integrate Gaussian diffusion with linear weighting
              *  to redistribute the charge to the two neartest impact positions
              *  for linear interpolation of the field response */
-            std::vector<double> weight(double start, double step, int nbins, std::vector<double> pvec) const;
+            std::vector<double> weight(double start, double step, int nbins, const std::vector<double>& pvec) const;
+        };
+
+        /** A PatchArena holds the patches of a batch of
+         * GaussianDiffusion objects in one contiguous float buffer.
+         *
+         * Sampling many small depos one at a time spends much of its
+         * time allocating and freeing a patch array per depo.  Giving
+         * an arena to GaussianDiffusion::set_sampling() instead
+         * appends the patch to the arena and leaves the depo holding
+         * a view.  The arena and its scratch space are reused across
+         * batches so steady state sampling does not allocate.  All
+         * views into an arena become invalid when it is cleared.  */
+        class PatchArena {
+           public:
+            /// Forget all patches but keep the memory.
+            void clear() { m_data.clear(); }
+
+            /// Append n zeroed floats and return their offset.
+            size_t allocate(size_t n)
+            {
+                const size_t offset = m_data.size();
+                m_data.resize(offset + n, 0.0f);
+                return offset;
+            }
+
+            float* data(size_t offset) { return m_data.data() + offset; }
+            const float* data(size_t offset) const { return m_data.data() + offset; }
+
+            /// Total number of floats held.
+            size_t size() const { return m_data.size(); }
+
+            /// Scratch space used while sampling.
+            std::vector<double> tvec, pvec;
+
+           private:
+            std::vector<float> m_data;
         };
 
         class GaussianDiffusion {
@@ -74,6 +115,10 @@ namespace WireCell {
             /// patch).  See `bin()`.
             typedef Array::array_xxf patch_t;
 
+            /// A read-only view of a patch which may live in the
+            /// GaussianDiffusion or in a PatchArena.
+            typedef Eigen::Map<const patch_t> patch_view_t;
+
             /** Create a diffused deposition.
              */
 
@@ -88,17 +133,28 @@ namespace WireCell {
             /// represents the 2D bin-centered sampling of the
             /// Gaussian.
 
+            ///
+            /// If an arena is given the patch is stored there and is
+            /// only valid until the arena is cleared.  Random numbers
+            /// are drawn exactly as without an arena so sampling a
+            /// sequence of depos into an arena gives the same patches.
             void set_sampling(const Binning& tbin, const Binning& pbin, double nsigma = 3.0,
                               IRandom::pointer fluctuate = nullptr,
-                              unsigned int weightstrat = 1 /*see BinnedDiffusion ImpactDataCalculationStrategy*/);
+                              unsigned int weightstrat = 1 /*see BinnedDiffusion ImpactDataCalculationStrategy*/,
+                              PatchArena* arena = nullptr);
             void clear_sampling();
 
             /// Get the diffusion patch as an array of N_pitch rows X
             /// N_time columns.  Index as patch(i_pitch, i_time).
-            /// Call set_sampling() first.
+            /// Call set_sampling() first.  If sampled into an arena
+            /// this makes a copy, prefer patch_view().
             const patch_t& patch() const;
 
-            const std::vector<double> weights() const;
+            /// Get the patch without copying.  Same shape and
+            /// indexing as patch().
+            patch_view_t patch_view() const;
+
+            const std::vector<double>& weights() const;
 
             /// Return the absolute time bin in the binning corresponding to column 0 of the patch.
             int toffset_bin() const { return m_toffset_bin; }
@@ -120,9 +176,14 @@ namespace WireCell {
 
             GausDesc m_time_desc, m_pitch_desc;
 
-            patch_t m_patch;
+            mutable patch_t m_patch;
             std::vector<double> m_qweights;
 
+            // Set when the patch lives in an arena.
+            const PatchArena* m_arena{nullptr};
+            size_t m_arena_offset{0};
+            int m_nrows{0}, m_ncols{0};
+
             int m_toffset_bin;
             int m_poffset_bin;
         };
@@ -10,9 +10,72 @@
 
 #include "WireCellUtil/Eigen.h"
 
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
 namespace WireCell {
     namespace Gen {
 
+        /** The 2D (wire and time frequency) response arrays used by
+         * ImpactTransform depend only on the plane impact response,
+         * the impact group and the padded array shape.  This process
+         * wide cache shares them across events and threads.
+         *
+         * Entries are evicted least recently used first to stay
+         * within a byte budget.  A full plane array can be hundreds
+         * of MB so the budget should be set with the detector in
+         * mind.  A budget of zero disables caching.
+         *
+         * Entries hold a weak reference to their PIR.  An entry whose
+         * PIR has expired is never returned, so a new PIR allocated
+         * at a dead one's address can not pick up its arrays. */
+        class ImpactResponseCache {
+           public:
+            using array_ptr = std::shared_ptr<const Array::array_xxc>;
+            using pir_ptr = std::shared_ptr<const IPlaneImpactResponse>;
+            // (pir, impact group, nrows, ncols)
+            using key_t = std::tuple<const IPlaneImpactResponse*, int, int, int>;
+
+            struct Stats {
+                size_t hits{0}, misses{0}, bytes{0};
+            };
+
+            static ImpactResponseCache& instance();
+
+            /// Return the array for the PIR's impact group and
+            /// shape, calling make() on a miss.
+            array_ptr get(const pir_ptr& pir, int igroup, int nrows, int ncols,
+                          std::function<Array::array_xxc()> make);
+
+            void set_budget(size_t bytes);
+            size_t budget() const;
+            Stats stats() const;
+            void clear();
+
+           private:
+            // Most recently used first.
+            using lru_t = std::list<key_t>;
+            struct entry_t {
+                std::weak_ptr<const IPlaneImpactResponse> pir;
+                array_ptr array;
+                size_t nbytes;
+                lru_t::iterator lru;
+            };
+            using entries_t = std::map<key_t, entry_t>;
+            void erase(entries_t::iterator it);
+            void evict();
+
+            mutable std::mutex m_mutex;
+            entries_t m_entries;
+            lru_t m_lru;
+            size_t m_budget{512 * 1024 * 1024};
+            Stats m_stats;
+        };
+
         /** An ImpactTransform transforms charge on impact positions
          * into waveforms via 2D FFT.
          */
@@ -34,6 +97,12 @@ namespace WireCell {
             int m_start_tick;
             int m_end_tick;
 
+            // long-range response spectrum, empty if none
+            Waveform::compseq_t m_long_spec;
+
+            Array::array_xxc make_response(int igroup, int nrows, int ncols) const;
+            ImpactResponseCache::array_ptr response(int igroup, int nrows, int ncols) const;
+
            public:
             ImpactTransform(IPlaneImpactResponse::pointer pir,
                             const IDFT::pointer& dft,
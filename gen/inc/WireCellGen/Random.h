@@ -1,5 +1,8 @@
 /**
    Gen::Random is an IRandom which is implemented with standard C++ <random>.
+
+   The "generator" may be "default", "twister" or "philox", the latter
+   is the counter-based engine from WireCellUtil/Philox.h.
  */
 
 #ifndef WIRECELLGEN_RANDOM
@@ -14,7 +17,7 @@ namespace WireCell {
         class Random : public IRandom, public IConfigurable {
            public:
             Random(const std::string& generator = "default", const std::vector<unsigned int> seeds = {0, 0, 0, 0, 0});
-            virtual ~Random() {}
+            virtual ~Random();
 
             // IConfigurable interface
             virtual void configure(const WireCell::Configuration& config);
@@ -44,12 +47,32 @@ namespace WireCell {
             virtual int range(int first, int last);
             virtual int_func make_range(int first, int last);
 
+            /// Bulk sampling without a virtual call per sample.
+            virtual void fill_normal(float* out, size_t n, double mean, double sigma);
+            virtual void fill_uniform(float* out, size_t n, double begin, double end);
+            virtual void fill_poisson(int* out, size_t n, double mean);
+
+            /// Return a counter-based ("philox") generator whose key
+            /// comes from our seeds and whose stream comes from the
+            /// keys.  The result does not depend on our state.
+            virtual IRandom::pointer substream(const std::vector<size_t>& keys) const;
+
            private:
             std::string m_generator;
             std::vector<unsigned int> m_seeds;
+            std::vector<size_t> m_stream;  // keys if we are a substream
             IRandom* m_pimpl;
         };
 
+        /// Return an independent generator for one task of a
+        /// parallelized loop named by keys.  This is parent's
+        /// substream() if it has one.  Otherwise the seed is drawn
+        /// from parent so the caller must make these calls serially
+        /// and in a fixed task order.  Either way the result does not
+        /// depend on which thread runs the task.  A null parent gives
+        /// a null substream.
+        IRandom::pointer make_substream(IRandom::pointer parent, const std::vector<size_t>& keys = {});
+
     }  // namespace Gen
 }  // namespace WireCell
 #endif
@@ -6,7 +6,12 @@
 #include "WireCellAux/SimpleTrace.h"
 #include "WireCellAux/SimpleFrame.h"
 #include "WireCellAux/FrameTools.h"
+#include "WireCellAux/DftTools.h"
 
+#include "WireCellUtil/Parallel.h"
+
+#include <algorithm>
+#include <atomic>
 
 #include <unordered_map>
 
@@ -58,19 +63,58 @@ bool Gen::IncoherentAddNoise::operator()(const input_pointer& inframe, output_po
     auto rn = Normals::make_recycling(m_rng, 2*m_nsamples, BUG, 1, 2*m_rep_percent);
     GeneratorN rwgen(m_dft, rn);
 
-    // Limit number of warnings below
-    static bool warned = false;
-    static bool warned2 = false;
+    ITrace::vector outtraces;
+    if (m_nbatch) {
+        add_batched(*inframe->traces(), outtraces, rwgen);
+    }
+    else {
+        add_each(*inframe->traces(), outtraces, rwgen);
+    }
+    outframe = make_shared<SimpleFrame>(inframe->ident(), inframe->time(), outtraces, inframe->tick());
+    log->debug("call={} frame={} {} traces",
+               m_count, inframe->ident(), outtraces.size());
+
+    log->debug("input : {}", Aux::taginfo(inframe));
+    log->debug("output: {}", Aux::taginfo(outframe));
+
+    ++m_count;
+    return true;
+}
+
+// Limit number of warnings
+static std::atomic<bool> warned_nspec{false};
+static std::atomic<bool> warned_undersized{false};
+
+static void fill_sigmas(real_vector_t& sigmas, const IChannelSpectrum::amplitude_t& spec)
+{
+    const float sqrt2opi = sqrt(2.0/3.141592);
+    sigmas.resize(spec.size());
+    for (size_t ind=0; ind < spec.size(); ++ind) {
+        sigmas[ind] = spec[ind]*sqrt2opi;
+    }
+}
+
+const real_vector_t& Gen::IncoherentAddNoise::sigmas(const IChannelSpectrum::amplitude_t& spec)
+{
+    auto it = m_sigmas.find(&spec);
+    if (it != m_sigmas.end() and it->second.size() == spec.size()) {
+        return it->second;
+    }
+    auto& sigmas = m_sigmas[&spec];
+    fill_sigmas(sigmas, spec);
+    return sigmas;
+}
 
+void Gen::IncoherentAddNoise::add_each(const ITrace::vector& intraces, ITrace::vector& outtraces,
+                                       GeneratorN& rwgen)
+{
     // Make waveforms of size nsample from each model, adding only
     // ncharge of their element to the trace charge.  This
     // full-nsample followed by ncharge-truncation may CPU-wasteful in
     // the sparse traces case.
 
-    const float sqrt2opi = sqrt(2.0/3.141592);
-
-    ITrace::vector outtraces;
-    for (const auto& intrace : *inframe->traces()) {
+    real_vector_t sigmas;
+    for (const auto& intrace : intraces) {
 
         const int chid = intrace->channel();
         auto charge = intrace->charge(); // copies
@@ -88,23 +132,15 @@ bool Gen::IncoherentAddNoise::operator()(const input_pointer& inframe, output_po
             // We could interpolate to correct for that which would
             // slow things down.  Better to correct the model(s) code
             // and configuration.
-            if (not warned and nspec != m_nsamples) {
+            if (nspec != m_nsamples and not warned_nspec.exchange(true)) {
                 log->warn("model {} produced {} samples instead of expected {}, future warnings muted",
                           mtn, nspec, m_nsamples);
-                warned = true;
-            }
-
-            const size_t nsigmas = nspec;
-            // const nsigmas = m_nsamples;
-            real_vector_t sigmas(nsigmas);
-            for (size_t ind=0; ind < nsigmas; ++ind) {
-                sigmas[ind] = spec[ind]*sqrt2opi;
             }
 
+            fill_sigmas(sigmas, spec);
             auto wave = rwgen.wave(sigmas);
-            if (not warned2 and wave.size() < ncharge) {
+            if (wave.size() < ncharge and not warned_undersized.exchange(true)) {
                 log->warn("undersized noise {} for input waveform {}, future warnings muted", wave.size(), ncharge);
-                warned2 = true;
             }
             wave.resize(ncharge);
             Waveform::increase(charge, wave);
@@ -114,15 +150,137 @@ bool Gen::IncoherentAddNoise::operator()(const input_pointer& inframe, output_po
         auto trace = make_shared<SimpleTrace>(chid, intrace->tbin(), charge);
         outtraces.push_back(trace);
     }
-    outframe = make_shared<SimpleFrame>(inframe->ident(), inframe->time(), outtraces, inframe->tick());
-    log->debug("call={} frame={} {} traces",
-               m_count, inframe->ident(), outtraces.size());
+}
 
-    log->debug("input : {}", Aux::taginfo(inframe));
-    log->debug("output: {}", Aux::taginfo(outframe));
+// As add_each() but the noise spectra of up to nbatch*nthreads
+// (trace, model) pairs are collected and transformed with one
+// multi-row inverse DFT per nbatch of them, blocks spread over
+// threads.  Spectra are drawn and noise is added in the same order as
+// add_each() so results agree with it up to DFT rounding.
+void Gen::IncoherentAddNoise::add_batched(const ITrace::vector& intraces, ITrace::vector& outtraces,
+                                          GeneratorN& rwgen)
+{
+    const size_t ntraces = intraces.size();
+    std::vector<ITrace::ChargeSequence> charges(ntraces);
+
+    // A noise wave to add to a trace, either already made or pending
+    // as a row of a batch.
+    struct job_t {
+        size_t itrace;
+        real_vector_t wave;
+        size_t irow;
+    };
+    std::vector<job_t> jobs;
+    std::vector<complex_vector_t> pending;
+    const size_t nround = m_nbatch * m_nthreads;
+
+    auto flush = [&]() {
+        const size_t nblocks = (pending.size() + m_nbatch - 1) / m_nbatch;
+        std::vector<Aux::DftTools::real_array_t> waves(nblocks);
+        Parallel::for_each(nblocks, m_nthreads, [&](size_t iblock) {
+            const size_t beg = iblock * m_nbatch;
+            const size_t nrows = std::min(m_nbatch, pending.size() - beg);
+            Aux::DftTools::complex_array_t specs(nrows, m_nsamples);
+            for (size_t irow = 0; irow < nrows; ++irow) {
+                const auto& spec = pending[beg + irow];
+                for (size_t icol = 0; icol < m_nsamples; ++icol) {
+                    specs(irow, icol) = spec[icol];
+                }
+            }
+            waves[iblock] = Aux::DftTools::inv_c2r(m_dft, specs, 1);
+        });
+
+        for (auto& job : jobs) {
+            auto& charge = charges[job.itrace];
+            const size_t ncharge = charge.size();
+            if (job.wave.empty()) {
+                const auto& block = waves[job.irow / m_nbatch];
+                const size_t irow = job.irow % m_nbatch;
+                const size_t nadd = std::min(ncharge, m_nsamples);
+                for (size_t ind = 0; ind < nadd; ++ind) {
+                    charge[ind] += block(irow, ind);
+                }
+                continue;
+            }
+            job.wave.resize(ncharge);
+            Waveform::increase(charge, job.wave);
+        }
+        jobs.clear();
+        pending.clear();
+    };
 
-    ++m_count;
-    return true;
+    for (size_t itrace = 0; itrace < ntraces; ++itrace) {
+        const auto& intrace = intraces[itrace];
+        const int chid = intrace->channel();
+        charges[itrace] = intrace->charge(); // copies
+        const size_t ncharge = charges[itrace].size();
+
+        for (auto& [mtn, model] : m_models) {
+            const auto& spec = model->channel_spectrum(chid);
+            const size_t nspec = spec.size();
+
+            if (! nspec) {
+                continue;       // channel not in model
+            }
+
+            if (nspec != m_nsamples) {
+                // Odd sized model, make it now and out of the batch.
+                if (not warned_nspec.exchange(true)) {
+                    log->warn("model {} produced {} samples instead of expected {}, future warnings muted",
+                              mtn, nspec, m_nsamples);
+                }
+                auto wave = rwgen.wave(sigmas(spec));
+                if (wave.size() < ncharge and not warned_undersized.exchange(true)) {
+                    log->warn("undersized noise {} for input waveform {}, future warnings muted", wave.size(), ncharge);
+                }
+                jobs.push_back({itrace, std::move(wave), 0});
+                continue;
+            }
+
+            if (m_nsamples < ncharge and not warned_undersized.exchange(true)) {
+                log->warn("undersized noise {} for input waveform {}, future warnings muted", m_nsamples, ncharge);
+            }
+            jobs.push_back({itrace, {}, pending.size()});
+            pending.push_back(rwgen.spec(sigmas(spec)));
+            if (pending.size() == nround) {
+                flush();
+            }
+        }
+    }
+    flush();
+
+    for (size_t itrace = 0; itrace < ntraces; ++itrace) {
+        const auto& intrace = intraces[itrace];
+        auto trace = make_shared<SimpleTrace>(intrace->channel(), intrace->tbin(), charges[itrace]);
+        outtraces.push_back(trace);
+    }
+}
+
+void Gen::IncoherentAddNoise::configure(const WireCell::Configuration& cfg)
+{
+    NoiseBaseT<IChannelSpectrum>::configure(cfg);
+    m_nbatch = std::max(0, get(cfg, "nbatch", (int) m_nbatch));
+    m_nthreads = std::max(1, get(cfg, "nthreads", (int) m_nthreads));
+    if (m_nthreads > 1 and !m_nbatch) {
+        log->warn("nthreads={} has no effect without nbatch", m_nthreads);
+    }
+    m_sigmas.clear();
+}
+
+WireCell::Configuration Gen::IncoherentAddNoise::default_configuration() const
+{
+    auto cfg = NoiseBase::default_configuration();
+
+    // If nonzero, make the noise of this many traces with one
+    // multi-row inverse DFT.  Zero makes noise one trace at a time.
+    cfg["nbatch"] = (int) m_nbatch;
+
+    // Number of threads over which batches are spread.  Random
+    // numbers are always drawn serially so the output does not
+    // depend on this.  Only used when nbatch is nonzero.
+    cfg["nthreads"] = (int) m_nthreads;
+
+    return cfg;
 }
 
 bool Gen::CoherentAddNoise::operator()(const input_pointer& inframe, output_pointer& outframe)
@@ -2,6 +2,7 @@
 #include "WireCellGen/GaussianDiffusion.h"
 #include "WireCellUtil/Units.h"
 
+#include <algorithm>
 #include <iostream>  // debug
 #include <unordered_map>
 using namespace std;
@@ -88,7 +89,7 @@ bool Gen::BinnedDiffusion_transform::add(IDepo::pointer depo, double sigma_time,
     //   //   if (bin == bin_beg)  m_diffs.insert(gd);
     //   this->add(gd, bin);
     // }
-    m_diffs.insert(gd);
+    m_diffs.push_back(gd);
     return true;
 }
 
@@ -223,67 +224,76 @@ void Gen::BinnedDiffusion_transform::get_charge_matrix(std::vector<Eigen::Sparse
     }
 }
 
+// Dense per-impact lookups replacing the impact->channel,
+// impact->reduced impact and reduced impact->array maps.  Impacts not
+// covered by any wire and reduced impacts without an array fall back
+// to index 0 as the original std::map::operator[] lookups did.
+namespace {
+    struct ImpactLookup {
+        std::vector<int> channel;     // impact # -> wire index
+        std::vector<int> array;       // impact # -> array # of its reduced impact
+        std::vector<int> next_array;  // impact # -> array # of reduced impact + 1
+
+        ImpactLookup(const Pimpos& pimpos, const std::vector<int>& vec_impact)
+        {
+            const int nimps = pimpos.impact_binning().nbins();
+            const int nwires = pimpos.region_binning().nbins();
+            channel.assign(nimps, 0);
+            std::vector<int> redimp(nimps, 0);
+            for (int wireind = 0; wireind != nwires; wireind++) {
+                const int wire_imp_no = pimpos.wire_impact(wireind);
+                const auto imps_range = pimpos.wire_impacts(wireind);
+                const int beg = std::max(imps_range.first, 0);
+                const int end = std::min(imps_range.second, nimps);
+                for (int imp_no = beg; imp_no < end; imp_no++) {
+                    channel[imp_no] = wireind;
+                    redimp[imp_no] = imp_no - wire_imp_no;
+                }
+            }
+
+            // Last one wins, as with repeated map assignment.
+            auto array_of = [&](int red) {
+                int found = 0;
+                for (size_t i = 0; i != vec_impact.size(); i++) {
+                    if (vec_impact[i] == red) found = i;
+                }
+                return found;
+            };
+            array.resize(nimps);
+            next_array.resize(nimps);
+            for (int imp_no = 0; imp_no != nimps; imp_no++) {
+                array[imp_no] = array_of(redimp[imp_no]);
+                next_array[imp_no] = array_of(redimp[imp_no] + 1);
+            }
+        }
+    };
+}  // namespace
+
 // a new function to generate the result for the entire frame ...
 void Gen::BinnedDiffusion_transform::get_charge_vec(
     std::vector<std::vector<std::tuple<int, int, double> > >& vec_vec_charge, std::vector<int>& vec_impact)
 {
     const auto ib = m_pimpos.impact_binning();
+    const ImpactLookup lu(m_pimpos, vec_impact);
 
-    // map between reduced impact # to array #
-
-    std::map<int, int> map_redimp_vec;
-    std::vector<std::unordered_map<long int, int> > vec_map_pair_pos;
-    for (size_t i = 0; i != vec_impact.size(); i++) {
-        map_redimp_vec[vec_impact[i]] = int(i);
-        std::unordered_map<long int, int> map_pair_pos;
-        vec_map_pair_pos.push_back(map_pair_pos);
-    }
-
-    const auto rb = m_pimpos.region_binning();
-    // map between impact # to channel #
-    std::map<int, int> map_imp_ch;
-    // map between impact # to reduced impact #
-    std::map<int, int> map_imp_redimp;
-
-    // std::cout << ib.nbins() << " " << rb.nbins() << std::endl;
-    for (int wireind = 0; wireind != rb.nbins(); wireind++) {
-        int wire_imp_no = m_pimpos.wire_impact(wireind);
-        std::pair<int, int> imps_range = m_pimpos.wire_impacts(wireind);
-        for (int imp_no = imps_range.first; imp_no != imps_range.second; imp_no++) {
-            map_imp_ch[imp_no] = wireind;
-            map_imp_redimp[imp_no] = imp_no - wire_imp_no;
-
-            //  std::cout << imp_no << " " << wireind << " " << wire_imp_no << " " << ib.center(imp_no) << " " <<
-            //  rb.center(wireind) << " " <<  ib.center(imp_no) - rb.center(wireind) << std::endl;
-            // std::cout << imp_no << " " << map_imp_ch[imp_no] << " " << map_imp_redimp[imp_no] << std::endl;
-        }
-    }
-
-    //  std::unordered_map<stgsd::tuple<int,int,int>, int> map_tuple_pos;
+    // per array, (channel, tick) -> position in its charge vector
+    std::vector<std::unordered_map<long int, int> > vec_map_pair_pos(vec_impact.size());
 
-    //  int min_redimp =  m_pimpos.wire_impacts(2).first - m_pimpos.wire_impact(2);
-    //  int max_redimp =  m_pimpos.wire_impacts(2).second - 1 - m_pimpos.wire_impact(2);
     int min_imp = 0;
     int max_imp = ib.nbins();
 
-    // std::cout << min_redimp << " " << max_redimp << " " << max_imp << std::endl;
-
     int counter = 0;
 
-    // std::set<std::shared_ptr<GaussianDiffusion>, GausDiffTimeCompare> m_diffs1;
-    // for (auto diff : m_diffs){
-    //    diff->set_sampling(m_tbins, ib, m_nsigma, m_fluctuate, m_calcstrat);
-    //    m_diffs1.insert(diff);
-    // }
+    // Patches are sampled into one reused buffer.
+    PatchArena arena;
 
     for (auto diff : m_diffs) {
-        //    std::cout << diff->depo()->time() << std::endl
-        // diff->set_sampling(m_tbins, ib, m_nsigma, 0, m_calcstrat);
-        diff->set_sampling(m_tbins, ib, m_nsigma, m_fluctuate, m_calcstrat);
+        arena.clear();
+        diff->set_sampling(m_tbins, ib, m_nsigma, m_fluctuate, m_calcstrat, &arena);
         counter++;
 
-        const auto patch = diff->patch();
-        const auto qweight = diff->weights();
+        const auto patch = diff->patch_view();
+        const auto& qweight = diff->weights();
 
         const int poffset_bin = diff->poffset_bin();
         const int toffset_bin = diff->toffset_bin();
@@ -291,16 +301,13 @@ void Gen::BinnedDiffusion_transform::get_charge_vec(
         const int np = patch.rows();
         const int nt = patch.cols();
 
-        // std::cout << np << " " << nt << std::endl;
-
         for (int pbin = 0; pbin != np; pbin++) {
             int abs_pbin = pbin + poffset_bin;
             if (abs_pbin < min_imp || abs_pbin >= max_imp) continue;
             double weight = qweight[pbin];
-            auto const channel = map_imp_ch[abs_pbin];
-            auto const redimp = map_imp_redimp[abs_pbin];
-            auto const array_num_redimp = map_redimp_vec[redimp];
-            auto const next_array_num_redimp = map_redimp_vec[redimp + 1];
+            auto const channel = lu.channel[abs_pbin];
+            auto const array_num_redimp = lu.array[abs_pbin];
+            auto const next_array_num_redimp = lu.next_array[abs_pbin];
 
             auto& map_pair_pos = vec_map_pair_pos.at(array_num_redimp);
             auto& next_map_pair_pos = vec_map_pair_pos.at(next_array_num_redimp);
@@ -308,86 +315,41 @@ void Gen::BinnedDiffusion_transform::get_charge_vec(
             auto& vec_charge = vec_vec_charge.at(array_num_redimp);
             auto& next_vec_charge = vec_vec_charge.at(next_array_num_redimp);
 
+            const long int chan_index = channel * 100000L;
             for (int tbin = 0; tbin != nt; tbin++) {
                 int abs_tbin = tbin + toffset_bin;
                 double charge = patch(pbin, tbin);
 
-                // if (map_imp_ch[abs_pbin]==1459){
-                //   std::cout << pbin+poffset_bin << " " << pbin << " " << tbin << " " << charge << " " << std::endl;
-                // }
-                //	std::cout << pbin << " " << tbin << " " << patch(pbin,tbin) << std::endl;
-                // figure out how to convert the abs_pbin to fine position
-                // figure out how to use the weight given the above ???
-                // the other side
-                //	if (map_imp_redimp[abs_pbin]==max_redimp){
-                //  vec_vec_charge.at(map_redimp_vec[min_redimp]).push_back(std::make_tuple(map_imp_ch[abs_pbin]+1,abs_tbin,charge*(1-weight)));
-                //}else{
-                //}
-
-                long int index1 = channel * 100000 + abs_tbin;
-                auto it = map_pair_pos.find(index1);
-                if (it == map_pair_pos.end()) {
-                    map_pair_pos[index1] = vec_charge.size();
+                long int index1 = chan_index + abs_tbin;
+
+                // One hash probe per element and array: try_emplace
+                // either inserts the new position or finds the old one.
+                auto got = map_pair_pos.try_emplace(index1, (int) vec_charge.size());
+                if (got.second) {
                     vec_charge.emplace_back(channel, abs_tbin, charge * weight);
                 }
                 else {
-                    std::get<2>(vec_charge.at(it->second)) += charge * weight;
+                    std::get<2>(vec_charge[got.first->second]) += charge * weight;
                 }
 
-                auto it1 = next_map_pair_pos.find(index1);
-                if (it1 == next_map_pair_pos.end()) {
-                    next_map_pair_pos[index1] = next_vec_charge.size();
+                auto got1 = next_map_pair_pos.try_emplace(index1, (int) next_vec_charge.size());
+                if (got1.second) {
                     next_vec_charge.emplace_back(channel, abs_tbin, charge * (1 - weight));
                 }
                 else {
-                    std::get<2>(next_vec_charge.at(it1->second)) += charge * (1 - weight);
+                    std::get<2>(next_vec_charge[got1.first->second]) += charge * (1 - weight);
                 }
-
-                // if
-                // (map_tuple_pos.find(std::make_tuple(map_redimp_vec[map_imp_redimp[abs_pbin]],map_imp_ch[abs_pbin],abs_tbin))==map_tuple_pos.end()){
-                //   map_tuple_pos[std::make_tuple(map_redimp_vec[map_imp_redimp[abs_pbin]],map_imp_ch[abs_pbin],abs_tbin)]
-                //   = vec_vec_charge.at(map_redimp_vec[map_imp_redimp[abs_pbin] ]).size();
-                //   vec_vec_charge.at(map_redimp_vec[map_imp_redimp[abs_pbin]
-                //   ]).push_back(std::make_tuple(map_imp_ch[abs_pbin],abs_tbin,charge*weight));
-                // }else{
-                //   std::get<2>(vec_vec_charge.at(map_redimp_vec[map_imp_redimp[abs_pbin]
-                //   ]).at(map_tuple_pos[std::make_tuple(map_redimp_vec[map_imp_redimp[abs_pbin]],map_imp_ch[abs_pbin],abs_tbin)]))
-                //   += charge * weight;
-                // }
-
-                // if
-                // (map_tuple_pos.find(std::make_tuple(map_redimp_vec[map_imp_redimp[abs_pbin]+1],map_imp_ch[abs_pbin],abs_tbin))==map_tuple_pos.end()){
-                //   map_tuple_pos[std::make_tuple(map_redimp_vec[map_imp_redimp[abs_pbin]+1],map_imp_ch[abs_pbin],abs_tbin)]
-                //   = vec_vec_charge.at(map_redimp_vec[map_imp_redimp[abs_pbin]+1]).size();
-                //   vec_vec_charge.at(map_redimp_vec[map_imp_redimp[abs_pbin]+1]).push_back(std::make_tuple(map_imp_ch[abs_pbin],abs_tbin,charge*(1-weight)));
-                // }else{
-                //   std::get<2>(vec_vec_charge.at(map_redimp_vec[map_imp_redimp[abs_pbin]+1]).at(map_tuple_pos[std::make_tuple(map_redimp_vec[map_imp_redimp[abs_pbin]+1],map_imp_ch[abs_pbin],abs_tbin)])
-                //   ) += charge*(1-weight);
-                // }
             }
         }
 
         if (counter % 5000 == 0) {
-            // std::vector<std::tuple<int,int,int> > del_keys;
-            // for (auto it  = map_tuple_pos.begin(); it!=map_tuple_pos.end(); it++){
-            // 	if (get<2>(it->first) < toffset_bin - 60){
-            // 	  del_keys.push_back(it->first);
-            // 	}
-            // }
-            // for (auto it = del_keys.begin(); it!=del_keys.end(); it++){
-            // 	map_tuple_pos.erase(*it);
-            // }
-            // map_tuple_pos.clear();
             for (auto it = vec_map_pair_pos.begin(); it != vec_map_pair_pos.end(); it++) {
                 it->clear();
             }
         }
 
         diff->clear_sampling();
-        // need to figure out wire #, time #, charge, and weight ...
     }
-
-    //
 }
 
 // Gen::ImpactData::pointer Gen::BinnedDiffusion_transform::impact_data(int bin) const
@@ -358,7 +358,7 @@ bool Gen::DepoFluxSplat::operator()(const input_pointer& in, output_pointer& out
             gd.set_sampling(m_tbins, wbins, m_nsigma, 0, 1);
 
             // Transfer depo's patch to itraces
-            const auto patch = gd.patch(); // 2D array
+            const auto& patch = gd.patch(); // 2D array
 
 
             // The absolute pitch bin for the first row of the patch array.
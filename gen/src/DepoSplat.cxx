@@ -1,8 +1,11 @@
 #include "WireCellGen/DepoSplat.h"
 #include "WireCellGen/GaussianDiffusion.h"
+#include "WireCellGen/Random.h"
 
 #include "WireCellUtil/Binning.h"
 #include "WireCellUtil/NamedFactory.h"
+#include "WireCellUtil/Parallel.h"
+#include "WireCellUtil/Philox.h"
 
 // from ductor
 #include "WireCellGen/BinnedDiffusion.h"
@@ -17,7 +20,8 @@
 // #include <iostream>
 
 
-WIRECELL_FACTORY(DepoSplat, WireCell::Gen::DepoSplat, WireCell::IDuctor, WireCell::IConfigurable)
+WIRECELL_FACTORY(DepoSplat, WireCell::Gen::DepoSplat,
+                 WireCell::INamed, WireCell::IDuctor, WireCell::IConfigurable)
 
 using namespace std;
 using namespace WireCell;
@@ -28,7 +32,8 @@ Gen::DepoSplat::~DepoSplat() {}
 
 
 Gen::DepoSplat::DepoSplat()
-  : m_anode_tn("AnodePlane")
+  : Aux::Logger("DepoSplat", "sim")
+  , m_anode_tn("AnodePlane")
   , m_start_time(0.0 * units::ns)
   , m_readout_time(5.0 * units::ms)
   , m_tick(0.5 * units::us)
@@ -36,7 +41,6 @@ Gen::DepoSplat::DepoSplat()
   , m_nsigma(3.0)
   , m_mode("continuous")
   , m_frame_count(0)
-  , l(Log::logger("sim"))
 {
 }
 
@@ -80,6 +84,21 @@ WireCell::Configuration Gen::DepoSplat::default_configuration() const
     // Tag to apply to output frame if non-empty.
     cfg["frame_tag"] = "";
 
+    /// Number of threads over which the planes of a face are splatted.
+    cfg["nthreads"] = (int) m_nthreads;
+
+    /// If true, each plane samples fluctuations from its own
+    /// substream of "rng" keyed by "rng_stream", frame, anode, face
+    /// and plane so the output does not depend on "nthreads".  Forced true if
+    /// nthreads > 1.
+    cfg["rng_substreams"] = m_rng_substreams;
+
+    /// A key which separates the substreams of this component from
+    /// those of other components drawing from the same "rng" for the
+    /// same anode.  If negative, a key is made from the type and
+    /// instance name.
+    cfg["rng_stream"] = -1;
+
     return cfg;
 }
 
@@ -114,7 +133,15 @@ void Gen::DepoSplat::configure(const WireCell::Configuration& cfg)
 
     m_frame_tag = get<std::string>(cfg, "frame_tag", "");
 
-    l->debug("DepoSplat: tagging {}, AnodePlane: {}, mode: {}, time start: {} ms, readout time: {} ms, frame start: {}, fluctuate: {}",
+    m_nthreads = std::max(1, get(cfg, "nthreads", (int) m_nthreads));
+    m_rng_substreams = get(cfg, "rng_substreams", m_rng_substreams);
+    if (m_rng and m_nthreads > 1) {
+        m_rng_substreams = true;
+    }
+    const int rng_stream = get(cfg, "rng_stream", -1);
+    m_rng_stream = rng_stream < 0 ? philox_stream_of("DepoSplat:" + get_name()) : rng_stream;
+
+    log->debug("tagging {}, AnodePlane: {}, mode: {}, time start: {} ms, readout time: {} ms, frame start: {}, fluctuate: {}",
              m_frame_tag,
              m_anode_tn, m_mode, m_start_time / units::ms, m_readout_time / units::ms,
              m_frame_count, m_rng != nullptr);
@@ -130,7 +157,7 @@ void Gen::DepoSplat::process(output_queue& frames)
         IDepo::vector face_depos, dropped_depos;
         auto bb = face->sensitive();
         if (bb.empty()) {
-            l->debug("DepoSplat: anode: {} face: {} is "
+            log->debug("anode: {} face: {} is "
                      "marked insensitive, skipping",
                      m_anode->ident(), face->ident());
             continue;
@@ -147,16 +174,14 @@ void Gen::DepoSplat::process(output_queue& frames)
 
         if (face_depos.size()) {
             auto ray = bb.bounds();
-            l->debug("DepoSplat: "
-                "anode: {}, face: {}, processing {} depos spanning "
+            log->debug("anode: {}, face: {}, processing {} depos spanning "
                 "t:[{},{}]ms, bb:[{}-->{}]cm",
                 m_anode->ident(), face->ident(), face_depos.size(), face_depos.front()->time() / units::ms,
                 face_depos.back()->time() / units::ms, ray.first / units::cm, ray.second / units::cm);
         }
         if (dropped_depos.size()) {
             auto ray = bb.bounds();
-            l->debug("DepoSplat: "
-                "anode: {}, face: {}, dropped {} depos spanning "
+            log->debug("anode: {}, face: {}, dropped {} depos spanning "
                 "t:[{},{}]ms, outside bb:[{}-->{}]cm",
                 m_anode->ident(), face->ident(), dropped_depos.size(), dropped_depos.front()->time() / units::ms,
                 dropped_depos.back()->time() / units::ms, ray.first / units::cm, ray.second / units::cm);
@@ -173,7 +198,7 @@ void Gen::DepoSplat::process(output_queue& frames)
     }
     frame->tag_frame(m_frame_tag);
     frames.push_back(frame);
-    l->debug("DepoSplat: made frame: {} with {} traces @ {}ms", m_frame_count, traces.size(), m_start_time / units::ms);
+    log->debug("made frame: {} with {} traces @ {}ms", m_frame_count, traces.size(), m_start_time / units::ms);
 
     // fixme: what about frame overflow here?  If the depos extend
     // beyond the readout where does their info go?  2nd order,
@@ -238,22 +263,68 @@ bool Gen::DepoSplat::operator()(const input_pointer& depo, output_queue& frames)
 
 ITrace::vector Gen::DepoSplat::process_face(IAnodeFace::pointer face, const IDepo::vector& depos)
 
+{
+    auto planes = face->planes();
+    const size_t nplanes = planes.size();
+
+    // Per-plane substreams are keyed by (stream, frame, anode, face,
+    // plane) and made serially so the result does not depend on the
+    // number of threads.
+    std::vector<IRandom::pointer> rngs(nplanes, m_rng);
+    if (m_rng_substreams) {
+        for (size_t iplane = 0; iplane < nplanes; ++iplane) {
+            rngs[iplane] = Gen::make_substream(m_rng, {m_rng_stream, size_t(m_frame_count),
+                                                       size_t(m_anode->ident()), size_t(face->ident()), iplane});
+        }
+    }
+
+    std::vector<channel_charge_t> plane_chch(nplanes);
+    Parallel::for_each(nplanes, m_nthreads, [&](size_t iplane) {
+        splat_plane(planes[iplane], iplane, depos, rngs[iplane], plane_chch[iplane]);
+    });
+
+    // channel-charge map, merged in plane order
+    channel_charge_t chch;
+    for (auto& one : plane_chch) {
+        for (auto& it : one) {
+            auto& charge = chch[it.first];
+            if (charge.empty()) {
+                charge = std::move(it.second);
+                continue;
+            }
+            if (charge.size() < it.second.size()) {
+                charge.resize(it.second.size(), 0.0);
+            }
+            for (size_t ind = 0; ind < it.second.size(); ++ind) {
+                charge[ind] += it.second[ind];
+            }
+        }
+        one.clear();
+    }
+
+    // make output traces
+    ITrace::vector traces;
+    for (auto& chchit : chch) {
+        const int chid = chchit.first;
+        auto& chv = chchit.second;
+        auto trace = std::make_shared<SimpleTrace>(chid, 0, chv);
+        traces.push_back(trace);
+    }
+    return traces;
+}
+
+void Gen::DepoSplat::splat_plane(IWirePlane::pointer plane, int iplane, const IDepo::vector& depos,
+                                 IRandom::pointer rng, channel_charge_t& chch)
 {
     // why????
     const int time_offset = 2;  // # of ticks
     // const double difusion_scaler = 6.;
     const double charge_scaler = 1.;  // 18.;
 
-    // channel-charge map
-    std::unordered_map<int, std::vector<float> > chch;
-
     // tick-edged bins
     Binning tbins(m_readout_time / m_tick, m_start_time, m_start_time + m_readout_time);
 
-    int iplane = -1;
-    for (auto plane : face->planes()) {
-        ++iplane;
-
+    {
         const Pimpos* pimpos = plane->pimpos();
 
         // wire-centered pitch bins
@@ -333,8 +404,8 @@ ITrace::vector Gen::DepoSplat::process_face(IAnodeFace::pointer face, const IDep
             Gen::GausDesc pitch_desc(pcen, psig);
 
             auto gd = std::make_shared<Gen::GaussianDiffusion>(depo, time_desc, pitch_desc);
-            gd->set_sampling(tbins, wbins, m_nsigma, m_rng, 1);
-            const auto patch = gd->patch();
+            gd->set_sampling(tbins, wbins, m_nsigma, rng, 1);
+            const auto& patch = gd->patch();
 
             // std::stringstream ss;
             // ss << "splat: depo=" << depo->pos()/units::mm << "mm "
@@ -368,19 +439,9 @@ ITrace::vector Gen::DepoSplat::process_face(IAnodeFace::pointer face, const IDep
             }
             ++idepo;
         } // over depos
-        l->debug("DepoSplat: plane {} "
+        log->debug("plane {} "
                  "dropped {} (time) and {} (pitch) from {} total",
                  iplane, t_dropped, p_dropped, depos.size());
 
     }
-
-    // make output traces
-    ITrace::vector traces;
-    for (auto& chchit : chch) {
-        const int chid = chchit.first;
-        auto& chv = chchit.second;
-        auto trace = std::make_shared<SimpleTrace>(chid, 0, chv);
-        traces.push_back(trace);
-    }
-    return traces;
 }
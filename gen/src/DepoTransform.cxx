@@ -40,6 +40,7 @@
 #include "WireCellGen/DepoTransform.h"
 #include "WireCellGen/ImpactTransform.h"
 #include "WireCellGen/BinnedDiffusion_transform.h"
+#include "WireCellGen/Random.h"
 
 #include "WireCellAux/SimpleTrace.h"
 #include "WireCellAux/SimpleFrame.h"
@@ -51,6 +52,8 @@
 #include "WireCellUtil/Units.h"
 #include "WireCellUtil/Point.h"
 #include "WireCellUtil/NamedFactory.h"
+#include "WireCellUtil/Parallel.h"
+#include "WireCellUtil/Philox.h"
 
 #include <algorithm>
 #include <vector>
@@ -96,6 +99,21 @@ void Gen::DepoTransform::configure(const WireCell::Configuration& cfg)
     m_drift_speed = get<double>(cfg, "drift_speed", m_drift_speed);
     m_frame_count = get<int>(cfg, "first_frame_number", m_frame_count);
 
+    m_nthreads = std::max(1, get(cfg, "nthreads", (int) m_nthreads));
+    m_rng_substreams = get(cfg, "rng_substreams", m_rng_substreams);
+    if (m_rng and m_nthreads > 1 and !m_rng_substreams) {
+        log->debug("nthreads={} requires rng_substreams, enabling", m_nthreads);
+        m_rng_substreams = true;
+    }
+    const int rng_stream = get(cfg, "rng_stream", -1);
+    m_rng_stream = rng_stream < 0 ? philox_stream_of("DepoTransform:" + get_name()) : rng_stream;
+
+    // Process wide, the last configured value wins.
+    const int cache_mb = get(cfg, "response_cache_mb", -1);
+    if (cache_mb >= 0) {
+        ImpactResponseCache::instance().set_budget(size_t(cache_mb) * 1024 * 1024);
+    }
+
     m_process_planes = {0,1,2};
 
     if (cfg["process_planes"].isArray()) {
@@ -160,6 +178,31 @@ WireCell::Configuration Gen::DepoTransform::default_configuration() const
     // type-name for the DFT to use
     cfg["dft"] = "FftwDFT";
 
+    /// Number of threads over which the (face, plane) tasks are
+    /// spread.  Each task has its own diffusion and impact transform.
+    /// Note, a subclass overriding modify_depo() must make it thread
+    /// safe to use more than one thread.
+    cfg["nthreads"] = (int) m_nthreads;
+
+    /// If true, each (face, plane) task samples fluctuations from its
+    /// own substream of "rng" keyed by "rng_stream", frame, anode,
+    /// face and plane.  The output is then the same for any
+    /// "nthreads" but differs from the default where all planes share
+    /// "rng".  Forced true if nthreads > 1.
+    cfg["rng_substreams"] = m_rng_substreams;
+
+    /// A key which separates the substreams of this component from
+    /// those of other components drawing from the same "rng" for the
+    /// same anode.  If negative, a key is made from the type and
+    /// instance name.
+    cfg["rng_stream"] = -1;
+
+    /// If non-negative, set the budget in MB of the process wide
+    /// cache of 2D response spectra shared by all DepoTransforms.
+    /// Zero disables the cache.  Default (-1) keeps the current
+    /// budget, initially 512 MB.
+    cfg["response_cache_mb"] = -1;
+
     // Need to REMOVE this otherwise [] will be the default
     // NOTE: People doing similar things should be aware of this!!!
     // Ref: https://github.com/LArSoft/larwirecell/pull/55
@@ -168,6 +211,45 @@ WireCell::Configuration Gen::DepoTransform::default_configuration() const
     return cfg;
 }
 
+ITrace::vector Gen::DepoTransform::transform_plane(IAnodeFace::pointer face, int iplane,
+                                                   const IDepo::vector& face_depos, IRandom::pointer rng)
+{
+    auto plane = face->planes().at(iplane);
+    const Pimpos* pimpos = plane->pimpos();
+
+    Binning tbins(m_readout_time / m_tick, m_start_time, m_start_time + m_readout_time);
+
+    Gen::BinnedDiffusion_transform bindiff(*pimpos, tbins, m_nsigma, rng);
+    for (auto depo : face_depos) {
+        depo = modify_depo(plane->planeid(), depo);
+        bindiff.add(depo, depo->extent_long() / m_drift_speed, depo->extent_tran());
+    }
+
+    auto& wires = plane->wires();
+
+    auto pir = m_pirs.at(iplane);
+    Gen::ImpactTransform transform(pir, m_dft, bindiff);
+
+    ITrace::vector traces;
+    const int nwires = pimpos->region_binning().nbins();
+    for (int iwire = 0; iwire < nwires; ++iwire) {
+        auto wave = transform.waveform(iwire);
+
+        auto mm = Waveform::edge(wave);
+        if (mm.first == (int) wave.size()) {  // all zero
+            continue;
+        }
+
+        int chid = wires[iwire]->channel();
+        int tbin = mm.first;
+
+        ITrace::ChargeSequence charge(wave.begin() + mm.first, wave.begin() + mm.second);
+        auto trace = make_shared<SimpleTrace>(chid, tbin, charge);
+        traces.push_back(trace);
+    }
+    return traces;
+}
+
 bool Gen::DepoTransform::operator()(const input_pointer& in, output_pointer& out)
 {
     if (!in) {
@@ -180,12 +262,19 @@ bool Gen::DepoTransform::operator()(const input_pointer& in, output_pointer& out
     auto depos = in->depos();
     size_t ndepos_used=0;
 
-    Binning tbins(m_readout_time / m_tick, m_start_time, m_start_time + m_readout_time);
-    ITrace::vector traces;
+    // Collect the (face, plane) tasks in the fixed serial order.
+    struct task_t {
+        IAnodeFace::pointer face;
+        int iplane;
+        std::shared_ptr<IDepo::vector> depos;
+        IRandom::pointer rng;
+        ITrace::vector traces;
+    };
+    std::vector<task_t> tasks;
     for (auto face : m_anode->faces()) {
         // Select the depos which are in this face's sensitive volume
-        IDepo::vector face_depos = Aux::sensitive(*depos, face);
-        ndepos_used += face_depos.size();
+        auto face_depos = std::make_shared<IDepo::vector>(Aux::sensitive(*depos, face));
+        ndepos_used += face_depos->size();
 
         int iplane = -1;
         for (auto plane : face->planes()) {
@@ -197,48 +286,43 @@ bool Gen::DepoTransform::operator()(const input_pointer& in, output_pointer& out
           log->debug("skip plane {}", plane_index);         
 	      continue;
 	    }
+            tasks.push_back({face, iplane, face_depos, m_rng, {}});
+        }
+    }
 
-            const Pimpos* pimpos = plane->pimpos();
-
-            Binning tbins(m_readout_time / m_tick, m_start_time, m_start_time + m_readout_time);
-
-            Gen::BinnedDiffusion_transform bindiff(*pimpos, tbins, m_nsigma, m_rng);
-            for (auto depo : face_depos) {
-                depo = modify_depo(plane->planeid(), depo);
-                bindiff.add(depo, depo->extent_long() / m_drift_speed, depo->extent_tran());
-            }
-
-            auto& wires = plane->wires();
-
-            auto pir = m_pirs.at(iplane);
-            Gen::ImpactTransform transform(pir, m_dft, bindiff);
-
-            const int nwires = pimpos->region_binning().nbins();
-            for (int iwire = 0; iwire < nwires; ++iwire) {
-                auto wave = transform.waveform(iwire);
-
-                auto mm = Waveform::edge(wave);
-                if (mm.first == (int) wave.size()) {  // all zero
-                    continue;
-                }
+    // Substreams are keyed by (stream, frame, anode, face, plane) and
+    // made serially so the result does not depend on the number of
+    // threads.
+    if (m_rng_substreams) {
+        for (auto& task : tasks) {
+            task.rng = Gen::make_substream(m_rng, {m_rng_stream, size_t(m_frame_count),
+                                                   size_t(m_anode->ident()), size_t(task.face->ident()),
+                                                   size_t(task.iplane)});
+        }
+    }
 
-                int chid = wires[iwire]->channel();
-                int tbin = mm.first;
+    Parallel::for_each(tasks.size(), m_nthreads, [&](size_t itask) {
+        auto& task = tasks[itask];
+        task.traces = transform_plane(task.face, task.iplane, *task.depos, task.rng);
+    });
 
-                ITrace::ChargeSequence charge(wave.begin() + mm.first, wave.begin() + mm.second);
-                auto trace = make_shared<SimpleTrace>(chid, tbin, charge);
-                traces.push_back(trace);
-            }
-            // fixme: use SPDLOG_LOGGER_DEBUG
-            log->debug("plane={} face={} depos={} total traces={}",
-                       iplane, face->ident(), face_depos.size(), traces.size());
-        }
+    ITrace::vector traces;
+    for (auto& task : tasks) {
+        traces.insert(traces.end(), task.traces.begin(), task.traces.end());
+        // fixme: use SPDLOG_LOGGER_DEBUG
+        log->debug("plane={} face={} depos={} total traces={}",
+                   task.iplane, task.face->ident(), task.depos->size(), traces.size());
     }
 
     auto frame = make_shared<SimpleFrame>(m_frame_count, m_start_time, traces, m_tick);
     log->debug("call={} count={} ndepos_in={} ndepos_used={}",
                m_count, m_frame_count, depos->size(), ndepos_used);
     log->debug("output: {}", Aux::taginfo(frame));
+    {
+        const auto st = ImpactResponseCache::instance().stats();
+        log->debug("response cache: hits={} misses={} MB={}",
+                   st.hits, st.misses, st.bytes / (1024.0 * 1024.0));
+    }
 
     ++m_frame_count;
     ++m_count;
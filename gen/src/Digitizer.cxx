@@ -1,8 +1,7 @@
 #include "WireCellGen/Digitizer.h"
 
 #include "WireCellIface/IWireSelectors.h"
-#include "WireCellAux/SimpleFrame.h"
-#include "WireCellAux/SimpleTrace.h"
+#include "WireCellAux/DenseFrame.h"
 
 #include "WireCellAux/FrameTools.h"
 
@@ -16,8 +15,8 @@ WIRECELL_FACTORY(Digitizer, WireCell::Gen::Digitizer,
 
 using namespace std;
 using namespace WireCell;
-using WireCell::Aux::SimpleTrace;
-using WireCell::Aux::SimpleFrame;
+using WireCell::Aux::DenseBlock;
+using WireCell::Aux::DenseFrame;
 
 Gen::Digitizer::Digitizer()
   : Aux::Logger("Digitizer", "gen")
@@ -128,10 +127,11 @@ bool Gen::Digitizer::operator()(const input_pointer& vframe, output_pointer& adc
     Array::array_xxf arr = Array::array_xxf::Zero(nrows, ncols);
     Aux::fill(arr, vtraces, channels.begin(), chend, tbinmm.first);
 
-    ITrace::vector adctraces(nrows);
-
-    double totadc = 0;
-
+    // The output is dense.  Its traces view rows of one block.
+    // Channels that do not resolve to a plane are dropped.
+    std::vector<int> adcchans;
+    std::vector<float> baselines;
+    std::vector<size_t> inrows;
     for (size_t irow = 0; irow < nrows; ++irow) {
         int ch = channels[irow];
         WirePlaneId wpid = m_anode->resolve(ch);
@@ -139,18 +139,26 @@ bool Gen::Digitizer::operator()(const input_pointer& vframe, output_pointer& adc
             log->warn("got invalid WPID for channel {}: {}, skipping", ch, wpid);
             continue;
         }
-        const float baseline = m_baselines[wpid.index()];
+        adcchans.push_back(ch);
+        baselines.push_back(m_baselines[wpid.index()]);
+        inrows.push_back(irow);
+    }
+    auto block = make_shared<DenseBlock>(adcchans, ncols, tbinmm.first);
+
+    double totadc = 0;
 
-        ITrace::ChargeSequence adcwave(ncols);
+    for (size_t orow = 0; orow < adcchans.size(); ++orow) {
+        const size_t irow = inrows[orow];
+        const float baseline = baselines[orow];
+        float* adcwave = block->row(orow);
         for (size_t icol = 0; icol < ncols; ++icol) {
             double voltage = m_gain * arr(irow, icol) + baseline;
             const float adcf = digitize(voltage);
             adcwave[icol] = adcf;
             totadc += adcf;
         }
-        adctraces[irow] = make_shared<SimpleTrace>(ch, tbinmm.first, adcwave);
     }
-    auto sframe = make_shared<SimpleFrame>(vframe->ident(), vframe->time(), adctraces, vframe->tick(), vframe->masks());
+    auto sframe = make_shared<DenseFrame>(vframe->ident(), vframe->time(), block, vframe->tick(), vframe->masks());
     if (!m_frame_tag.empty()) {
         sframe->tag_frame(m_frame_tag);
     }
@@ -158,7 +166,7 @@ bool Gen::Digitizer::operator()(const input_pointer& vframe, output_pointer& adc
 
     log->debug("call={} traces={} frame={} totadc={} outtag=\"{}\"",
                m_count,
-               adctraces.size(), vframe->ident(), totadc, m_frame_tag);
+               adcchans.size(), vframe->ident(), totadc, m_frame_tag);
 
     log->debug("input : {}", Aux::taginfo(vframe));
     log->debug("output: {}", Aux::taginfo(adcframe));
@@ -30,35 +30,37 @@ std::vector<double> Gen::GausDesc::sample(double start, double step, int nsample
 std::vector<double> Gen::GausDesc::binint(double start, double step, int nbins) const
 {
     std::vector<double> bins;
+    binint(start, step, nbins, bins);
+    return bins;
+}
 
+void Gen::GausDesc::binint(double start, double step, int nbins, std::vector<double>& bins) const
+{
     if (!sigma) {
-        bins.resize(1, 0);
-        bins[0] = 1;
+        bins.assign(1, 1.0);
         if (nbins != 1) {
             cerr << "NOT one bin for true point source: " << nbins << "\n";
         }
+        return;
     }
-    else {
-        bins.resize(nbins, 0.0);
-        std::vector<double> erfs(nbins + 1, 0.0);
-        const double sqrt2 = sqrt(2.0);
-        for (int ind = 0; ind <= nbins; ++ind) {
-            double x = (start + step * ind - center) / (sqrt2 * sigma);
-            erfs[ind] = 0.5 * std::erf(x);
-        }
 
-        for (int ibin = 0; ibin < nbins; ++ibin) {
-            const double val = erfs[ibin + 1] - erfs[ibin];
-            bins[ibin] = val;
-        }
+    // Each bin edge's erf is used by both neighbors so carry it over
+    // rather than keep them all.
+    bins.resize(nbins);
+    const double sqrt2 = sqrt(2.0);
+    double lo = 0.5 * std::erf((start - center) / (sqrt2 * sigma));
+    for (int ibin = 0; ibin < nbins; ++ibin) {
+        const double x = (start + step * (ibin + 1) - center) / (sqrt2 * sigma);
+        const double hi = 0.5 * std::erf(x);
+        bins[ibin] = hi - lo;
+        lo = hi;
     }
-    return bins;
 }
 
 // integral Normal distribution with weighting function
 // a linear weighting for the charge in each pbin
 // Integral of charge spectrum <pvec> done by GausDesc::binint (do not do it again using Erf())
-std::vector<double> Gen::GausDesc::weight(double start, double step, int nbins, std::vector<double> pvec) const
+std::vector<double> Gen::GausDesc::weight(double start, double step, int nbins, const std::vector<double>& pvec) const
 {
     std::vector<double> wt;
     if (!sigma) {
@@ -115,19 +117,25 @@ Gen::GaussianDiffusion::GaussianDiffusion(const IDepo::pointer& depo, const Gaus
 
 void Gen::GaussianDiffusion::set_sampling(const Binning& tbin,  // overall time tick binning
                                           const Binning& pbin,  // overall impact position binning
-                                          double nsigma, IRandom::pointer fluctuate, unsigned int weightstrat)
+                                          double nsigma, IRandom::pointer fluctuate, unsigned int weightstrat,
+                                          PatchArena* arena)
 {
-    if (m_patch.size() > 0) {
+    if (m_nrows * m_ncols > 0) {
         return;
     }
 
+    // Sample into the arena's scratch when given one.
+    std::vector<double> tvec_own, pvec_own;
+    auto& tvec = arena ? arena->tvec : tvec_own;
+    auto& pvec = arena ? arena->pvec : pvec_own;
+
     /// Sample time dimension
     auto tval_range = m_time_desc.sigma_range(nsigma);
     auto tbin_range = tbin.sample_bin_range(tval_range.first, tval_range.second);
     const size_t ntss = tbin_range.second - tbin_range.first;
     m_toffset_bin = tbin_range.first;
     // auto tvec =  m_time_desc.sample(tbin.center(m_toffset_bin), tbin.binsize(), ntss);
-    auto tvec = m_time_desc.binint(tbin.edge(m_toffset_bin), tbin.binsize(), ntss);
+    m_time_desc.binint(tbin.edge(m_toffset_bin), tbin.binsize(), ntss, tvec);
 
     if (!ntss) {
         cerr << "Gen::GaussianDiffusion: no time bins for [" << tval_range.first / units::us << ","
@@ -141,7 +149,7 @@ void Gen::GaussianDiffusion::set_sampling(const Binning& tbin,  // overall time
     const size_t npss = pbin_range.second - pbin_range.first;
     m_poffset_bin = pbin_range.first;
     // auto pvec = m_pitch_desc.sample(pbin.center(m_poffset_bin), pbin.binsize(), npss);
-    auto pvec = m_pitch_desc.binint(pbin.edge(m_poffset_bin), pbin.binsize(), npss);
+    m_pitch_desc.binint(pbin.edge(m_poffset_bin), pbin.binsize(), npss, pvec);
 
     if (!npss) {
         cerr << "No impact bins [" << pval_range.first / units::mm << "," << pval_range.second / units::mm << "] mm\n";
@@ -153,15 +161,26 @@ void Gen::GaussianDiffusion::set_sampling(const Binning& tbin,  // overall time
     // make charge weights for later interpolation.
     /// fixme: for hanyu.
     if (weightstrat == 2) {
-        auto wvec = m_pitch_desc.weight(pbin.edge(m_poffset_bin), pbin.binsize(), npss, pvec);
-        m_qweights = wvec;
+        m_qweights = m_pitch_desc.weight(pbin.edge(m_poffset_bin), pbin.binsize(), npss, pvec);
     }
     if (weightstrat == 1) {
         m_qweights.resize(npss, 0.5);
     }
 
-    // start making the time vs impact patch of charge.
-    patch_t ret = patch_t::Zero(npss, ntss);
+    // start making the time vs impact patch of charge.  The patch is
+    // column-major, (ip, it) is at ip + it * npss.
+    float* ret = nullptr;
+    if (arena) {
+        m_arena_offset = arena->allocate(npss * ntss);
+        ret = arena->data(m_arena_offset);
+        m_arena = arena;
+    }
+    else {
+        m_patch = patch_t::Zero(npss, ntss);
+        ret = m_patch.data();
+        m_arena = nullptr;
+    }
+    const size_t ncells = npss * ntss;
     double raw_sum = 0.0;
 
     // Convolve the two independent Gaussians
@@ -169,7 +188,7 @@ void Gen::GaussianDiffusion::set_sampling(const Binning& tbin,  // overall time
         for (size_t it = 0; it < ntss; ++it) {
             const double val = pvec[ip] * tvec[it];
             raw_sum += val;
-            ret(ip, it) = (float) val;
+            ret[ip + it * npss] = (float) val;
         }
     }
 
@@ -179,14 +198,17 @@ void Gen::GaussianDiffusion::set_sampling(const Binning& tbin,  // overall time
     const double charge_sign = depo_charge < 0 ? -1 : 1;
 
     // normalize to total charge
-    ret *= depo_charge / raw_sum;
+    const float norm = depo_charge / raw_sum;
+    for (size_t ind = 0; ind < ncells; ++ind) {
+        ret[ind] *= norm;
+    }
 
     double fluc_sum = 0;
     if (fluctuate) {
 
         for (size_t ip = 0; ip < npss; ++ip) {
             for (size_t it = 0; it < ntss; ++it) {
-                const double oldval = ret(ip, it);
+                const double oldval = ret[ip + it * npss];
                 // should be a multinomial distribution, n_i follows binomial distribution
                 // but n_i, n_j has covariance -n_tot * p_i * p_j
                 // normalize later to approximate this multinomial distribution (how precise?)
@@ -202,30 +224,25 @@ void Gen::GaussianDiffusion::set_sampling(const Binning& tbin,  // overall time
                 // the charge should be negative -- ionization electrons
                 number *= charge_sign;
                 fluc_sum += number;
-                ret(ip, it) = number;
+                ret[ip + it * npss] = number;
             }
         }
         if (fluc_sum == 0) {
+            // no patch, as if never sampled
+            m_patch.resize(0, 0);
+            m_arena = nullptr;
             return;
         }
         else {
-            ret *= m_deposition->charge() / fluc_sum;
+            const float fnorm = m_deposition->charge() / fluc_sum;
+            for (size_t ind = 0; ind < ncells; ++ind) {
+                ret[ind] *= fnorm;
+            }
         }
     }
 
-    {  // debugging
-       // double retsum=0.0;
-       // for (size_t ip = 0; ip < npss; ++ip) {
-       //    for (size_t it = 0; it < ntss; ++it) {
-       //        retsum += ret(ip,it);
-       //    }
-       //}
-       // cerr << "GaussianDiffusion: Q in electrons: depo=" << m_deposition->charge()/units::eplus
-       //      << " rawsum=" << raw_sum/units::eplus << " flucsum=" << fluc_sum/units::eplus
-       //      << " returned=" << retsum/units::eplus << endl;
-    }
-
-    m_patch = ret;
+    m_nrows = npss;
+    m_ncols = ntss;
 }
 
 void Gen::GaussianDiffusion::clear_sampling()
@@ -233,10 +250,26 @@ void Gen::GaussianDiffusion::clear_sampling()
     m_patch.resize(0, 0);
     m_qweights.clear();
     m_qweights.shrink_to_fit();
+    m_arena = nullptr;
+    m_nrows = m_ncols = 0;
 }
 
 // patch = nimpacts rows X nticks columns
 // patch(row,col)
-const Gen::GaussianDiffusion::patch_t& Gen::GaussianDiffusion::patch() const { return m_patch; }
+const Gen::GaussianDiffusion::patch_t& Gen::GaussianDiffusion::patch() const
+{
+    if (m_arena and m_patch.size() == 0) {
+        m_patch = patch_view();
+    }
+    return m_patch;
+}
+
+Gen::GaussianDiffusion::patch_view_t Gen::GaussianDiffusion::patch_view() const
+{
+    if (m_arena) {
+        return patch_view_t(m_arena->data(m_arena_offset), m_nrows, m_ncols);
+    }
+    return patch_view_t(m_patch.data(), m_patch.rows(), m_patch.cols());
+}
 
-const std::vector<double> Gen::GaussianDiffusion::weights() const { return m_qweights; }
+const std::vector<double>& Gen::GaussianDiffusion::weights() const { return m_qweights; }
@@ -31,7 +31,7 @@ void Gen::ImpactData::calculate(const IDFT::pointer& dft, int nticks) const
     m_weights.resize(nticks, 0.0);
 
     for (auto diff : m_diffusions) {
-        const auto patch = diff->patch();
+        const auto& patch = diff->patch();
         const auto qweight = diff->weights();
 
         const int poffset_bin = diff->poffset_bin();
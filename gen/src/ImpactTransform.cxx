@@ -6,6 +6,7 @@
 #include "WireCellUtil/FFTBestLength.h"
 #include "WireCellUtil/Exceptions.h"
 
+#include <algorithm>
 #include <iostream>  // debugging.
 using namespace std;
 
@@ -62,9 +63,6 @@ Gen::ImpactTransform::ImpactTransform(IPlaneImpactResponse::pointer pir,
                           << std::endl;                
                 continue;
             }
-                
-            Waveform::compseq_t response_spectrum = map_resp[j - m_num_pad_wire]->spectrum();
-
         }
 
         m_vec_map_resp.push_back(map_resp);
@@ -150,59 +148,8 @@ Gen::ImpactTransform::ImpactTransform(IPlaneImpactResponse::pointer pir,
         // Do FFT on wire
         c_data = fwd(m_dft, c_data);
 
-        // std::cout << i << std::endl;
-        {
-            Array::array_xxc resp_f_w =
-                Array::array_xxc::Zero(end_ch - start_ch + 2 * npad_wire, m_end_tick - m_start_tick);
-            {
-                Waveform::compseq_t rs1 = m_vec_map_resp.at(i)[0]->spectrum();
-                // do a inverse FFT
-                Waveform::realseq_t rs1_t = inv_c2r(m_dft, rs1);
-                // pick the first xxx ticks
-                Waveform::realseq_t rs1_reduced(m_end_tick - m_start_tick, 0);
-                for (int icol = 0; icol != m_end_tick - m_start_tick; icol++) {
-                    if (icol >= int(rs1_t.size())) break;
-                    rs1_reduced.at(icol) = rs1_t[icol];
-                }
-                // do a FFT
-                rs1 = fwd_r2c(m_dft, rs1_reduced);
-
-                for (int icol = 0; icol != m_end_tick - m_start_tick; icol++) {
-                    resp_f_w(0, icol) = rs1[icol];
-                }
-            }
-
-            for (int irow = 0; irow != m_num_pad_wire; irow++) {
-                Waveform::compseq_t rs1 = m_vec_map_resp.at(i)[irow + 1]->spectrum();
-                Waveform::realseq_t rs1_t = inv_c2r(m_dft, rs1);
-                Waveform::realseq_t rs1_reduced(m_end_tick - m_start_tick, 0);
-                for (int icol = 0; icol != m_end_tick - m_start_tick; icol++) {
-                    if (icol >= int(rs1_t.size())) break;
-                    rs1_reduced.at(icol) = rs1_t[icol];
-                }
-                rs1 = fwd_r2c(m_dft, rs1_reduced);
-                Waveform::compseq_t rs2 = m_vec_map_resp.at(i)[-irow - 1]->spectrum();
-                Waveform::realseq_t rs2_t = inv_c2r(m_dft, rs2);
-                Waveform::realseq_t rs2_reduced(m_end_tick - m_start_tick, 0);
-                for (int icol = 0; icol != m_end_tick - m_start_tick; icol++) {
-                    if (icol >= int(rs2_t.size())) break;
-                    rs2_reduced.at(icol) = rs2_t[icol];
-                }
-                rs2 = fwd_r2c(m_dft, rs2_reduced);
-                for (int icol = 0; icol != m_end_tick - m_start_tick; icol++) {
-                    resp_f_w(irow + 1, icol) = rs1[icol];
-                    resp_f_w(end_ch - start_ch - 1 - irow + 2 * npad_wire, icol) = rs2[icol];
-                }
-            }
-            // std::cout << i << std::endl;
-
-            // Do FFT on wire for response // slight larger
-            // Now becomes the f and f in both time and wire domain ...
-            resp_f_w = fwd(m_dft, resp_f_w, 0);
-
-            // multiply them together
-            c_data = c_data * resp_f_w;
-        }
+        // multiply with the cached response, already in f and f
+        c_data = c_data * *response(i, c_data.rows(), c_data.cols());
 
         // Do inverse FFT on wire
         c_data = inv(m_dft, c_data, 0);
@@ -239,59 +186,8 @@ Gen::ImpactTransform::ImpactTransform(IPlaneImpactResponse::pointer pir,
             data_f_w = fwd(m_dft, data_f_w, 0);
         }
 
-        {
-            Array::array_xxc resp_f_w =
-                Array::array_xxc::Zero(end_ch - start_ch + 2 * npad_wire, m_end_tick - m_start_tick);
-
-            {
-                Waveform::compseq_t rs1 = m_vec_map_resp.at(i)[0]->spectrum();
-
-                // do a inverse FFT
-                Waveform::realseq_t rs1_t = inv_c2r(m_dft, rs1);
-                // pick the first xxx ticks
-                Waveform::realseq_t rs1_reduced(m_end_tick - m_start_tick, 0);
-                // std::cout << rs1.size() << " " << nsamples << " " << m_end_tick << " " <<  m_start_tick << std::endl;
-                for (int icol = 0; icol != m_end_tick - m_start_tick; icol++) {
-                    if (icol >= int(rs1_t.size())) break;
-                    rs1_reduced.at(icol) = rs1_t[icol];
-                    //  std::cout << icol << " " << rs1_t[icol] << std::endl;
-                }
-                // do a FFT
-                rs1 = fwd_r2c(m_dft, rs1_reduced);
-
-                for (int icol = 0; icol != m_end_tick - m_start_tick; icol++) {
-                    //   std::cout << icol << " " << rs1[icol] << " " << temp_resp_f_w(0,icol) << std::endl;
-                    resp_f_w(0, icol) = rs1[icol];
-                }
-            }
-            for (int irow = 0; irow != m_num_pad_wire; irow++) {
-                Waveform::compseq_t rs1 = m_vec_map_resp.at(i)[irow + 1]->spectrum();
-                Waveform::realseq_t rs1_t = inv_c2r(m_dft, rs1);
-                Waveform::realseq_t rs1_reduced(m_end_tick - m_start_tick, 0);
-                for (int icol = 0; icol != m_end_tick - m_start_tick; icol++) {
-                    if (icol >= int(rs1_t.size())) break;
-                    rs1_reduced.at(icol) = rs1_t[icol];
-                }
-                rs1 = fwd_r2c(m_dft, rs1_reduced);
-                Waveform::compseq_t rs2 = m_vec_map_resp.at(i)[-irow - 1]->spectrum();
-                Waveform::realseq_t rs2_t = inv_c2r(m_dft, rs2);
-                Waveform::realseq_t rs2_reduced(m_end_tick - m_start_tick, 0);
-                for (int icol = 0; icol != m_end_tick - m_start_tick; icol++) {
-                    if (icol >= int(rs2_t.size())) break;
-                    rs2_reduced.at(icol) = rs2_t[icol];
-                }
-                rs2 = fwd_r2c(m_dft, rs2_reduced);
-                for (int icol = 0; icol != m_end_tick - m_start_tick; icol++) {
-                    resp_f_w(irow + 1, icol) = rs1[icol];
-                    resp_f_w(end_ch - start_ch - 1 - irow + 2 * npad_wire, icol) = rs2[icol];
-                }
-            }
-            // Do FFT on wire for response // slight larger
-            // Now becomes the f and f in both time and wire domain ...
-            resp_f_w = fwd(m_dft, resp_f_w, 0);
-            // multiply them together
-            data_f_w = data_f_w * resp_f_w;
-        }
+        // multiply them together
+        data_f_w = data_f_w * *response(i, data_f_w.rows(), data_f_w.cols());
 
         // Do inverse FFT on wire
         data_f_w = inv(m_dft, data_f_w, 0);
@@ -305,8 +201,151 @@ Gen::ImpactTransform::ImpactTransform(IPlaneImpactResponse::pointer pir,
     Array::array_xxf img_m_decon_data = acc_data_f_w.imag().colwise().reverse();
     m_decon_data = real_m_decon_data + img_m_decon_data;
 
+    // The long-range response spectrum is the same for every wire.
+    auto long_resp = m_pir->closest(0)->long_aux_waveform();
+    if (long_resp.size() > 0) {
+        const int nsamples = m_bd.tbins().nbins();
+        const size_t nlength = fft_best_length(nsamples + m_pir->closest(0)->long_aux_waveform_pad());
+        long_resp.resize(nlength, 0);
+        m_long_spec = fwd_r2c(m_dft, long_resp);
+    }
 }  // constructor
 
+// Build the wire and time frequency domain response for one impact
+// group over an array of nrows wires and ncols ticks.  Each wire
+// response is truncated to ncols ticks and wire offsets are wrapped.
+Array::array_xxc Gen::ImpactTransform::make_response(int igroup, int nrows, int ncols) const
+{
+    auto& map_resp = m_vec_map_resp.at(igroup);
+
+    // Inverse FFT, keep the first ncols ticks and FFT again.
+    auto reduced = [&](int irel) {
+        Waveform::realseq_t rs_t = inv_c2r(m_dft, map_resp.at(irel)->spectrum());
+        Waveform::realseq_t rs_reduced(ncols, 0);
+        const int ncopy = std::min(ncols, (int) rs_t.size());
+        std::copy(rs_t.begin(), rs_t.begin() + ncopy, rs_reduced.begin());
+        return fwd_r2c(m_dft, rs_reduced);
+    };
+
+    Array::array_xxc resp_f_w = Array::array_xxc::Zero(nrows, ncols);
+    {
+        auto rs1 = reduced(0);
+        for (int icol = 0; icol != ncols; icol++) {
+            resp_f_w(0, icol) = rs1[icol];
+        }
+    }
+    for (int irow = 0; irow != m_num_pad_wire; irow++) {
+        auto rs1 = reduced(irow + 1);
+        auto rs2 = reduced(-irow - 1);
+        for (int icol = 0; icol != ncols; icol++) {
+            resp_f_w(irow + 1, icol) = rs1[icol];
+            resp_f_w(nrows - 1 - irow, icol) = rs2[icol];
+        }
+    }
+    // Do FFT on wire for response
+    return fwd(m_dft, resp_f_w, 0);
+}
+
+Gen::ImpactResponseCache::array_ptr
+Gen::ImpactTransform::response(int igroup, int nrows, int ncols) const
+{
+    return ImpactResponseCache::instance().get(m_pir, igroup, nrows, ncols, [&]() {
+        return make_response(igroup, nrows, ncols);
+    });
+}
+
+Gen::ImpactResponseCache& Gen::ImpactResponseCache::instance()
+{
+    static ImpactResponseCache cache;
+    return cache;
+}
+
+void Gen::ImpactResponseCache::set_budget(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budget = bytes;
+    evict();
+}
+
+size_t Gen::ImpactResponseCache::budget() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budget;
+}
+
+Gen::ImpactResponseCache::Stats Gen::ImpactResponseCache::stats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void Gen::ImpactResponseCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_lru.clear();
+    m_stats.bytes = 0;
+}
+
+Gen::ImpactResponseCache::array_ptr
+Gen::ImpactResponseCache::get(const pir_ptr& pir, int igroup, int nrows, int ncols,
+                              std::function<Array::array_xxc()> make)
+{
+    const key_t key{pir.get(), igroup, nrows, ncols};
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        if (it != m_entries.end()) {
+            if (it->second.pir.lock() == pir) {
+                ++m_stats.hits;
+                m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+                return it->second.array;
+            }
+            // Left by a dead PIR at the same address.
+            erase(it);
+        }
+        ++m_stats.misses;
+    }
+
+    // Build outside the lock.  Concurrent misses on one key may
+    // build it twice, the first one stored wins.
+    auto arr = std::make_shared<const Array::array_xxc>(make());
+    const size_t nbytes = arr->size() * sizeof(Array::array_xxc::Scalar);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (nbytes > m_budget or !pir) {
+        return arr;
+    }
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        if (it->second.pir.lock() == pir) {
+            return it->second.array;
+        }
+        erase(it);
+    }
+    m_lru.push_front(key);
+    m_entries.emplace(key, entry_t{pir, arr, nbytes, m_lru.begin()});
+    m_stats.bytes += nbytes;
+    evict();
+    return arr;
+}
+
+// Lock held.
+void Gen::ImpactResponseCache::erase(entries_t::iterator it)
+{
+    m_stats.bytes -= it->second.nbytes;
+    m_lru.erase(it->second.lru);
+    m_entries.erase(it);
+}
+
+// Drop least recently used entries until within budget.  Lock held.
+void Gen::ImpactResponseCache::evict()
+{
+    while (m_stats.bytes > m_budget and !m_lru.empty()) {
+        erase(m_entries.find(m_lru.back()));
+    }
+}
+
 Gen::ImpactTransform::~ImpactTransform() {}
 
 Waveform::realseq_t Gen::ImpactTransform::waveform(int iwire) const
@@ -324,19 +363,14 @@ Waveform::realseq_t Gen::ImpactTransform::waveform(int iwire) const
             // std::cout << m_decon_data(iwire-m_start_ch,i-m_start_tick) << std::endl;
         }
 
-        if (m_pir->closest(0)->long_aux_waveform().size() > 0) {
+        if (m_long_spec.size() > 0) {
             // now convolute with the long-range response ...
-            const size_t nlength = fft_best_length(nsamples + m_pir->closest(0)->long_aux_waveform_pad());
-
-            //   std::cout << nlength << " " << nsamples + m_pir->closest(0)->long_aux_waveform_pad() << std::endl;
+            const size_t nlength = m_long_spec.size();
 
             wf.resize(nlength, 0);
-            Waveform::realseq_t long_resp = m_pir->closest(0)->long_aux_waveform();
-            long_resp.resize(nlength, 0);
             Waveform::compseq_t spec = fwd_r2c(m_dft, wf);
-            Waveform::compseq_t long_spec = fwd_r2c(m_dft, long_resp);
             for (size_t i = 0; i != nlength; i++) {
-                spec.at(i) *= long_spec.at(i);
+                spec.at(i) *= m_long_spec.at(i);
             }
             wf = inv_c2r(m_dft, spec);
             wf.resize(nsamples, 0);
@@ -13,8 +13,11 @@
 
 #include "WireCellUtil/NamedFactory.h"
 #include "WireCellUtil/Logging.h"
+#include "WireCellUtil/Philox.h"
 
+#include <limits>
 #include <random>
+#include <type_traits>
 
 WIRECELL_FACTORY(Random, WireCell::Gen::Random, WireCell::IRandom, WireCell::IConfigurable)
 
@@ -28,6 +31,8 @@ Gen::Random::Random(const std::string& generator, const std::vector<unsigned int
 {
 }
 
+Gen::Random::~Random() { delete m_pimpl; }
+
 template<typename Number, typename URNG, typename Distro>
 struct Closure {
     URNG& rng;
@@ -51,6 +56,7 @@ class RandomT : public IRandom {
         std::seed_seq seed(seeds.begin(), seeds.end());
         m_rng.seed(seed);
     }
+    RandomT(const URNG& rng) : m_rng(rng) {}
 
     virtual int binomial(int max, double prob)
     {
@@ -111,6 +117,40 @@ class RandomT : public IRandom {
     {
         return Closure<int, URNG, std::uniform_int_distribution<int>>(m_rng, first, last);
     }
+
+    // Bulk fills avoid a virtual call and distribution construction
+    // per sample.  The counter-based engine has its own kernels.
+    virtual void fill_normal(float* out, size_t n, double mean, double sigma)
+    {
+        if constexpr (std::is_same_v<URNG, Philox4x32>) {
+            m_rng.fill_normal(out, n, mean, sigma);
+        }
+        else {
+            std::normal_distribution<double> distribution(mean, sigma);
+            for (size_t ind = 0; ind < n; ++ind) {
+                out[ind] = distribution(m_rng);
+            }
+        }
+    }
+    virtual void fill_uniform(float* out, size_t n, double begin, double end)
+    {
+        if constexpr (std::is_same_v<URNG, Philox4x32>) {
+            m_rng.fill_uniform(out, n, begin, end);
+        }
+        else {
+            std::uniform_real_distribution<double> distribution(begin, end);
+            for (size_t ind = 0; ind < n; ++ind) {
+                out[ind] = distribution(m_rng);
+            }
+        }
+    }
+    virtual void fill_poisson(int* out, size_t n, double mean)
+    {
+        std::poisson_distribution<int> distribution(mean);
+        for (size_t ind = 0; ind < n; ++ind) {
+            out[ind] = distribution(m_rng);
+        }
+    }
 };
 
 void Gen::Random::configure(const WireCell::Configuration& cfg)
@@ -133,6 +173,9 @@ void Gen::Random::configure(const WireCell::Configuration& cfg)
     else if (gen == "twister") {
         m_pimpl = new RandomT<std::mt19937>(m_seeds);
     }
+    else if (gen == "philox") {
+        m_pimpl = new RandomT<Philox4x32>(m_seeds);
+    }
     else if (gen == "") {
         m_pimpl = new RandomT<std::mt19937>(m_seeds);
     }
@@ -168,3 +211,48 @@ IRandom::double_func Gen::Random::make_normal(double mean, double sigma) { retur
 IRandom::double_func Gen::Random::make_uniform(double begin, double end) { return m_pimpl->make_uniform(begin, end); }
 IRandom::double_func Gen::Random::make_exponential(double mean) { return m_pimpl->make_exponential(mean); }
 IRandom::int_func Gen::Random::make_range(int first, int last) { return m_pimpl->make_range(first, last); }
+
+void Gen::Random::fill_normal(float* out, size_t n, double mean, double sigma)
+{
+    m_pimpl->fill_normal(out, n, mean, sigma);
+}
+void Gen::Random::fill_uniform(float* out, size_t n, double begin, double end)
+{
+    m_pimpl->fill_uniform(out, n, begin, end);
+}
+void Gen::Random::fill_poisson(int* out, size_t n, double mean) { m_pimpl->fill_poisson(out, n, mean); }
+
+// Substreams always use the counter-based engine.  Its key is derived
+// from our seeds and its stream number from our own stream keys (if
+// we are a substream) followed by the given ones.
+IRandom::pointer Gen::Random::substream(const std::vector<size_t>& keys) const
+{
+    std::seed_seq seq(m_seeds.begin(), m_seeds.end());
+    std::array<uint32_t, 2> words;
+    seq.generate(words.begin(), words.end());
+    const uint64_t key = uint64_t(words[1]) << 32 | words[0];
+
+    auto rng = std::make_shared<Gen::Random>("philox", m_seeds);
+    rng->m_stream = m_stream;
+    rng->m_stream.insert(rng->m_stream.end(), keys.begin(), keys.end());
+    rng->m_pimpl = new RandomT<Philox4x32>(Philox4x32(key, philox_stream(rng->m_stream)));
+    return rng;
+}
+
+IRandom::pointer Gen::make_substream(IRandom::pointer parent, const std::vector<size_t>& keys)
+{
+    if (!parent) {
+        return nullptr;
+    }
+    auto sub = parent->substream(keys);
+    if (sub) {
+        return sub;
+    }
+    std::vector<unsigned int> seeds;
+    for (int ind = 0; ind < 4; ++ind) {
+        seeds.push_back(parent->range(0, std::numeric_limits<int>::max()));
+    }
+    auto rng = std::make_shared<Gen::Random>("twister", seeds);
+    rng->configure(rng->default_configuration());
+    return rng;
+}
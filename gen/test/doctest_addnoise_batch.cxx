@@ -0,0 +1,153 @@
+// IncoherentAddNoise batched mode must reproduce the per-trace mode.
+#include "WireCellGen/AddNoise.h"
+
+#include "WireCellAux/SimpleFrame.h"
+#include "WireCellAux/SimpleTrace.h"
+#include "WireCellIface/IChannelSpectrum.h"
+#include "WireCellIface/IDFT.h"
+#include "WireCellUtil/NamedFactory.h"
+#include "WireCellUtil/PluginManager.h"
+#include "WireCellUtil/doctest.h"
+
+#include <cmath>
+#include <map>
+
+using namespace WireCell;
+
+// Channels share one of five spectra of nsamples, each held in its
+// own buffer as the real models do.
+class FakeChannelSpectrum : public IChannelSpectrum {
+  public:
+    FakeChannelSpectrum(size_t nsamples = 64)
+      : m_nsamples(nsamples)
+    {
+    }
+    virtual ~FakeChannelSpectrum() {}
+    virtual const amplitude_t& channel_spectrum(int chid) const
+    {
+        const int kind = chid % 5;
+        auto& spec = m_specs[kind];
+        if (spec.empty()) {
+            spec.resize(m_nsamples);
+            for (size_t ind = 0; ind < m_nsamples; ++ind) {
+                const size_t freq = std::min(ind, m_nsamples - ind);
+                spec[ind] = (1 + kind) * std::exp(-0.1 * freq);
+            }
+        }
+        return spec;
+    }
+
+  private:
+    size_t m_nsamples;
+    mutable std::map<int, amplitude_t> m_specs;
+};
+
+// A model with a spectrum size other than nsamples.
+class OddChannelSpectrum : public FakeChannelSpectrum {
+  public:
+    OddChannelSpectrum()
+      : FakeChannelSpectrum(50)
+    {
+    }
+};
+
+static void setup()
+{
+    static bool done = false;
+    if (done) {
+        return;
+    }
+    done = true;
+    PluginManager& pm = PluginManager::instance();
+    REQUIRE(pm.add("WireCellAux") != nullptr);
+    REQUIRE(pm.add("WireCellGen") != nullptr);
+    make_named_factory_factory<FakeChannelSpectrum, IChannelSpectrum>("FakeChannelSpectrum");
+    make_named_factory_factory<OddChannelSpectrum, IChannelSpectrum>("OddChannelSpectrum");
+    // The noise base finds but does not create these.
+    Factory::lookup_tn<IDFT>("FftwDFT");
+    Factory::lookup_tn<IChannelSpectrum>("FakeChannelSpectrum");
+    Factory::lookup_tn<IChannelSpectrum>("OddChannelSpectrum");
+}
+
+static IFrame::pointer make_frame()
+{
+    ITrace::vector traces;
+    for (int chid = 0; chid < 23; ++chid) {
+        // One short trace.
+        const size_t ncharge = chid == 7 ? 40 : 64;
+        traces.push_back(std::make_shared<Aux::SimpleTrace>(chid, 0, ITrace::ChargeSequence(ncharge, chid)));
+    }
+    return std::make_shared<Aux::SimpleFrame>(0, 0, traces, 0.5 * units::us);
+}
+
+// Add noise from a freshly seeded Random of the given name.
+static IFrame::pointer add_noise(const std::string& rng_name, const Configuration& models, int nbatch,
+                                 int nthreads)
+{
+    auto rng = Factory::lookup<IConfigurable>("Random", rng_name);
+    rng->configure(rng->default_configuration());
+
+    Gen::IncoherentAddNoise addnoise;
+    auto cfg = addnoise.default_configuration();
+    cfg["rng"] = "Random:" + rng_name;
+    cfg["model"] = models;
+    cfg["nsamples"] = 64;
+    cfg["nbatch"] = nbatch;
+    cfg["nthreads"] = nthreads;
+    addnoise.configure(cfg);
+
+    IFrame::pointer out;
+    REQUIRE(addnoise(make_frame(), out));
+    REQUIRE(out);
+    return out;
+}
+
+static void require_same(const IFrame::pointer& a, const IFrame::pointer& b)
+{
+    const auto& atr = *a->traces();
+    const auto& btr = *b->traces();
+    REQUIRE(atr.size() == btr.size());
+    for (size_t itr = 0; itr < atr.size(); ++itr) {
+        REQUIRE(atr[itr]->channel() == btr[itr]->channel());
+        const auto& aq = atr[itr]->charge();
+        const auto& bq = btr[itr]->charge();
+        REQUIRE(aq.size() == bq.size());
+        for (size_t ind = 0; ind < aq.size(); ++ind) {
+            REQUIRE(std::abs(aq[ind] - bq[ind]) < 1e-4);
+        }
+    }
+}
+
+TEST_CASE("gen incoherent add noise batched equals unbatched")
+{
+    setup();
+
+    Configuration models = Json::arrayValue;
+    models.append("FakeChannelSpectrum");
+    models.append("OddChannelSpectrum");
+
+    auto each = add_noise("each", models, 0, 1);
+
+    // Noise was added with each channel's own spectrum: channel 4
+    // has five times the amplitude of channel 5.
+    auto rms = [&](int chid) {
+        double sum = 0;
+        for (float q : (*each->traces())[chid]->charge()) {
+            sum += (q - chid) * (q - chid);
+        }
+        return std::sqrt(sum);
+    };
+    CHECK(rms(5) > 0);
+    CHECK(rms(4) > 2 * rms(5));
+
+    // Blocks that do and do not divide the number of traces, and
+    // more than one thread.
+    for (int nbatch : {1, 5, 64}) {
+        for (int nthreads : {1, 3}) {
+            CAPTURE(nbatch);
+            CAPTURE(nthreads);
+            const std::string name = "batch" + std::to_string(nbatch) + "x" + std::to_string(nthreads);
+            require_same(each, add_noise(name, models, nbatch, nthreads));
+        }
+    }
+}
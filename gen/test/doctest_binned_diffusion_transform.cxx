@@ -0,0 +1,160 @@
+// BinnedDiffusion_transform::get_charge_vec() gives what the original
+// std::map lookups gave.
+#include "WireCellGen/BinnedDiffusion_transform.h"
+#include "WireCellGen/GaussianDiffusion.h"
+
+#include "WireCellAux/SimpleDepo.h"
+#include "WireCellUtil/Pimpos.h"
+#include "WireCellUtil/Units.h"
+#include "WireCellUtil/doctest.h"
+
+#include <map>
+#include <random>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+using namespace WireCell;
+using namespace WireCell::Gen;
+
+using charge_vec_t = std::vector<std::vector<std::tuple<int, int, double> > >;
+
+// The get_charge_vec() body before dense lookups, with the diffusions
+// given explicitly.
+static void old_charge_vec(const Pimpos& pimpos, const Binning& tbins, double nsigma,
+                           const std::vector<std::shared_ptr<GaussianDiffusion> >& diffs,
+                           charge_vec_t& vec_vec_charge, std::vector<int>& vec_impact)
+{
+    const auto ib = pimpos.impact_binning();
+
+    std::map<int, int> map_redimp_vec;
+    std::vector<std::unordered_map<long int, int> > vec_map_pair_pos;
+    for (size_t i = 0; i != vec_impact.size(); i++) {
+        map_redimp_vec[vec_impact[i]] = int(i);
+        std::unordered_map<long int, int> map_pair_pos;
+        vec_map_pair_pos.push_back(map_pair_pos);
+    }
+
+    const auto rb = pimpos.region_binning();
+    std::map<int, int> map_imp_ch;
+    std::map<int, int> map_imp_redimp;
+    for (int wireind = 0; wireind != rb.nbins(); wireind++) {
+        int wire_imp_no = pimpos.wire_impact(wireind);
+        std::pair<int, int> imps_range = pimpos.wire_impacts(wireind);
+        for (int imp_no = imps_range.first; imp_no != imps_range.second; imp_no++) {
+            map_imp_ch[imp_no] = wireind;
+            map_imp_redimp[imp_no] = imp_no - wire_imp_no;
+        }
+    }
+
+    int min_imp = 0;
+    int max_imp = ib.nbins();
+    int counter = 0;
+
+    for (auto diff : diffs) {
+        diff->set_sampling(tbins, ib, nsigma, nullptr, BinnedDiffusion_transform::linear);
+        counter++;
+
+        const auto patch = diff->patch();
+        const auto qweight = diff->weights();
+        const int poffset_bin = diff->poffset_bin();
+        const int toffset_bin = diff->toffset_bin();
+        const int np = patch.rows();
+        const int nt = patch.cols();
+
+        for (int pbin = 0; pbin != np; pbin++) {
+            int abs_pbin = pbin + poffset_bin;
+            if (abs_pbin < min_imp || abs_pbin >= max_imp) continue;
+            double weight = qweight[pbin];
+            auto const channel = map_imp_ch[abs_pbin];
+            auto const redimp = map_imp_redimp[abs_pbin];
+            auto const array_num_redimp = map_redimp_vec[redimp];
+            auto const next_array_num_redimp = map_redimp_vec[redimp + 1];
+
+            auto& map_pair_pos = vec_map_pair_pos.at(array_num_redimp);
+            auto& next_map_pair_pos = vec_map_pair_pos.at(next_array_num_redimp);
+
+            auto& vec_charge = vec_vec_charge.at(array_num_redimp);
+            auto& next_vec_charge = vec_vec_charge.at(next_array_num_redimp);
+
+            for (int tbin = 0; tbin != nt; tbin++) {
+                int abs_tbin = tbin + toffset_bin;
+                double charge = patch(pbin, tbin);
+
+                long int index1 = channel * 100000 + abs_tbin;
+                auto it = map_pair_pos.find(index1);
+                if (it == map_pair_pos.end()) {
+                    map_pair_pos[index1] = vec_charge.size();
+                    vec_charge.emplace_back(channel, abs_tbin, charge * weight);
+                }
+                else {
+                    std::get<2>(vec_charge.at(it->second)) += charge * weight;
+                }
+
+                auto it1 = next_map_pair_pos.find(index1);
+                if (it1 == next_map_pair_pos.end()) {
+                    next_map_pair_pos[index1] = next_vec_charge.size();
+                    next_vec_charge.emplace_back(channel, abs_tbin, charge * (1 - weight));
+                }
+                else {
+                    std::get<2>(next_vec_charge.at(it1->second)) += charge * (1 - weight);
+                }
+            }
+        }
+
+        if (counter % 5000 == 0) {
+            for (auto it = vec_map_pair_pos.begin(); it != vec_map_pair_pos.end(); it++) {
+                it->clear();
+            }
+        }
+
+        diff->clear_sampling();
+    }
+}
+
+TEST_CASE("gen binned diffusion transform charge vec")
+{
+    const double pitch = 5 * units::mm;
+    const int nwires = 20;
+    const Pimpos pimpos(nwires, -0.5 * (nwires - 1) * pitch, 0.5 * (nwires - 1) * pitch);
+    const Binning tbins(400, 0, 200 * units::us);
+    const double nsigma = 3.0;
+
+    // As ImpactTransform makes them for 10 impacts per wire.
+    std::vector<int> vec_impact;
+    for (int ind = 0; ind <= 10; ++ind) {
+        vec_impact.push_back(ind - 5);
+    }
+
+    // Enough depos to pass a periodic reset of the position maps,
+    // some of which spill over the ends of the plane.
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> zpos(-0.6 * nwires * pitch, 0.6 * nwires * pitch);
+    std::uniform_real_distribution<double> time(10 * units::us, 190 * units::us);
+    BinnedDiffusion_transform bdt(pimpos, tbins, nsigma);
+    std::vector<std::shared_ptr<GaussianDiffusion> > diffs;
+    for (int ind = 0; ind < 6000; ++ind) {
+        const double t = time(gen);
+        const Point pos(0, 0, zpos(gen));
+        const double sigma_time = (0.5 + 0.0002 * ind) * units::us;
+        const double sigma_pitch = (0.3 + 0.0003 * ind) * units::mm;
+        auto depo = std::make_shared<Aux::SimpleDepo>(t, pos, -1000);
+        if (!bdt.add(depo, sigma_time, sigma_pitch)) {
+            continue;
+        }
+        diffs.push_back(std::make_shared<GaussianDiffusion>(depo, GausDesc(t, sigma_time),
+                                                            GausDesc(pimpos.distance(pos), sigma_pitch)));
+    }
+    REQUIRE(diffs.size() > 5000);
+
+    charge_vec_t got(vec_impact.size()), want(vec_impact.size());
+    bdt.get_charge_vec(got, vec_impact);
+    old_charge_vec(pimpos, tbins, nsigma, diffs, want, vec_impact);
+
+    REQUIRE(got.size() == want.size());
+    for (size_t ind = 0; ind < got.size(); ++ind) {
+        CAPTURE(ind);
+        CHECK(!want[ind].empty());
+        CHECK(got[ind] == want[ind]);
+    }
+}
@@ -0,0 +1,86 @@
+// Substreams of components sharing one IRandom on one anode, and
+// their independence of the number of threads.
+#include "WireCellGen/DepoSplat.h"
+
+#include "WireCellAux/SimpleDepo.h"
+#include "WireCellAux/Testing.h"
+#include "WireCellIface/IAnodePlane.h"
+#include "WireCellIface/IFrame.h"
+#include "WireCellUtil/NamedFactory.h"
+#include "WireCellUtil/PluginManager.h"
+#include "WireCellUtil/Units.h"
+#include "WireCellUtil/doctest.h"
+
+#include <map>
+
+using namespace WireCell;
+
+static void setup()
+{
+    PluginManager& pm = PluginManager::instance();
+    REQUIRE(pm.add("WireCellGen") != nullptr);
+    auto rng = Factory::lookup<IConfigurable>("Random");
+    rng->configure(rng->default_configuration());
+    Testing::fake_anode();
+}
+
+// Return channel waveforms splatted by a DepoSplat of the given name.
+static std::map<int, std::vector<float>> splat(const std::string& name, int rng_stream = -1, int nthreads = 1)
+{
+    auto ds = std::make_shared<Gen::DepoSplat>();
+    ds->set_name(name);
+    auto cfg = ds->default_configuration();
+    cfg["anode"] = "FakeAnode";
+    cfg["fluctuate"] = true;
+    cfg["rng_substreams"] = true;
+    cfg["rng_stream"] = rng_stream;
+    cfg["nthreads"] = nthreads;
+    cfg["readout_time"] = 100 * units::us;
+    ds->configure(cfg);
+
+    IDuctor::output_queue frames;
+    for (int ind = 0; ind < 10; ++ind) {
+        const Point pos(10 * units::cm, 0, (-40 + 8 * ind) * units::mm);
+        auto depo = std::make_shared<Aux::SimpleDepo>(20 * units::us + ind * units::us, pos, 5000, nullptr,
+                                                      1 * units::mm, 1 * units::mm);
+        (*ds)(depo, frames);
+    }
+    (*ds)(nullptr, frames);
+    REQUIRE(frames.size() == 2);
+    REQUIRE(frames[0]);
+
+    std::map<int, std::vector<float>> ret;
+    for (const auto& trace : *frames[0]->traces()) {
+        ret[trace->channel()] = trace->charge();
+    }
+    REQUIRE(!ret.empty());
+    return ret;
+}
+
+TEST_CASE("depo splat rng streams")
+{
+    setup();
+
+    const auto a1 = splat("a");
+    const auto a2 = splat("a");
+    const auto b = splat("b");
+
+    // Same name gives the same fluctuations, another name others.
+    CHECK(a1 == a2);
+    CHECK(a1 != b);
+
+    // An explicit stream overrides the name.
+    CHECK(splat("c", 42) == splat("d", 42));
+    CHECK(splat("c", 42) != splat("c", 43));
+}
+
+TEST_CASE("depo splat nthreads")
+{
+    setup();
+
+    // Planes on several threads give the same fluctuations as one.
+    const auto one = splat("t");
+    CHECK(splat("t", -1, 2) == one);
+    CHECK(splat("t", -1, 3) == one);
+    CHECK(splat("t", -1, 8) == one);
+}
@@ -0,0 +1,131 @@
+// DepoTransform output does not depend on the number of threads.
+#include "WireCellGen/DepoTransform.h"
+#include "WireCellGen/PlaneImpactResponse.h"
+
+#include "WireCellAux/DftTools.h"
+#include "WireCellAux/SimpleDepo.h"
+#include "WireCellAux/SimpleDepoSet.h"
+#include "WireCellAux/Testing.h"
+#include "WireCellIface/IAnodePlane.h"
+#include "WireCellIface/IConfigurable.h"
+#include "WireCellIface/IDFT.h"
+#include "WireCellIface/IFrame.h"
+#include "WireCellUtil/NamedFactory.h"
+#include "WireCellUtil/PluginManager.h"
+#include "WireCellUtil/Units.h"
+#include "WireCellUtil/doctest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+using namespace WireCell;
+
+static const double wire_pitch = 5 * units::mm;
+static const double impact_pitch = 0.5 * units::mm;
+static const int nticks = 200;
+
+// Responses over three wires which differ by wire and impact.  All
+// are made up front as planes are transformed concurrently.
+class FakePIR : public IPlaneImpactResponse {
+  public:
+    FakePIR()
+    {
+        auto dft = Factory::find_tn<IDFT>("FftwDFT");
+        for (int relwire = -1; relwire <= 1; ++relwire) {
+            for (int imp = -5; imp <= 5; ++imp) {
+                Waveform::realseq_t wf(nticks, 0);
+                for (int ind = 5; ind < 15; ++ind) {
+                    wf[ind] = (1 + 0.01 * imp) * (ind - 4) / (1.0 + std::abs(relwire));
+                }
+                auto spec = Aux::DftTools::fwd_r2c(dft, wf);
+                m_irs[{relwire, imp}] = std::make_shared<Gen::ImpactResponse>(imp, spec, wf, 20,
+                                                                              Waveform::realseq_t(), 0);
+            }
+        }
+    }
+    virtual ~FakePIR() {}
+    virtual IImpactResponse::pointer closest(double relpitch) const
+    {
+        const int relwire = std::round(relpitch / wire_pitch);
+        const int imp = std::round((relpitch - relwire * wire_pitch) / impact_pitch);
+        return m_irs.at({std::clamp(relwire, -1, 1), std::clamp(imp, -5, 5)});
+    }
+    virtual TwoImpactResponses bounded(double relpitch) const
+    {
+        return TwoImpactResponses(closest(relpitch - 0.5 * impact_pitch), closest(relpitch + 0.5 * impact_pitch));
+    }
+    virtual double pitch_range() const { return 3 * wire_pitch; }
+    virtual int nwires() const { return 3; }
+    virtual double pitch() const { return wire_pitch; }
+    virtual double impact() const { return impact_pitch; }
+    virtual size_t nbins() const { return nticks; }
+
+  private:
+    std::map<std::pair<int, int>, IImpactResponse::pointer> m_irs;
+};
+
+static void setup()
+{
+    PluginManager& pm = PluginManager::instance();
+    REQUIRE(pm.add("WireCellAux") != nullptr);
+    REQUIRE(pm.add("WireCellGen") != nullptr);
+    // Components are found, not made, by DepoTransform.
+    Testing::get_dft();
+    auto rng = Factory::lookup<IConfigurable>("Random");
+    rng->configure(rng->default_configuration());
+    Testing::fake_anode(20, wire_pitch);
+    make_named_factory_factory<FakePIR, IPlaneImpactResponse>("FakePIR");
+    for (const char* name : {"u", "v", "w"}) {
+        Factory::lookup<IPlaneImpactResponse>("FakePIR", name);
+    }
+}
+
+// Return channel waveforms of one frame made with nthreads.
+static std::map<int, std::vector<float>> transform(int nthreads)
+{
+    auto dt = std::make_shared<Gen::DepoTransform>();
+    auto cfg = dt->default_configuration();
+    cfg["anode"] = "FakeAnode";
+    cfg["fluctuate"] = true;
+    cfg["rng"] = "Random";
+    cfg["rng_substreams"] = true;
+    cfg["readout_time"] = nticks * 0.5 * units::us;
+    cfg["nthreads"] = nthreads;
+    for (const char* name : {"u", "v", "w"}) {
+        cfg["pirs"].append(std::string("FakePIR:") + name);
+    }
+    dt->configure(cfg);
+
+    IDepo::vector depos;
+    for (int ind = 0; ind < 10; ++ind) {
+        const Point pos(10 * units::cm, 0, (-40 + 8 * ind) * units::mm);
+        depos.push_back(std::make_shared<Aux::SimpleDepo>(20 * units::us + ind * units::us, pos, 5000, nullptr,
+                                                          1 * units::mm, 1 * units::mm));
+    }
+    IFrame::pointer frame;
+    REQUIRE((*dt)(std::make_shared<Aux::SimpleDepoSet>(0, depos), frame));
+    REQUIRE(frame);
+
+    std::map<int, std::vector<float>> ret;
+    for (const auto& trace : *frame->traces()) {
+        ret[trace->channel()] = trace->charge();
+    }
+    return ret;
+}
+
+TEST_CASE("depo transform nthreads")
+{
+    setup();
+
+    const auto one = transform(1);
+
+    // Traces from all three planes.
+    REQUIRE(!one.empty());
+    CHECK(one.begin()->first < 100);
+    CHECK(one.rbegin()->first >= 200);
+
+    CHECK(transform(2) == one);
+    CHECK(transform(3) == one);
+    CHECK(transform(8) == one);
+}
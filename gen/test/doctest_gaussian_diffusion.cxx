@@ -0,0 +1,83 @@
+#include "WireCellGen/GaussianDiffusion.h"
+#include "WireCellGen/Random.h"
+
+#include "WireCellAux/SimpleDepo.h"
+#include "WireCellUtil/Units.h"
+#include "WireCellUtil/doctest.h"
+
+#include <memory>
+#include <vector>
+
+using namespace WireCell;
+using namespace WireCell::Gen;
+
+static std::vector<GaussianDiffusion::pointer> make_diffs(size_t ndiffs)
+{
+    std::vector<GaussianDiffusion::pointer> diffs;
+    for (size_t ind = 0; ind < ndiffs; ++ind) {
+        const double t = (100 + 7 * ind) * units::us;
+        const double p = (10 + 0.3 * ind) * units::mm;
+        auto depo = std::make_shared<Aux::SimpleDepo>(t, Point(0, 0, p), -5000);
+        diffs.push_back(std::make_shared<GaussianDiffusion>(depo, GausDesc(t, 1.5 * units::us),
+                                                            GausDesc(p, 1.2 * units::mm)));
+    }
+    return diffs;
+}
+
+static IRandom::pointer make_rng()
+{
+    auto rng = std::make_shared<Gen::Random>("twister", std::vector<unsigned int>{1, 2, 3});
+    rng->configure(rng->default_configuration());
+    return rng;
+}
+
+TEST_CASE("gen gaussian diffusion binint")
+{
+    GausDesc gd(1.0, 2.0);
+    auto bins = gd.binint(-10, 0.5, 40);
+    double tot = 0;
+    for (double b : bins) {
+        CHECK(b >= 0);
+        tot += b;
+    }
+    CHECK(tot == doctest::Approx(1.0).epsilon(1e-5));
+
+    std::vector<double> reused(100, -1);
+    gd.binint(-10, 0.5, 40, reused);
+    CHECK(reused == bins);
+}
+
+TEST_CASE("gen gaussian diffusion arena")
+{
+    const Binning tbins(1000, 0, 500 * units::us);
+    const Binning pbins(1000, 0, 100 * units::mm);
+    const double nsigma = 3.0;
+
+    for (bool fluctuate : {false, true}) {
+        auto rng1 = fluctuate ? make_rng() : nullptr;
+        auto rng2 = fluctuate ? make_rng() : nullptr;
+        auto owned = make_diffs(20);
+        auto viewed = make_diffs(20);
+
+        PatchArena arena;
+        for (auto& gd : viewed) {
+            gd->set_sampling(tbins, pbins, nsigma, rng2, 1, &arena);
+        }
+        CHECK(arena.size() > 0);
+
+        for (size_t ind = 0; ind < owned.size(); ++ind) {
+            owned[ind]->set_sampling(tbins, pbins, nsigma, rng1, 1);
+            const auto& want = owned[ind]->patch();
+            const auto got = viewed[ind]->patch_view();
+            REQUIRE(want.rows() == got.rows());
+            REQUIRE(want.cols() == got.cols());
+            CHECK((want == got).all());
+            CHECK(viewed[ind]->toffset_bin() == owned[ind]->toffset_bin());
+            CHECK(viewed[ind]->poffset_bin() == owned[ind]->poffset_bin());
+            CHECK(want.sum() == doctest::Approx(-5000).epsilon(1e-4));
+
+            // copying accessor still works for arena patches
+            CHECK((viewed[ind]->patch() == want).all());
+        }
+    }
+}
@@ -0,0 +1,115 @@
+#include "WireCellGen/ImpactTransform.h"
+#include "WireCellUtil/doctest.h"
+
+#include <new>
+
+using namespace WireCell;
+using namespace WireCell::Gen;
+
+// The cache only needs PIR identity.
+class FakePIR : public IPlaneImpactResponse {
+  public:
+    virtual ~FakePIR() {}
+    virtual IImpactResponse::pointer closest(double relpitch) const { return nullptr; }
+    virtual TwoImpactResponses bounded(double relpitch) const { return TwoImpactResponses(); }
+    virtual double pitch_range() const { return 0; }
+    virtual int nwires() const { return 0; }
+    virtual double pitch() const { return 0; }
+    virtual double impact() const { return 0; }
+    virtual size_t nbins() const { return 0; }
+};
+
+TEST_CASE("gen impact response cache")
+{
+    ImpactResponseCache& cache = ImpactResponseCache::instance();
+    cache.clear();
+    const size_t old_budget = cache.budget();
+
+    const size_t nbytes = 4 * 8 * sizeof(Array::array_xxc::Scalar);
+    cache.set_budget(2 * nbytes);
+
+    int nmade = 0;
+    auto make = [&]() {
+        ++nmade;
+        return Array::array_xxc::Constant(4, 8, nmade);
+    };
+
+    auto pir = std::make_shared<FakePIR>();
+
+    auto a0 = cache.get(pir, 0, 4, 8, make);
+    auto a0b = cache.get(pir, 0, 4, 8, make);
+    CHECK(nmade == 1);
+    CHECK(a0 == a0b);
+
+    cache.get(pir, 1, 4, 8, make);
+    CHECK(nmade == 2);
+    CHECK(cache.stats().bytes == 2 * nbytes);
+
+    // touch group 0 so group 1 is the oldest, then overflow
+    cache.get(pir, 0, 4, 8, make);
+    cache.get(pir, 2, 4, 8, make);
+    CHECK(nmade == 3);
+    CHECK(cache.stats().bytes == 2 * nbytes);
+    cache.get(pir, 0, 4, 8, make);
+    CHECK(nmade == 3);
+    cache.get(pir, 1, 4, 8, make);
+    CHECK(nmade == 4);
+
+    // held arrays outlive eviction
+    cache.set_budget(0);
+    CHECK(cache.stats().bytes == 0);
+    CHECK((*a0)(3, 7) == Array::array_xxc::Scalar(1));
+
+    // zero budget disables caching
+    cache.get(pir, 0, 4, 8, make);
+    cache.get(pir, 0, 4, 8, make);
+    CHECK(nmade == 6);
+
+    cache.set_budget(old_budget);
+    cache.clear();
+}
+
+TEST_CASE("gen impact response cache pir identity")
+{
+    ImpactResponseCache& cache = ImpactResponseCache::instance();
+    cache.clear();
+
+    int nmade = 0;
+    auto make = [&]() {
+        ++nmade;
+        return Array::array_xxc::Constant(4, 8, nmade);
+    };
+
+    // Build PIRs in one buffer to force address reuse.
+    alignas(FakePIR) unsigned char buf[sizeof(FakePIR)];
+    auto make_pir = [&]() {
+        return std::shared_ptr<FakePIR>(new (buf) FakePIR, [](FakePIR* p) { p->~FakePIR(); });
+    };
+
+    auto pir1 = make_pir();
+    auto other = std::make_shared<FakePIR>();
+    auto a1 = cache.get(pir1, 0, 4, 8, make);
+    auto a2 = cache.get(other, 0, 4, 8, make);
+    CHECK(nmade == 2);
+    CHECK(a1 != a2);
+    CHECK(cache.get(pir1, 0, 4, 8, make) == a1);
+    CHECK(nmade == 2);
+
+    // A dead PIR's entry is not served to a new one at its address
+    // and is replaced rather than added to.
+    pir1.reset();
+    auto pir2 = make_pir();
+    auto a3 = cache.get(pir2, 0, 4, 8, make);
+    CHECK(nmade == 3);
+    CHECK(a3 != a1);
+    const size_t nbytes = 4 * 8 * sizeof(Array::array_xxc::Scalar);
+    CHECK(cache.stats().bytes == 2 * nbytes);
+    pir2.reset();
+
+    // No PIR, no caching.
+    cache.get(nullptr, 0, 4, 8, make);
+    cache.get(nullptr, 0, 4, 8, make);
+    CHECK(nmade == 5);
+
+    cache.clear();
+}
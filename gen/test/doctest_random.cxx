@@ -0,0 +1,101 @@
+#include "WireCellGen/Random.h"
+#include "WireCellAux/RandTools.h"
+#include "WireCellUtil/doctest.h"
+
+#include <memory>
+#include <vector>
+
+using namespace WireCell;
+
+static std::shared_ptr<Gen::Random> make_rng(const std::string& gen)
+{
+    auto rng = std::make_shared<Gen::Random>(gen, std::vector<unsigned int>{1, 2, 3});
+    rng->configure(rng->default_configuration());
+    return rng;
+}
+
+TEST_CASE("gen random substreams")
+{
+    auto parent = make_rng("twister");
+    auto s1 = parent->substream({10, 1, 0, 2});
+
+    // Parent state does not matter.
+    parent->normal(0, 1);
+    parent->uniform(0, 1);
+    auto s2 = parent->substream({10, 1, 0, 2});
+    auto s3 = parent->substream({10, 1, 0, 3});
+    REQUIRE(s1);
+    REQUIRE(s2);
+    REQUIRE(s3);
+
+    std::vector<float> v1(100), v2(100), v3(100);
+    s1->fill_normal(v1.data(), v1.size(), 0, 1);
+    s2->fill_normal(v2.data(), v2.size(), 0, 1);
+    s3->fill_normal(v3.data(), v3.size(), 0, 1);
+    CHECK(v1 == v2);
+    CHECK(v1 != v3);
+
+    // Nested substreams differ from their parent's siblings.
+    auto n1 = s1->substream({5});
+    auto n3 = s3->substream({5});
+    CHECK(n1->uniform(0, 1) != n3->uniform(0, 1));
+
+    // Other seeds give other streams.
+    auto other = std::make_shared<Gen::Random>("twister", std::vector<unsigned int>{4, 5, 6});
+    other->configure(other->default_configuration());
+    CHECK(other->substream({10, 1, 0, 2})->uniform(0, 1) != parent->substream({10, 1, 0, 2})->uniform(0, 1));
+
+    // make_substream() prefers keyed substreams.
+    auto m1 = Gen::make_substream(parent, {10, 1, 0, 2});
+    std::vector<float> vm(100);
+    m1->fill_normal(vm.data(), vm.size(), 0, 1);
+    CHECK(vm == v1);
+}
+
+TEST_CASE("gen random fills")
+{
+    for (auto gen : {"default", "twister", "philox"}) {
+        auto rng = make_rng(gen);
+        std::vector<int> counts(10000);
+        rng->fill_poisson(counts.data(), counts.size(), 4.0);
+        double sum = 0;
+        for (int c : counts) {
+            sum += c;
+        }
+        CHECK(sum / counts.size() == doctest::Approx(4.0).epsilon(0.05));
+
+        std::vector<float> vals(10000);
+        rng->fill_uniform(vals.data(), vals.size(), 2.0, 3.0);
+        sum = 0;
+        for (float v : vals) {
+            sum += v;
+        }
+        CHECK(sum / vals.size() == doctest::Approx(2.5).epsilon(0.01));
+    }
+}
+
+TEST_CASE("gen random fills behind rand tools")
+{
+    using namespace WireCell::Aux::RandTools;
+    for (std::string gen : {"twister", "philox"}) {
+        CAPTURE(gen);
+
+        // Fresh vectors are bulk fills.
+        auto r1 = make_rng(gen);
+        auto r2 = make_rng(gen);
+        auto fresh = Normals::make_fresh(r1, 1, 2);
+        std::vector<float> want(101);
+        r2->fill_normal(want.data(), want.size(), 1, 2);
+        CHECK(fresh(want.size()) == want);
+
+        // A recycling ring is filled in bulk.  For std engines this
+        // draws as one normal() per value did, for philox it does not.
+        auto r3 = make_rng(gen);
+        auto r4 = make_rng(gen);
+        auto ring = Normals::make_recycling(r3, 1000);
+        CHECK(ring.size() == 1000);
+        std::vector<float> skip(1000);
+        r4->fill_normal(skip.data(), skip.size(), 0, 1);
+        CHECK(r3->uniform(0, 1) == r4->uniform(0, 1));
+    }
+}
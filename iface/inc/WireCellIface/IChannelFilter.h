@@ -27,6 +27,11 @@ namespace WireCell {
          * channel mask map with any tick-level masking that may be
          * applied later.*/
         virtual Waveform::ChannelMaskMap apply(channel_signals_t& chansig) const = 0;
+
+        /** Return true if apply() may be called concurrently from
+         * several threads, each with its own signals.  Callers may
+         * then filter channels or channel groups in parallel. */
+        virtual bool thread_safe() const { return false; }
     };
 
 }  // namespace WireCell
@@ -18,6 +18,8 @@ namespace WireCell {
         typedef std::vector<float> amplitude_t;
 
         /// Return a regularly sampled spectrum for the channel ID.
+        /// The referenced spectrum must stay valid and unchanged for
+        /// the life of the model as users may key caches on it.
         virtual const amplitude_t& channel_spectrum(int chid) const = 0;
 
     };
@@ -37,6 +37,18 @@ namespace WireCell {
         There is also a special rank=0 DFT on rank=2 arrays which is
         more commonly known as a "matrix transpose".
 
+        Each of the 6 DFT methods has a real counterpart with suffix
+        "_r2c" (forward) or "_c2r" (inverse).  These take a real array
+        and produce, or take, the non-redundant half of its Hermitian
+        symmetric spectrum.  The nrows/ncols arguments always give the
+        shape of the real array.  Along the transformed dimension of
+        size n the spectrum holds n/2+1 elements (integer division).
+        For 1d that is size/2+1 elements, for 1b it is (nrows,
+        ncols/2+1) for axis=1 or (nrows/2+1, ncols) for axis=0 and for
+        2d it is (nrows, ncols/2+1).  The c2r methods ignore any
+        imaginary parts that would violate the Hermitian symmetry, as
+        at zero and at the Nyquist frequency.
+
         Requirements on implementations:
 
         - Forward transforms SHALL NOT apply normalization.
@@ -49,6 +61,12 @@ namespace WireCell {
         - Transform methods SHALL allow the input and output array
           pointers to be identical.
 
+        - The r2c/c2r methods SHALL NOT modify their input array.
+
+        - The IDFT interface provides r2c/c2r methods implemented in
+          terms of the complex methods and an implementation SHOULD
+          override these to avoid the cost of the complex promotion.
+
         - The IDFT interface provides 1b methods implemented in terms
           of 1d calls and a implementation MAY override these (for
           example, if implementation can exploit batch optimization).
@@ -64,6 +82,9 @@ namespace WireCell {
         - Input and output arrays MUST either be non-overlapping in
           memory or MUST be identical.
 
+        - Input and output arrays of r2c/c2r methods MUST be
+          non-overlapping in memory.
+
         Notes: 
 
         - All arrays are of type single precision complex floating
@@ -115,6 +136,30 @@ namespace WireCell {
                    int nrows, int ncols) const = 0;
 
 
+        // real input / half-spectrum, see comments above.
+
+        virtual
+        void fwd1d_r2c(const scalar_t* in, complex_t* out, int size) const;
+
+        virtual
+        void inv1d_c2r(const complex_t* in, scalar_t* out, int size) const;
+
+        virtual
+        void fwd1b_r2c(const scalar_t* in, complex_t* out,
+                       int nrows, int ncols, int axis) const;
+
+        virtual
+        void inv1b_c2r(const complex_t* in, scalar_t* out,
+                       int nrows, int ncols, int axis) const;
+
+        virtual
+        void fwd2d_r2c(const scalar_t* in, complex_t* out,
+                       int nrows, int ncols) const;
+
+        virtual
+        void inv2d_c2r(const complex_t* in, scalar_t* out,
+                       int nrows, int ncols) const;
+
         // Fill "out" with the transpose of "in", may be in-place.
         // The nrows/ncols refers to the shape of the input.
         virtual
@@ -55,6 +55,23 @@ namespace WireCell {
         /// Return a vector of all traces ignoring any potential tag.
         virtual ITrace::shared_vector traces() const = 0;
 
+        /// A frame may hold all of its samples in one contiguous,
+        /// row-major block of nrows channels by ncols ticks.  If so,
+        /// the traces are views of the rows with trace index equal to
+        /// row index.  The view is only valid while the frame lives.
+        struct dense_view_t {
+            const float* data{nullptr};  // nullptr if not dense
+            size_t nrows{0}, ncols{0};
+            int tbin{0};                 // tbin of column 0
+            const std::vector<int>* channels{nullptr};  // channel of each row
+
+            explicit operator bool() const { return data != nullptr; }
+        };
+
+        /// Return a dense view of the samples.  The default is a
+        /// frame which is not dense and the view is false.
+        virtual dense_view_t dense() const { return dense_view_t{}; }
+
         /// Return all masks associated with this frame
         // fixme: this should be its own interface
         virtual Waveform::ChannelMaskMap masks() const
@@ -17,6 +17,11 @@
     Note, to gain any speed up, the IRandom implementation must
     explicitly implement these "callable" methods.  
 
+    The "fill" methods sample many values from one distribution in a
+    single call and the substream() method returns an independent
+    generator that does not share state with its parent.  Both have
+    default implementations.
+
  */
 
 #ifndef WIRECELL_IRANDOM
@@ -24,6 +29,7 @@
 
 #include "WireCellUtil/IComponent.h"
 #include <functional>
+#include <vector>
 
 namespace WireCell {
 
@@ -57,6 +63,20 @@ namespace WireCell {
         /// Sample a uniform integer range.
         virtual int range(int first, int last) = 0;
         virtual int_func make_range(int first, int last);
+
+        /// Fill out[0,n) with samples.  The defaults call the
+        /// immediate methods.
+        virtual void fill_normal(float* out, size_t n, double mean, double sigma);
+        virtual void fill_uniform(float* out, size_t n, double begin, double end);
+        virtual void fill_poisson(int* out, size_t n, double mean);
+
+        /// Return an independent generator for the stream named by
+        /// keys, eg (event, anode, plane, channel).  The stream
+        /// depends only on the configuration of this generator and
+        /// the keys, not on its state nor on the order of calls, so
+        /// substreams may be used from many threads reproducibly.
+        /// The default returns nullptr meaning unsupported.
+        virtual pointer substream(const std::vector<size_t>& keys) const;
     };
 
 }  // namespace WireCell
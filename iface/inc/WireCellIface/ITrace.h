@@ -34,6 +34,14 @@ namespace WireCell {
         /// Return the contiguous adc/charge measurements on the
         /// channel starting at tbin.
         virtual const ChargeSequence& charge() const = 0;
+
+        /// Return a pointer to the first of nsamples() contiguous
+        /// measurements starting at tbin.  Unlike charge(), these need
+        /// not materialize a vector which lets a trace be a view into
+        /// a larger block (see IFrame::dense()).  Consumers that only
+        /// read the samples should prefer these.
+        virtual const float* samples() const { return charge().data(); }
+        virtual size_t nsamples() const { return charge().size(); }
     };
 
 }  // namespace WireCell
@@ -1,6 +1,7 @@
 #include "WireCellIface/IDFT.h"
 
 #include <vector>
+#include <algorithm>
 #include <utility>              // std::swap since c++11
 
 using namespace WireCell;
@@ -42,6 +43,115 @@ void IDFT::inv1b(const complex_t* in, complex_t* out,
     }
 }
 
+// Default real input / half-spectrum implementations which promote to
+// complex and use the full complex transforms.  They cost more than
+// the complex transforms so implementations should override them.
+
+void IDFT::fwd1d_r2c(const scalar_t* in, complex_t* out, int size) const
+{
+    std::vector<complex_t> full(in, in+size);
+    this->fwd1d(full.data(), full.data(), size);
+    std::copy(full.begin(), full.begin() + size/2 + 1, out);
+}
+
+// Fill full Hermitian-symmetric spectrum from half spectrum, both
+// row-major.  The half is along the given axis.
+static
+std::vector<IDFT::complex_t> hermitian_full(const IDFT::complex_t* half,
+                                            int nrows, int ncols, int axis)
+{
+    std::vector<IDFT::complex_t> full(nrows*ncols);
+    if (axis) {
+        const int nhalf = ncols/2 + 1;
+        for (int irow=0; irow<nrows; ++irow) {
+            for (int icol=0; icol<ncols; ++icol) {
+                full[irow*ncols + icol] = icol < nhalf
+                    ? half[irow*nhalf + icol]
+                    : std::conj(half[irow*nhalf + ncols - icol]);
+            }
+        }
+        return full;
+    }
+    const int nhalf = nrows/2 + 1;
+    for (int irow=0; irow<nrows; ++irow) {
+        for (int icol=0; icol<ncols; ++icol) {
+            full[irow*ncols + icol] = irow < nhalf
+                ? half[irow*ncols + icol]
+                : std::conj(half[(nrows - irow)*ncols + icol]);
+        }
+    }
+    return full;
+}
+
+void IDFT::inv1d_c2r(const complex_t* in, scalar_t* out, int size) const
+{
+    auto full = hermitian_full(in, 1, size, 1);
+    this->inv1d(full.data(), full.data(), size);
+    for (int ind=0; ind<size; ++ind) {
+        out[ind] = std::real(full[ind]);
+    }
+}
+
+void IDFT::fwd1b_r2c(const scalar_t* in, complex_t* out,
+                     int nrows, int ncols, int axis) const
+{
+    std::vector<complex_t> full(in, in+nrows*ncols);
+    this->fwd1b(full.data(), full.data(), nrows, ncols, axis);
+    if (axis) {
+        const int nhalf = ncols/2 + 1;
+        for (int irow=0; irow<nrows; ++irow) {
+            std::copy(full.begin() + irow*ncols, full.begin() + irow*ncols + nhalf,
+                      out + irow*nhalf);
+        }
+        return;
+    }
+    const int nhalf = nrows/2 + 1;
+    std::copy(full.begin(), full.begin() + nhalf*ncols, out);
+}
+
+void IDFT::inv1b_c2r(const complex_t* in, scalar_t* out,
+                     int nrows, int ncols, int axis) const
+{
+    auto full = hermitian_full(in, nrows, ncols, axis);
+    this->inv1b(full.data(), full.data(), nrows, ncols, axis);
+    const int size = nrows*ncols;
+    for (int ind=0; ind<size; ++ind) {
+        out[ind] = std::real(full[ind]);
+    }
+}
+
+void IDFT::fwd2d_r2c(const scalar_t* in, complex_t* out,
+                     int nrows, int ncols) const
+{
+    std::vector<complex_t> full(in, in+nrows*ncols);
+    this->fwd2d(full.data(), full.data(), nrows, ncols);
+    const int nhalf = ncols/2 + 1;
+    for (int irow=0; irow<nrows; ++irow) {
+        std::copy(full.begin() + irow*ncols, full.begin() + irow*ncols + nhalf,
+                  out + irow*nhalf);
+    }
+}
+
+void IDFT::inv2d_c2r(const complex_t* in, scalar_t* out,
+                     int nrows, int ncols) const
+{
+    // The 2D Hermitian symmetry relates (r,c) to (-r,-c).
+    const int nhalf = ncols/2 + 1;
+    std::vector<complex_t> full(nrows*ncols);
+    for (int irow=0; irow<nrows; ++irow) {
+        for (int icol=0; icol<ncols; ++icol) {
+            full[irow*ncols + icol] = icol < nhalf
+                ? in[irow*nhalf + icol]
+                : std::conj(in[((nrows - irow)%nrows)*nhalf + ncols - icol]);
+        }
+    }
+    this->inv2d(full.data(), full.data(), nrows, ncols);
+    const int size = nrows*ncols;
+    for (int ind=0; ind<size; ++ind) {
+        out[ind] = std::real(full[ind]);
+    }
+}
+
 // Trivial default transpose.  Implementations, please override if you
 // can offer something faster.
 
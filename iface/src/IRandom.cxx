@@ -41,3 +41,29 @@ IRandom::int_func IRandom::make_range(int first, int last)
     return std::bind(&IRandom::range, this, first, last);
 }
 
+
+void IRandom::fill_normal(float* out, size_t n, double mean, double sigma)
+{
+    for (size_t ind = 0; ind < n; ++ind) {
+        out[ind] = normal(mean, sigma);
+    }
+}
+
+void IRandom::fill_uniform(float* out, size_t n, double begin, double end)
+{
+    for (size_t ind = 0; ind < n; ++ind) {
+        out[ind] = uniform(begin, end);
+    }
+}
+
+void IRandom::fill_poisson(int* out, size_t n, double mean)
+{
+    for (size_t ind = 0; ind < n; ++ind) {
+        out[ind] = poisson(mean);
+    }
+}
+
+IRandom::pointer IRandom::substream(const std::vector<size_t>& keys) const
+{
+    return nullptr;
+}
@@ -130,6 +130,13 @@ namespace WireCell::Img::CS {
         // decomposition on the measure covariance matrix.  If False,
         // measurement uncertainties are not considered.
         bool whiten{true};
+        // If true, keep the blob-measure matrix sparse and use the
+        // sparse, residual-updating coordinate descent.  Memory and
+        // time then scale with the number of edges, not nblob*nmeas.
+        bool sparse{false};
+        // If true, start the fit from the current blob values (as
+        // left by a previous solve) instead of from zero.
+        bool warm_start{false};
     };
     graph_t solve(const graph_t& csg, const SolveParams& params, const bool verbose=false);
 
@@ -93,6 +93,22 @@ namespace WireCell {
             // "whitened" via Cholesky decomposition.
             bool m_whiten{true};
 
+            // Config: if true, the blob-measure matrix is kept sparse
+            // and solved with the residual-updating sparse coordinate
+            // descent.  Recommended for events with large showers
+            // where slices have thousands of blobs.
+            bool m_sparse{false};
+
+            // Config: if true, each weighting round after the first
+            // starts the fit from the previous round's solution.
+            bool m_warm_start{false};
+
+            // Config: number of threads over which the independent
+            // b-m subgraphs are solved.  Each subgraph keeps its
+            // place in the output so the result does not depend on
+            // this number.
+            int m_nthreads{1};
+
             int m_count{0};
         };
 
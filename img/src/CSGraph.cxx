@@ -1,11 +1,14 @@
 #include "WireCellImg/CSGraph.h"
 
 #include "WireCellUtil/String.h"
+#include "WireCellUtil/Ress.h"
 #include "WireCellUtil/Exceptions.h"
 #include "WireCellAux/SimpleBlob.h"
 
 #include "spdlog/spdlog.h"
 
+#include <cmath>
+
 using namespace WireCell;
 using namespace WireCell::Img;
 using namespace WireCell::Img::CS;
@@ -64,13 +67,18 @@ graph_t CS::solve(const graph_t& csg, const SolveParams& params, const bool verb
         blob_descs_out(desc_out);        
     }
 
+    // The measure covariance is diagonal so its "whitening" Cholesky
+    // factor is simply the diagonal of inverse uncertainties.
     double_vector_t measure = double_vector_t::Zero(nmeas);
-    double_matrix_t mcov = double_matrix_t::Zero(nmeas, nmeas);
+    double_vector_t mwhite = double_vector_t::Zero(nmeas);
+    double mcov_sum = 0;
     for (size_t mind=0; mind<nmeas; ++mind) {
         const auto& meas_in = csg[meas_descs.collection[mind]];
         const auto valerr = meas_in.value;
         measure(mind) = valerr.value();
-        mcov(mind, mind) = valerr.uncertainty()*valerr.uncertainty();
+        const double mvar = valerr.uncertainty()*valerr.uncertainty();
+        mwhite(mind) = std::sqrt(1.0/mvar);
+        mcov_sum += mvar;
         /// TODO: rm debug info
         // if (verbose) {
         //     SPDLOG_INFO("val {} unc {}", valerr.value(), valerr.uncertainty());
@@ -78,7 +86,7 @@ graph_t CS::solve(const graph_t& csg, const SolveParams& params, const bool verb
         auto desc_out = boost::add_vertex(meas_in, csg_out);
         meas_descs_out(desc_out);        
     }
-    if (params.whiten and mcov.sum() == 0.0) {
+    if (params.whiten and mcov_sum == 0.0) {
         // std::cerr << "zero measure covariance from " << boost::num_vertices(csg) << " node graph\n";
         return csg_out;
     }
@@ -96,7 +104,9 @@ graph_t CS::solve(const graph_t& csg, const SolveParams& params, const bool verb
         return csg_out;
     }
         
-    double_matrix_t A = double_matrix_t::Zero(nmeas, nblob);
+    // Blob-measure associations.  Kept as triplets so that the
+    // sparse solver never sees a dense nmeas x nblob matrix.
+    std::vector<Eigen::Triplet<double>> assoc;
 
     for (auto [ei, ei_end] = boost::edges(csg); ei != ei_end; ++ei) {
         const vdesc_t tail = boost::source(*ei, csg);
@@ -117,7 +127,7 @@ graph_t CS::solve(const graph_t& csg, const SolveParams& params, const bool verb
             // someone has violated my requirements with this edge!
             continue;
         }
-        A(mind, bind) = 1;
+        assoc.emplace_back(mind, bind, 1.0);
 
         boost::add_edge(blob_descs_out.collection[bind],
                         meas_descs_out.collection[mind],
@@ -126,7 +136,6 @@ graph_t CS::solve(const graph_t& csg, const SolveParams& params, const bool verb
 
     
     double_vector_t m_vec = measure;
-    double_matrix_t R_mat = A;
 
     if (params.config != SolveParams::uboone && params.config != SolveParams::simple) {
         THROW(ValueError() << errmsg{String::format("SolveParams config %s not defined", params.config)});
@@ -135,47 +144,52 @@ graph_t CS::solve(const graph_t& csg, const SolveParams& params, const bool verb
     if (params.config == SolveParams::uboone) {
         double total_wire_charge = m_vec.sum(); // before scale
         double lambda = 3./total_wire_charge/2.*params.scale;
-        double tolerance = total_wire_charge/3./params.scale/R_mat.cols()*0.005;
+        double tolerance = total_wire_charge/3./params.scale/nblob*0.005;
         rparams = Ress::Params{Ress::lasso, lambda, 100000, tolerance, true, false};
     }
-    // if (verbose) {
-        // SPDLOG_INFO("CS params {} {}", params.scale, params.whiten);
-        // SPDLOG_INFO("ress param {} {}", rparams.lambda, rparams.tolerance);
-        // SPDLOG_INFO("R_mat {}", String::stringify(R_mat));
-        // SPDLOG_INFO("m_vec {}", String::stringify(m_vec));
-        // SPDLOG_INFO("source {}", String::stringify(source));
-        // SPDLOG_INFO("weight {} {}", weight.size(), weight[0]);
-    // }
+    double_vector_t initial = source;
+    if (params.warm_start) {
+        rparams.set_init = true;
+        initial = source / params.scale;
+    }
 
-    if (params.whiten) {
+    // A repeated edge still means a single association.
+    Ress::sparse_matrix_t A(nmeas, nblob);
+    A.setFromTriplets(assoc.begin(), assoc.end(),
+                      [](const double&, const double& b) { return b; });
 
-        // std::cerr << "A:\n" << A << "\nmcov:\n" << mcov << "\nmcovinv:\n" << mcov.inverse() << std::endl;
-        Eigen::LLT<double_matrix_t> llt(mcov.inverse());
-        double_matrix_t U = llt.matrixL().transpose();
-        // std::cerr << "U:\n" << U << std::endl;
- 
+    Ress::sparse_matrix_t R_mat = A;
+    if (params.whiten) {
         // The measure vector in a "whitened" basis
-        m_vec = U*measure;
+        m_vec = mwhite.cwiseProduct(measure);
 
         // The blob-measure association in "whitened" basis (becomes
         // the "reasponse" matrix in ress solving).
-        R_mat = params.scale*U*A;
+        const double_vector_t rscale = params.scale * mwhite;
+        R_mat = rscale.asDiagonal() * A;
     }
     if (verbose) {
-        SPDLOG_INFO("CS params {} {}", params.scale, params.whiten);
+        SPDLOG_INFO("CS params {} {} sparse {}", params.scale, params.whiten, params.sparse);
         SPDLOG_INFO("ress param {} {}", rparams.lambda, rparams.tolerance);
-        SPDLOG_INFO("R_mat \n{}", String::stringify(R_mat));
+        SPDLOG_INFO("R_mat \n{}", String::stringify(double_matrix_t(R_mat)));
         SPDLOG_INFO("m_vec \n{}", String::stringify(m_vec));
         SPDLOG_INFO("source \n{}", String::stringify(source));
         SPDLOG_INFO("weight \n{}", String::stringify(weight));
     }
-    // std::cerr << "R:\n" << R_mat << "\nm:\n" << m_vec << std::endl;
-    auto solution = Ress::solve(R_mat, m_vec, rparams,
-                                source, weight);
+
+    double_vector_t solution, predicted;
+    if (params.sparse) {
+        solution = Ress::solve(R_mat, m_vec, rparams, initial, weight);
+        predicted = Ress::predict(R_mat, solution);
+    }
+    else {
+        const double_matrix_t R_dense(R_mat);
+        solution = Ress::solve(R_dense, m_vec, rparams, initial, weight);
+        predicted = Ress::predict(R_dense, solution);
+    }
     if (verbose) {
         SPDLOG_INFO("solution {}", String::stringify(solution));
     }
-    auto predicted = Ress::predict(R_mat, solution);
 
     auto& gp_out = csg_out[boost::graph_bundle];
     gp_out.chi2_base = Ress::chi2_base(m_vec, predicted);
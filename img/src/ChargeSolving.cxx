@@ -11,8 +11,11 @@
 
 #include "WireCellUtil/NamedFactory.h"
 #include "WireCellUtil/Logging.h"
+#include "WireCellUtil/Parallel.h"
 
+#include <algorithm>
 #include <iterator>
+#include <numeric>
 
 WIRECELL_FACTORY(ChargeSolving, WireCell::Img::ChargeSolving,
                  WireCell::INamed,
@@ -44,6 +47,9 @@ WireCell::Configuration Img::ChargeSolving::default_configuration() const
     }
     cfg["solve_config"] = m_solve_config;
     cfg["whiten"] = m_whiten;
+    cfg["sparse"] = m_sparse;
+    cfg["warm_start"] = m_warm_start;
+    cfg["nthreads"] = m_nthreads;
 
     return cfg;
 }
@@ -183,6 +189,9 @@ void Img::ChargeSolving::configure(const WireCell::Configuration& cfg)
     }
     log->debug("SolveParams::Config: {}", m_solve_config);
     m_whiten = get<bool>(cfg, "whiten", m_whiten);
+    m_sparse = get<bool>(cfg, "sparse", m_sparse);
+    m_warm_start = get<bool>(cfg, "warm_start", m_warm_start);
+    m_nthreads = std::max(1, get(cfg, "nthreads", m_nthreads));
 }
 
 
@@ -273,34 +282,39 @@ bool Img::ChargeSolving::operator()(const input_pointer& in, output_pointer& out
 
     std::vector<float> blob_threshold(nstrats, m_blob_thresh.value());
 
-    SolveParams sparams{gSolveParamsConfigMap.at(m_solve_config), 1000, m_whiten};
+    // Each subgraph is independent and runs through all strategies on
+    // its own.  Largest subgraphs are handed out first to balance the
+    // threads.  Results stay in their slot so repack order is fixed.
+    std::vector<size_t> order(sgs.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (m_nthreads > 1) {
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return boost::num_vertices(sgs[a]) > boost::num_vertices(sgs[b]);
+        });
+    }
+
+    const SolveParams sparams0{gSolveParamsConfigMap.at(m_solve_config), 1000, m_whiten, m_sparse};
     for (size_t ind = 0; ind < nstrats; ++ind) {
-        const auto& strategy = m_weighting_strategies[ind];
         log->debug("cluster: {} strategy={}",
-                   in->ident(), strategy);
-
-        auto& blob_weighter = gStrategies.at(strategy);
-
-        // TODO: remove debug code
-        // for (auto& sg : sgs) {
-        //     auto gprop = sg[boost::graph_bundle];
-        //     int start_tick = std::round(gprop.islice->start()/(0.5*WireCell::units::us));
-        //     if (start_tick==2132) {
-        //         log->debug("start: {}", start_tick);
-        //         dump_sg(sg, log);
-        //         blob_weighter(in_graph, sg);
-        //         solve(sg, sparams, true);
-        //     }
-        // }
-
-        std::transform(sgs.begin(), sgs.end(), sgs.begin(),
-                       [&](graph_t& sg) {
-                           //dump_sg(sg, log);
-                           blob_weighter(in_graph, sg);
-                           auto tmp_csg = solve(sg, sparams);
-                           return prune(tmp_csg, blob_threshold[ind]);
-                       });
+                   in->ident(), m_weighting_strategies[ind]);
     }
+    Parallel::for_each(order.size(), m_nthreads, [&](size_t iorder) {
+        graph_t& sg = sgs[order[iorder]];
+        SolveParams sparams = sparams0;
+        for (size_t ind = 0; ind < nstrats; ++ind) {
+            const auto& strategy = m_weighting_strategies[ind];
+            auto& blob_weighter = gStrategies.at(strategy);
+
+            // The first round starts from the tiling values, later
+            // ones may start from the previous solution.
+            sparams.warm_start = m_warm_start and ind > 0;
+
+            //dump_sg(sg, log);
+            blob_weighter(in_graph, sg);
+            auto tmp_csg = solve(sg, sparams);
+            sg = prune(tmp_csg, blob_threshold[ind]);
+        }
+    });
     for (const auto& sg : sgs) {
         dump_sg(sg, log);
     }
@@ -0,0 +1,123 @@
+// ChargeSolving output does not depend on the number of threads.
+#include "WireCellImg/ChargeSolving.h"
+
+#include "WireCellAux/SimpleBlob.h"
+#include "WireCellAux/SimpleCluster.h"
+#include "WireCellAux/SimpleMeasure.h"
+#include "WireCellAux/SimpleSlice.h"
+#include "WireCellUtil/GraphTools.h"
+#include "WireCellUtil/Units.h"
+#include "WireCellUtil/doctest.h"
+
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+using namespace WireCell;
+
+static const int nslices = 6;
+static const int ngroups = 4;
+
+// Which blobs of a group each measure covers, per plane.  Blob 3 is
+// a ghost with no true charge.
+static const std::vector<std::vector<std::vector<int>>> coverage{
+    {{0, 1}, {2, 3}},
+    {{0, 3}, {1, 2}},
+    {{0, 1, 2, 3}},
+};
+
+// Slices of independent groups of overlapping blobs.  Each blob also
+// connects to its twin in the neighboring slices.
+static ICluster::pointer make_cluster()
+{
+    cluster_graph_t cg;
+    std::vector<std::vector<cluster_vertex_t>> prev(ngroups);
+    int mident = 0;
+    for (int islice = 0; islice < nslices; ++islice) {
+        auto slice = std::make_shared<Aux::SimpleSlice>(nullptr, islice, islice * 2 * units::us, 2 * units::us);
+        auto svtx = boost::add_vertex(ISlice::pointer(slice), cg);
+
+        for (int igroup = 0; igroup < ngroups; ++igroup) {
+            std::vector<float> truth;
+            std::vector<cluster_vertex_t> bvtxs;
+            for (int iblob = 0; iblob < 4; ++iblob) {
+                truth.push_back(iblob == 3 ? 0 : 1000 * (1 + igroup) + 300 * iblob + 50 * islice);
+                const int bident = 100 * (ngroups * islice + igroup) + iblob;
+                IBlob::pointer blob = std::make_shared<Aux::SimpleBlob>(bident, 1000, 0, RayGrid::Blob(),
+                                                                        slice, nullptr);
+                auto bvtx = boost::add_vertex(blob, cg);
+                boost::add_edge(svtx, bvtx, cg);
+                if (!prev[igroup].empty()) {
+                    boost::add_edge(prev[igroup][iblob], bvtx, cg);
+                }
+                bvtxs.push_back(bvtx);
+            }
+            prev[igroup] = bvtxs;
+
+            for (size_t iplane = 0; iplane < coverage.size(); ++iplane) {
+                for (const auto& covered : coverage[iplane]) {
+                    float sum = 0;
+                    for (int iblob : covered) {
+                        sum += truth[iblob];
+                    }
+                    // A little off, as a real measure would be.
+                    sum *= 1 + 0.01 * ((mident % 5) - 2);
+                    IMeasure::pointer meas = std::make_shared<Aux::SimpleMeasure>(
+                        mident++, WirePlaneId(iplane2layer[iplane]), IMeasure::value_t(sum, std::sqrt(sum)));
+                    auto mvtx = boost::add_vertex(meas, cg);
+                    for (int iblob : covered) {
+                        boost::add_edge(bvtxs[iblob], mvtx, cg);
+                    }
+                }
+            }
+        }
+    }
+    return std::make_shared<Aux::SimpleCluster>(cg, 42);
+}
+
+using blob_values_t = std::vector<std::tuple<int, float, float>>;
+
+// Return blob ident, value and uncertainty in output graph order.
+static blob_values_t solve(const ICluster::pointer& in, int nthreads)
+{
+    Img::ChargeSolving cs;
+    auto cfg = cs.default_configuration();
+    cfg["weighting_strategies"] = Json::arrayValue;
+    cfg["weighting_strategies"].append("uniform");
+    cfg["weighting_strategies"].append("uboone");
+    cfg["blob_value_threshold"] = 100;
+    cfg["nthreads"] = nthreads;
+    cs.configure(cfg);
+
+    ICluster::pointer out;
+    REQUIRE(cs(in, out));
+    REQUIRE(out);
+
+    blob_values_t ret;
+    const auto& cg = out->graph();
+    for (auto vtx : GraphTools::mir(boost::vertices(cg))) {
+        const auto& node = cg[vtx];
+        if (node.code() != 'b') {
+            continue;
+        }
+        const auto blob = std::get<IBlob::pointer>(node.ptr);
+        ret.emplace_back(blob->ident(), blob->value(), blob->uncertainty());
+    }
+    return ret;
+}
+
+TEST_CASE("charge solving nthreads")
+{
+    const auto in = make_cluster();
+    const auto one = solve(in, 1);
+
+    // Something is solved and the ghosts are pruned.
+    REQUIRE(!one.empty());
+    for (const auto& [ident, value, unc] : one) {
+        CHECK(ident % 100 != 3);
+    }
+
+    CHECK(solve(in, 2) == one);
+    CHECK(solve(in, 3) == one);
+    CHECK(solve(in, 8) == one);
+}
@@ -1,5 +1,14 @@
 /** A simple DFP engine meant for single-threaded execution.
 
+    Optionally, the graph may be executed by a pool of threads with
+    each thread calling whichever node is ready to do work.  See
+    Node::Concurrency for how nodes may restrict this.
+
+    An edge may be given a capacity.  A node with any output edge
+    filled to capacity is not called until its downstream drains the
+    edge.  This back-pressure is relaxed only when no other node can
+    make progress so that it can not dead-lock the graph.
+
     A node is constructed with zero or more ports.
 
     A port mediates between a node and an edge.
@@ -25,6 +34,7 @@
 #include "WireCellPgraph/Node.h"
 #include "WireCellUtil/Logging.h"
 #include "WireCellUtil/ExecMon.h"
+#include "WireCellUtil/TraceEvents.h"
 
 #include <vector>
 #include <unordered_set>
@@ -42,8 +52,10 @@ namespace WireCell {
 
             // Connect two nodes by their given ports.  Return false
             // if they are incompatible.  new nodes will be implicitly
-            // added to the graph.
-            bool connect(Node* tail, Node* head, size_t tpind = 0, size_t hpind = 0);
+            // added to the graph.  A nonzero capacity limits the
+            // number of items the edge should hold, see EdgeQueue.
+            bool connect(Node* tail, Node* head, size_t tpind = 0, size_t hpind = 0,
+                         size_t capacity = 0);
 
             // return a topological sort of the graph as per Kahn algorithm.
             std::vector<Node*> sort_kahn();
@@ -51,6 +63,11 @@ namespace WireCell {
             // Excute the graph until nodes stop delivering
             bool execute();
 
+            // Execute the graph until nodes stop delivering using
+            // nthreads threads.  Any exception thrown by a node is
+            // rethrown from here after all threads finish.
+            bool execute_threaded(size_t nthreads);
+
             // Excute parents of node or if any parent is not ready,
             // recursively call this method on parent.  Return number
             // of nodes executed.
@@ -65,11 +82,21 @@ namespace WireCell {
             // Print out cumulated CPU time for executing each node
             void print_timers(bool include_execmon=false) const;
 
+            // Print out the peak number of items held by each edge
+            void print_queues() const;
+
             //Turn on/off using ExecMon
             void set_enable_em(bool flag=false);
 
+            // Record a span for each productive node call.  The
+            // input count is the number of items queued on the node
+            // input ports before the call and the output count is
+            // that on its output ports after.  Pass nullptr to stop.
+            void set_trace(std::shared_ptr<TraceEvents> trace) { m_trace = trace; }
+
            private:
             std::vector<std::pair<Node*, Node*> > m_edges;
+            std::vector<Edge> m_queues;  // parallel to m_edges
             //std::unordered_set<Node*> m_nodes;
             std::map<size_t, Node*> m_nodes;
             std::unordered_map<Node*, std::vector<Node*> > m_edges_forward, m_edges_backward;
@@ -78,6 +105,7 @@ namespace WireCell {
             std::unordered_map<Node*, double> m_nodes_timer;
             bool m_enable_em = false;
             ExecMon m_em;
+            std::shared_ptr<TraceEvents> m_trace;
         };
     }  // namespace Pgraph
 }  // namespace WireCell
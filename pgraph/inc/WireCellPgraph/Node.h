@@ -9,6 +9,23 @@ namespace WireCell {
         // A node in the DFP graph must inherit from Node.
         class Node {
            public:
+            // How a multi-threaded executor may schedule calls to
+            // the node.  No node is ever called by more than one
+            // thread at a time as that would break the ordering of
+            // its input and output streams.
+            //
+            // - serial :: the node shares a single execution lane
+            //   with all other serial nodes.  Use for nodes wrapping
+            //   code that is not thread safe (eg, global state).
+            //
+            // - stateful :: the node may run concurrently with any
+            //   other node.  This is the default.
+            //
+            // - reentrant :: the node claims it may run concurrently
+            //   with itself (INode::concurrency() other than 1).  It
+            //   is currently scheduled as stateful.
+            enum Concurrency { serial, stateful, reentrant };
+
             Node() {
                 m_instance = m_instances++;
             }  // constructures may wish to resize/populate m_ports.
@@ -21,6 +38,9 @@ namespace WireCell {
             // Concrete node must return some instance identifier.
             virtual std::string ident() = 0;
 
+            // A short name for the node, eg for profiling reports.
+            virtual std::string name() { return ident(); }
+
             Port& iport(size_t ind = 0) { return port(Port::input, ind); }
             Port& oport(size_t ind = 0) { return port(Port::output, ind); }
 
@@ -76,13 +96,46 @@ namespace WireCell {
                 return ret;
             }
 
+            // Return true if any output port is filled to capacity.
+            bool output_full()
+            {
+                for (auto& p : output_ports()) {
+                    if (p.full()) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            // Return total number of items queued on input or output ports.
+            size_t input_size()
+            {
+                size_t num = 0;
+                for (auto& p : input_ports()) {
+                    num += p.size();
+                }
+                return num;
+            }
+            size_t output_size()
+            {
+                size_t num = 0;
+                for (auto& p : output_ports()) {
+                    num += p.size();
+                }
+                return num;
+            }
+
             size_t instance() const { return m_instance; }
 
+            Concurrency concurrency() const { return m_concurrency; }
+            void set_concurrency(Concurrency con) { m_concurrency = con; }
+
            protected:
             // Concrete class should fill during construction
             PortList m_ports[Port::ntypes];
            private:
             size_t m_instance;
+            Concurrency m_concurrency{stateful};
             static size_t m_instances;
 
         };
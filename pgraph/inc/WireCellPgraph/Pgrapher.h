@@ -50,6 +50,46 @@
     none, 1 is default and gives summary of time, 2 also includes ExecMon
     tracing.
 
+    A "threads" sets how many threads execute the graph.  The default,
+    0 or 1, uses the original single-threaded executor.  With more
+    threads, any node which is ready is called concurrently with other
+    nodes, which mostly benefits graphs with many parallel branches.
+    Timers then report wall-clock rather than CPU time.
+
+    A "concurrency" object may map a node typename to one of
+    "serial", "stateful" or "reentrant" to restrict how the threaded
+    executor may call that node.  All "serial" nodes share a single
+    lane of execution.  Nodes default to "stateful".  See
+    Pgraph::Node::Concurrency.
+
+      concurrency: { [wc.tn(rootsink)]: "serial" },
+
+    An "edge_capacity" sets the default maximum number of items an
+    edge should hold before its tail node is held back.  The default,
+    0, is unlimited.  An individual edge may override this with its
+    own "capacity".  The capacity is soft: a node may overfill an edge
+    by the number of items it produces in one call and back-pressure
+    is relaxed when no other node can run.  The peak number of items
+    held by each edge is reported when verbosity is nonzero.
+
+    Capacities count items on each edge separately.  There is no bound
+    on the total number of items, nor on their memory, held over all
+    edges.  To limit memory, give a capacity to the edges that carry
+    large data (eg frames) and allow for the number of such edges.
+
+      edges: [ { tail:..., head:..., capacity: 2 }, ... ],
+
+    A "trace_file" may name a file to receive a Chrome trace-event
+    JSON record of every productive node call giving its start and
+    wall-clock duration, thread CPU time, calling thread, change in
+    resident memory and input and output queue depths.  Load it with
+    chrome://tracing or https://ui.perfetto.dev.  Sampling memory
+    requires reading /proc on each call and may be turned off by
+    setting "trace_rss" to false.  The memory is that of the whole
+    process so with more than one thread a call's change also counts
+    other nodes.  Thus "trace_rss" defaults to true only when
+    "threads" is 0 or 1.
+
  */
 
 #ifndef WIRECELL_PGRAPH_PGRAPHER
@@ -80,6 +120,10 @@ namespace WireCell::Pgraph {
       private:
         Graph m_graph;
         int m_verbosity{1};
+        int m_threads{0};
+        int m_edge_capacity{0};
+        std::string m_trace_file{""};
+        std::shared_ptr<TraceEvents> m_trace;
     };
 
 }  // namespace WireCell::Pgraph
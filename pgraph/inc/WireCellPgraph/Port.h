@@ -9,6 +9,7 @@
 #include <vector>
 #include <deque>
 #include <memory>
+#include <mutex>
 
 namespace WireCell {
     namespace Pgraph {
@@ -21,8 +22,20 @@ namespace WireCell {
         // back and exits it from the front.
         typedef std::deque<Data> Queue;
 
-        // Edges are just queues that can be shared.
-        typedef std::shared_ptr<Queue> Edge;
+        // An edge is a queue shared by the two ports it connects.
+        // The mutex guards the queue when the graph is executed by
+        // more than one thread.  Access it via Port methods.
+        //
+        // A nonzero capacity asks the executor to not call the tail
+        // node while the queue holds that many or more items.  The
+        // peak records the largest number of items ever queued.
+        struct EdgeQueue {
+            Queue queue;
+            mutable std::mutex mutex;
+            size_t capacity{0};
+            size_t peak{0};
+        };
+        typedef std::shared_ptr<EdgeQueue> Edge;
 
         class Node;
 
@@ -45,6 +58,10 @@ namespace WireCell {
             // Return true if queue is empty or no edge has been plugged.
             bool empty() const;
 
+            // Return true if the edge has a capacity and its queue
+            // is filled to it.
+            bool full() const;
+
             // Get the next data.  By default this pops the data off
             // the queue.  To "peek" at the data, pas false.
             Data get(bool pop = true);
@@ -52,6 +69,13 @@ namespace WireCell {
             // Put the data onto the queue.
             void put(Data& data);
 
+            // Return a copy of all data currently in the queue
+            // without removing it.
+            Queue contents() const;
+
+            // Put all data from the queue onto the edge queue.
+            void put(const Queue& queue);
+
             // Get back the associated Node.
             Node* node();
             const Node* node() const;
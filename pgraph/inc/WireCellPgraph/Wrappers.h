@@ -15,9 +15,11 @@
 #include "WireCellIface/IFanoutNode.h"
 #include "WireCellIface/IFaninNode.h"
 #include "WireCellIface/IHydraNode.h"
+#include "WireCellIface/INamed.h"
 
 #include "WireCellUtil/Type.h"
 
+#include <algorithm>
 #include <map>
 #include <iostream>  // debug
 #include <sstream>
@@ -51,6 +53,9 @@ namespace WireCell {
                 for (auto sig : wcnode->output_types()) {
                     m_ports[Port::output].push_back(Pgraph::Port(this, Pgraph::Port::output, sig));
                 }
+                if (wcnode->concurrency() != 1) {
+                    set_concurrency(Node::reentrant);
+                }
             }
 
             virtual std::string ident()
@@ -72,6 +77,16 @@ namespace WireCell {
                 return ss.str();
             }
 
+            virtual std::string name()
+            {
+                std::string ret = WireCell::type(*(m_wcnode.get()));
+                auto named = std::dynamic_pointer_cast<INamed>(m_wcnode);
+                if (named and !named->get_name().empty()) {
+                    ret += ":" + named->get_name();
+                }
+                return ret;
+            }
+
            private:
             INode::pointer m_wcnode;
         };
@@ -323,18 +338,19 @@ namespace WireCell {
                     }
                 }
 
-                // 1) fill input any queue vector
+                // 1) fill input any queue vector.  Upstream nodes may
+                // add to the edges while we are called so remember how
+                // much of each we actually handed over.
                 IHydraNodeBase::any_queue_vector inqv(nin);
+                std::vector<size_t> given(nin, 0);
                 for (size_t ind = 0; ind < nin; ++ind) {
-                    Edge edge = iports[ind].edge();
-                    if (!edge) {
+                    if (!iports[ind].edge()) {
                         std::cerr << "Hydra: got broken edge\n";
                         continue;
                     }
-                    if (edge->empty()) {
-                        continue;
-                    }
-                    inqv[ind].insert(inqv[ind].begin(), edge->begin(), edge->end());
+                    auto queue = iports[ind].contents();
+                    given[ind] = queue.size();
+                    inqv[ind].insert(inqv[ind].begin(), queue.begin(), queue.end());
                 }
 
                 auto& oports = output_ports();
@@ -354,18 +370,18 @@ namespace WireCell {
                 // 4) pop dfp input queues to match.  BIG FAT
                 // WARNING: this trimming assumes calller only
                 // pop_front's.  Really should hunt for which ones
-                // have been removed.
+                // have been removed.  Only what was handed over may
+                // be popped as more may have arrived since.
                 for (size_t ind = 0; ind < nin; ++ind) {
-                    size_t want = inqv[ind].size();
-                    while (iports[ind].size() > want) {
+                    size_t left = std::min(given[ind], inqv[ind].size());
+                    for (size_t npop = given[ind] - left; npop; --npop) {
                         iports[ind].get();
                     }
                 }
 
                 // 5) send out output any queue vectors
                 for (size_t ind = 0; ind < nout; ++ind) {
-                    Edge edge = oports[ind].edge();
-                    edge->insert(edge->end(), outqv[ind].begin(), outqv[ind].end());
+                    oports[ind].put(outqv[ind]);
                 }
 
                 return true;
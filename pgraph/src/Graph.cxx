@@ -5,6 +5,13 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <ctime>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <limits>
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 
 using WireCell::demangle;
@@ -27,7 +34,7 @@ void Graph::add_node(Node* node)
 
 void Graph::set_enable_em(bool flag) { m_enable_em = flag; }
 
-bool Graph::connect(Node* tail, Node* head, size_t tpind, size_t hpind)
+bool Graph::connect(Node* tail, Node* head, size_t tpind, size_t hpind, size_t capacity)
 {
     Port& tport = tail->output_ports()[tpind];
     Port& hport = head->input_ports()[hpind];
@@ -38,7 +45,9 @@ bool Graph::connect(Node* tail, Node* head, size_t tpind, size_t hpind)
     }
 
     m_edges.push_back(std::make_pair(tail, head));
-    Edge edge = std::make_shared<Queue>();
+    Edge edge = std::make_shared<EdgeQueue>();
+    edge->capacity = capacity;
+    m_queues.push_back(edge);
 
     tport.plug(edge);
     hport.plug(edge);
@@ -117,13 +126,21 @@ bool Graph::execute()
         m_nodes_timer[node] = 0.0;
     }
 
+    // When relaxed, nodes with full output edges are called too.
+    bool relax = false;
     while (true) {
         int count = 0;
         bool did_something = false;
+        bool held_back = false;
 
         for (auto nit = nodes.rbegin(); nit != nodes.rend(); ++nit, ++count) {
             Node* node = *nit;
 
+            if (!relax and node->output_full()) {
+                held_back = true;
+                continue;
+            }
+
             auto start = std::clock();
 
             bool ok = call_node(node);
@@ -140,20 +157,159 @@ bool Graph::execute()
             }
         }
 
-        if (!did_something) {
-            return true;  // it's okay to do nothing.
+        if (did_something) {
+            relax = false;
+            continue;
         }
+        if (held_back and !relax) {
+            SPDLOG_LOGGER_TRACE(l, "relaxing edge capacity to avoid stall");
+            relax = true;
+            continue;
+        }
+        return true;  // it's okay to do nothing.
     }
     return true;  // shouldn't reach
 }
 
+bool Graph::execute_threaded(size_t nthreads)
+{
+    if (nthreads < 2) {
+        return execute();
+    }
+
+    // Prefer downstream nodes, as does execute(), to keep the amount
+    // of data in flight low.
+    auto nodes = sort_kahn();
+    std::reverse(nodes.begin(), nodes.end());
+    const size_t nnodes = nodes.size();
+    l->debug("executing with {} nodes on {} threads", nnodes, nthreads);
+
+    for (Node* node : nodes) {
+        m_nodes_timer[node] = 0.0;
+    }
+
+    // All scheduling state is guarded by the mutex.  The generation
+    // counts successful node calls.  A node which returned false is
+    // not called again until some other node has made progress.
+    const size_t never = std::numeric_limits<size_t>::max();
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<bool> busy(nnodes, false);
+    std::vector<size_t> idle_gen(nnodes, never);
+    size_t generation = 0;
+    size_t nrunning = 0;
+    size_t ncalls = 0;
+    bool serial_busy = false;
+    std::exception_ptr error;
+
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!error) {
+            size_t pick = never, held = never;
+            for (size_t ind = 0; ind < nnodes; ++ind) {
+                if (busy[ind] or idle_gen[ind] == generation) {
+                    continue;
+                }
+                if (serial_busy and nodes[ind]->concurrency() == Node::serial) {
+                    continue;
+                }
+                if (nodes[ind]->output_full()) {
+                    if (held == never) {
+                        held = ind;
+                    }
+                    continue;
+                }
+                pick = ind;
+                break;
+            }
+            if (pick == never and nrunning == 0) {
+                pick = held;    // relax back-pressure rather than stall
+            }
+            if (pick == never) {
+                if (nrunning == 0) {
+                    break;      // nothing can make progress
+                }
+                cv.wait(lock);
+                continue;
+            }
+
+            Node* node = nodes[pick];
+            const bool is_serial = node->concurrency() == Node::serial;
+            const size_t start_gen = generation;
+            busy[pick] = true;
+            ++nrunning;
+            if (is_serial) {
+                serial_busy = true;
+            }
+            lock.unlock();
+
+            bool ok = false;
+            std::exception_ptr eptr;
+            auto start = std::chrono::steady_clock::now();
+            try {
+                ok = call_node(node);
+            }
+            catch (...) {
+                eptr = std::current_exception();
+            }
+            std::chrono::duration<double> dt = std::chrono::steady_clock::now() - start;
+
+            lock.lock();
+            busy[pick] = false;
+            --nrunning;
+            if (is_serial) {
+                serial_busy = false;
+            }
+            m_nodes_timer[node] += dt.count();
+            if (eptr and !error) {
+                error = eptr;
+            }
+            if (ok) {
+                ++generation;
+                if (m_enable_em) {
+                    m_em(format("called %d: %s", ncalls, node->ident()));
+                }
+                ++ncalls;
+            }
+            else {
+                idle_gen[pick] = start_gen;
+            }
+            cv.notify_all();
+        }
+        cv.notify_all();
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t ind = 0; ind < nthreads; ++ind) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    l->debug("executed {} node calls on {} threads", ncalls, nthreads);
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return true;
+}
+
 bool Graph::call_node(Node* node)
 {
     if (!node) {
         l->error("graph call: got nullptr node");
         return false;
     }
+    long nin = 0;
+    TraceEvents::Stamp stamp;
+    if (m_trace) {
+        nin = node->input_size();
+        stamp = m_trace->start();
+    }
     bool ok = (*node)();
+    if (ok and m_trace) {
+        m_trace->stop(stamp, node->name(), nin, node->output_size());
+    }
     // this can be very noisy but useful to uncomment to understand
     // the graph execution order.
     if (ok) {
@@ -199,3 +355,15 @@ void Graph::print_timers(bool include_execmon) const
         l_timer->debug("ExecMon:\n{}", m_em.summary());
     }
 }
+
+void Graph::print_queues() const
+{
+    const size_t nedges = m_edges.size();
+    for (size_t ind = 0; ind < nedges; ++ind) {
+        const auto& [tail, head] = m_edges[ind];
+        const auto& edge = m_queues[ind];
+        std::lock_guard<std::mutex> lock(edge->mutex);
+        l->info("Queue: peak {} capacity {} : {} -> {}",
+                edge->peak, edge->capacity, tail->ident(), head->ident());
+    }
+}
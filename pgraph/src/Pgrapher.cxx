@@ -13,6 +13,11 @@ WireCell::Configuration Pgrapher::default_configuration() const
     Configuration cfg;
 
     cfg["edges"] = Json::arrayValue;
+    cfg["threads"] = m_threads;
+    cfg["edge_capacity"] = m_edge_capacity;
+    cfg["trace_file"] = m_trace_file;
+    // trace_rss defaults to true only when run on one thread.
+    cfg["concurrency"] = Json::objectValue;
     return cfg;
 }
 
@@ -52,6 +57,17 @@ void Pgrapher::configure(const WireCell::Configuration& cfg)
     m_verbosity = get(cfg, "verbosity", m_verbosity);
     m_graph.set_enable_em((m_verbosity == 2));
 
+    m_threads = get(cfg, "threads", m_threads);
+    m_edge_capacity = get(cfg, "edge_capacity", m_edge_capacity);
+    m_trace_file = get(cfg, "trace_file", m_trace_file);
+    if (m_trace_file.empty()) {
+        m_trace = nullptr;
+    }
+    else {
+        m_trace = std::make_shared<TraceEvents>(get(cfg, "trace_rss", m_threads < 2));
+    }
+    m_graph.set_trace(m_trace);
+
     Pgraph::Factory fac;
     log->debug("connecting: {} edges", cfg["edges"].size());
     for (auto jedge : cfg["edges"]) {
@@ -60,12 +76,39 @@ void Pgrapher::configure(const WireCell::Configuration& cfg)
 
         SPDLOG_LOGGER_TRACE(log, "connecting: {}", jedge);
 
-        bool ok = m_graph.connect(fac(tail.first), fac(head.first), tail.second, head.second);
+        const int capacity = get(jedge, "capacity", m_edge_capacity);
+        if (capacity < 0) {
+            raise<ValueError>("negative capacity for edge %s", edge_to_string(jedge["tail"], jedge["head"]));
+        }
+
+        bool ok = m_graph.connect(fac(tail.first), fac(head.first), tail.second, head.second, capacity);
         if (!ok) {
             log->critical("failed to connect edge: {}", jedge);
             raise<ValueError>("failed to connect edge %s", edge_to_string(jedge["tail"], jedge["head"]));
         }
     }
+
+    auto jcon = cfg["concurrency"];
+    for (const auto& tn : jcon.getMemberNames()) {
+        const std::string policy = jcon[tn].asString();
+        Node::Concurrency con = Node::stateful;
+        if (policy == "serial") {
+            con = Node::serial;
+        }
+        else if (policy == "reentrant") {
+            con = Node::reentrant;
+        }
+        else if (policy != "stateful") {
+            raise<ValueError>("unknown concurrency \"%s\" for node %s", policy, tn);
+        }
+        auto nptr = WireCell::Factory::find_maybe_tn<INode>(tn);
+        if (!nptr) {
+            raise<ValueError>("failed to get node \"%s\"", tn);
+        }
+        fac(nptr)->set_concurrency(con);
+        log->debug("node {} concurrency: {}", tn, policy);
+    }
+
     if (!m_graph.connected()) {
         log->critical("graph not fully connected");
         raise<ValueError>("graph not fully connected");
@@ -75,10 +118,20 @@ void Pgrapher::configure(const WireCell::Configuration& cfg)
 void Pgrapher::execute()
 {
     log->debug("executing graph");
-    m_graph.execute();
+    if (m_threads > 1) {
+        m_graph.execute_threaded(m_threads);
+    }
+    else {
+        m_graph.execute();
+    }
     log->debug("graph execution complete");
+    if (m_trace) {
+        log->debug("writing trace events to {}", m_trace_file);
+        m_trace->write(m_trace_file);
+    }
     if (m_verbosity) {
         m_graph.print_timers(m_verbosity == 2);
+        m_graph.print_queues();
     }
 }
 
@@ -2,6 +2,7 @@
 #include "WireCellUtil/Type.h"
 
 #include <sstream>
+#include <algorithm>
 
 #include <iostream>
 
@@ -37,16 +38,27 @@ size_t Port::size() const
     if (!m_edge) {
         return 0;
     }
-    return m_edge->size();
+    std::lock_guard<std::mutex> lock(m_edge->mutex);
+    return m_edge->queue.size();
 }
 
 // Return true if queue is empty or no edge has been plugged.
 bool Port::empty() const
 {
-    if (!m_edge or m_edge->empty()) {
+    if (!m_edge) {
         return true;
     }
-    return false;
+    std::lock_guard<std::mutex> lock(m_edge->mutex);
+    return m_edge->queue.empty();
+}
+
+bool Port::full() const
+{
+    if (!m_edge or !m_edge->capacity) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_edge->mutex);
+    return m_edge->queue.size() >= m_edge->capacity;
 }
 
 // Get the next data.  By default this pops the data off
@@ -59,12 +71,14 @@ Data Port::get(bool pop)
     if (!m_edge) {
         THROW(RuntimeError() << errmsg{"port has no edge"});
     }
-    if (m_edge->empty()) {
+    std::lock_guard<std::mutex> lock(m_edge->mutex);
+    auto& queue = m_edge->queue;
+    if (queue.empty()) {
         THROW(RuntimeError() << errmsg{"edge is empty"});
     }
-    Data ret = m_edge->front();
+    Data ret = queue.front();
     if (pop) {
-        m_edge->pop_front();
+        queue.pop_front();
     }
     return ret;
 }
@@ -78,7 +92,31 @@ void Port::put(Data& data)
     if (!m_edge) {
         THROW(RuntimeError() << errmsg{"port has no edge"});
     }
-    m_edge->push_back(data);
+    std::lock_guard<std::mutex> lock(m_edge->mutex);
+    m_edge->queue.push_back(data);
+    m_edge->peak = std::max(m_edge->peak, m_edge->queue.size());
+}
+
+Queue Port::contents() const
+{
+    if (!m_edge) {
+        THROW(RuntimeError() << errmsg{"port has no edge"});
+    }
+    std::lock_guard<std::mutex> lock(m_edge->mutex);
+    return m_edge->queue;
+}
+
+void Port::put(const Queue& queue)
+{
+    if (isinput()) {
+        THROW(RuntimeError() << errmsg{"can not put to input port"});
+    }
+    if (!m_edge) {
+        THROW(RuntimeError() << errmsg{"port has no edge"});
+    }
+    std::lock_guard<std::mutex> lock(m_edge->mutex);
+    m_edge->queue.insert(m_edge->queue.end(), queue.begin(), queue.end());
+    m_edge->peak = std::max(m_edge->peak, m_edge->queue.size());
 }
 
 const std::string& Port::name() const { return m_name; }
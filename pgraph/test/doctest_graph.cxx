@@ -1,11 +1,14 @@
 #include "WireCellUtil/Logging.h"
 #include "WireCellPgraph/Graph.h"
+#include "WireCellPgraph/Wrappers.h"
 #include "WireCellUtil/doctest.h"
 #include "WireCellUtil/String.h"
 
 #include <boost/container_hash/hash.hpp>
 
 #include <sstream>
+#include <thread>
+#include <chrono>
 
 using namespace WireCell;
 using spdlog::debug;
@@ -304,3 +307,170 @@ TEST_CASE("pgraph original pipegraph test")
     REQUIRE(cs1 == cs3);
     REQUIRE(cs2 == cs4);
 }
+
+// A sink which keeps what it receives.
+class Keeper : public IdNode {
+   public:
+    Keeper(int id)
+      : IdNode("kep", id, 1, 0)
+    {
+    }
+    virtual bool operator()()
+    {
+        if (iport().empty()) {
+            return false;
+        }
+        kept.push_back(boost::any_cast<int>(iport().get()));
+        return true;
+    }
+    std::vector<int> kept;
+};
+
+static void do_threaded(size_t nthreads, bool serial)
+{
+    using Pgraph::Graph;
+    using Pgraph::Node;
+
+    const int nbranches = 4, nper = 100;
+    std::vector<std::shared_ptr<IdNode>> nodes;
+    std::vector<std::shared_ptr<Keeper>> keepers;
+
+    Graph g;
+    int count = 0;
+    for (int ibr = 0; ibr < nbranches; ++ibr) {
+        auto src = std::make_shared<Source>(count++, ibr * nper, (ibr + 1) * nper);
+        auto fun1 = std::make_shared<Func>(count++);
+        auto fun2 = std::make_shared<Func>(count++);
+        auto kep = std::make_shared<Keeper>(count++);
+        if (serial) {
+            fun1->set_concurrency(Node::serial);
+        }
+        g.connect(src.get(), fun1.get());
+        g.connect(fun1.get(), fun2.get());
+        g.connect(fun2.get(), kep.get());
+        nodes.insert(nodes.end(), {src, fun1, fun2});
+        keepers.push_back(kep);
+    }
+
+    g.execute_threaded(nthreads);
+
+    for (int ibr = 0; ibr < nbranches; ++ibr) {
+        const auto& kept = keepers[ibr]->kept;
+        REQUIRE(kept.size() == nper);
+        for (int ind = 0; ind < nper; ++ind) {
+            REQUIRE(kept[ind] == ibr * nper + ind);
+        }
+    }
+}
+
+TEST_CASE("pgraph threaded execution")
+{
+    do_threaded(1, false);
+    do_threaded(4, false);
+    do_threaded(4, true);
+}
+
+// A keeper which takes its time.
+class SlowKeeper : public Keeper {
+   public:
+    SlowKeeper(int id)
+      : Keeper(id)
+    {
+    }
+    virtual bool operator()()
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        return Keeper::operator()();
+    }
+};
+
+// A keeper which refuses to consume anything until its input edge
+// holds a given number of items.  Needs a second thread to run the
+// upstream node.
+class GatedKeeper : public Keeper {
+   public:
+    GatedKeeper(int id, size_t until)
+      : Keeper(id)
+      , m_until(until)
+    {
+    }
+    virtual bool operator()()
+    {
+        while (m_until and iport().size() < m_until) {
+            std::this_thread::sleep_for(std::chrono::microseconds(10));
+        }
+        m_until = 0;
+        return Keeper::operator()();
+    }
+
+   private:
+    size_t m_until;
+};
+
+static size_t do_capacity(size_t nthreads, size_t capacity, bool gated = false)
+{
+    const int num = 100;
+    auto src = std::make_shared<Source>(0, 0, num);
+    std::shared_ptr<Keeper> kep;
+    if (gated) {
+        kep = std::make_shared<GatedKeeper>(1, num);
+    }
+    else {
+        kep = std::make_shared<SlowKeeper>(1);
+    }
+
+    Pgraph::Graph g;
+    g.connect(src.get(), kep.get(), 0, 0, capacity);
+    g.execute_threaded(nthreads);
+
+    REQUIRE(kep->kept.size() == num);
+    for (int ind = 0; ind < num; ++ind) {
+        REQUIRE(kep->kept[ind] == ind);
+    }
+    auto edge = src->oport().edge();
+    std::lock_guard<std::mutex> lock(edge->mutex);
+    return edge->peak;
+}
+
+TEST_CASE("pgraph edge capacity")
+{
+    REQUIRE(do_capacity(1, 0) == 1);
+    REQUIRE(do_capacity(1, 3) == 1);
+    REQUIRE(do_capacity(2, 3) <= 3);
+    // Unbounded, a stalled consumer lets the whole stream pile up.
+    REQUIRE(do_capacity(2, 0, true) == 100);
+}
+
+// A hydra which takes only the front of its input queue on each call
+// and which is slow enough that its upstream keeps pushing meanwhile.
+class TakeOneHydra : public IHydraNodeBase {
+   public:
+    virtual std::string signature() { return typeid(IHydraNodeBase).name(); }
+    virtual std::vector<std::string> input_types() { return {"int"}; }
+    virtual std::vector<std::string> output_types() { return {"int"}; }
+    virtual bool operator()(any_queue_vector& inqs, any_queue_vector& outqs)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        outqs[0].push_back(inqs[0].front());
+        inqs[0].pop_front();
+        return true;
+    }
+};
+
+TEST_CASE("pgraph threaded hydra keeps late input")
+{
+    const int num = 200;
+    auto src = std::make_shared<Source>(0, 0, num);
+    auto hyd = std::make_shared<Pgraph::Hydra>(std::make_shared<TakeOneHydra>());
+    auto kep = std::make_shared<Keeper>(1);
+
+    Pgraph::Graph g;
+    g.connect(src.get(), hyd.get());
+    g.connect(hyd.get(), kep.get());
+    g.execute_threaded(3);
+
+    REQUIRE(kep->kept.size() == num);
+    for (int ind = 0; ind < num; ++ind) {
+        REQUIRE(kep->kept[ind] == ind);
+    }
+}
@@ -93,6 +93,8 @@ namespace WireCell {
                 /** Filter in place a group of signals together. */
                 virtual WireCell::Waveform::ChannelMaskMap apply(channel_signals_t& chansig) const;
 
+                virtual bool thread_safe() const { return true; }
+
                private:
                 float m_rms_threshold;
                 float m_correlation_threshold;
@@ -123,6 +125,8 @@ namespace WireCell {
                 /** Filter in place a group of signals together. */
                 virtual WireCell::Waveform::ChannelMaskMap apply(channel_signals_t& chansig) const;
 
+                virtual bool thread_safe() const { return true; }
+
                private:
                 Diagnostics::Chirp m_check_chirp;      // fixme, these should be done via service interfaces
                 Diagnostics::Partial m_check_partial;  // at least need to expose them to configuration
@@ -140,6 +144,8 @@ namespace WireCell {
                 /** Filter in place a group of signals together. */
                 virtual WireCell::Waveform::ChannelMaskMap apply(channel_signals_t& chansig) const;
 
+                virtual bool thread_safe() const { return true; }
+
                 virtual void configure(const WireCell::Configuration& config);
                 virtual WireCell::Configuration default_configuration() const;
 
@@ -167,6 +173,8 @@ namespace WireCell {
                 /** Filter in place a group of signals together. */
                 virtual WireCell::Waveform::ChannelMaskMap apply(channel_signals_t& chansig) const;
 
+                virtual bool thread_safe() const { return true; }
+
                 virtual void configure(const WireCell::Configuration& config);
                 virtual WireCell::Configuration default_configuration() const;
 
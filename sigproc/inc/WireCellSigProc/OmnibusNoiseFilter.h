@@ -14,6 +14,7 @@
 
 #include "WireCellUtil/Waveform.h"
 #include "WireCellAux/Logger.h"
+#include "WireCellAux/SimpleTrace.h"
 
 #include <vector>
 #include <map>
@@ -27,6 +28,11 @@ namespace WireCell {
            objects. The first series is applied on a per-channel basis and
            the second is applied on groups of channels as determined by
            its channel grouping.
+
+           With "nthreads" > 1, channels, and disjoint groups of one
+           multi-group set, are filtered concurrently when all filters
+           of the stage are IChannelFilter::thread_safe().  Masks are
+           merged in the serial order so output does not change.
         */
         class OmnibusNoiseFilter : public Aux::Logger,
                                    public WireCell::IFrameFilter,
@@ -65,6 +71,13 @@ namespace WireCell {
             std::map<std::string, std::string> m_maskmap;
 
             size_t m_count{0};
+            size_t m_nthreads{1};
+
+            // Apply per-channel filters to the working traces, possibly
+            // in parallel, and merge their masks into cmm.
+            void apply_perchan(const std::vector<IChannelFilter::pointer>& filters,
+                               const std::vector<Aux::SimpleTrace*>& working,
+                               Waveform::ChannelMaskMap& cmm);
 
             // This little struct, named MGCF (Multi-Group Channel Filters), is used to associate a set of
             // channels with a set of filters. See: https://github.com/WireCell/wire-cell-toolkit/issues/327
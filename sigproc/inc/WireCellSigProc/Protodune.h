@@ -51,6 +51,8 @@ namespace WireCell {
                 /** Filter in place a group of signals together. */
                 virtual WireCell::Waveform::ChannelMaskMap apply(channel_signals_t& chansig) const;
 
+                virtual bool thread_safe() const { return true; }
+
                 virtual void configure(const WireCell::Configuration& config);
                 virtual WireCell::Configuration default_configuration() const;
 
@@ -81,6 +83,8 @@ namespace WireCell {
                 /** Filter in place a group of signals together. */
                 virtual WireCell::Waveform::ChannelMaskMap apply(channel_signals_t& chansig) const;
 
+                virtual bool thread_safe() const { return true; }
+
                 void configure(const WireCell::Configuration& config);
                 WireCell::Configuration default_configuration() const;
 
@@ -109,6 +113,8 @@ namespace WireCell {
                 /** Filter in place a group of signals together. */
                 virtual WireCell::Waveform::ChannelMaskMap apply(channel_signals_t& chansig) const;
 
+                virtual bool thread_safe() const { return true; }
+
                 virtual void configure(const WireCell::Configuration& config);
                 virtual WireCell::Configuration default_configuration() const;
 
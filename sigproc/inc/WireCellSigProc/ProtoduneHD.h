@@ -62,6 +62,8 @@ namespace WireCell {
                 /** Filter in place a group of signals together. */
                 virtual WireCell::Waveform::ChannelMaskMap apply(channel_signals_t& chansig) const;
 
+                virtual bool thread_safe() const { return true; }
+
                 void configure(const WireCell::Configuration& config);
                 WireCell::Configuration default_configuration() const;
 
@@ -94,6 +96,8 @@ namespace WireCell {
                 /** Filter in place a group of signals together. */
                 virtual WireCell::Waveform::ChannelMaskMap apply(channel_signals_t& chansig) const;
 
+                virtual bool thread_safe() const { return true; }
+
                private:
                 std::string m_anode_tn, m_noisedb_tn;
                 IAnodePlane::pointer m_anode;
@@ -122,6 +126,8 @@ namespace WireCell {
  
                 /** Filter in place a group of signals together. */
                 virtual WireCell::Waveform::ChannelMaskMap apply(channel_signals_t& chansig) const;
+
+                virtual bool thread_safe() const { return true; }
  
                private:
                 std::string m_anode_tn;
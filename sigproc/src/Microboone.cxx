@@ -9,6 +9,7 @@
 
 #include "WireCellUtil/NamedFactory.h"
 
+#include <atomic>
 #include <cmath>
 #include <complex>
 #include <iostream>
@@ -919,7 +920,7 @@ WireCell::Waveform::ChannelMaskMap Microboone::OneChannelNoise::apply(int ch, si
     // sanity check data/config match.
     const size_t nsiglen = signal.size();
     int nmismatchlen = 0;
-    static bool warn_once{true};
+    static std::atomic<bool> warn_once{true};
 
     // fixme: some channels are just bad can should be skipped.
 
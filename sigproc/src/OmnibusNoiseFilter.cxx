@@ -12,7 +12,10 @@
 
 #include "WireCellAux/FrameTools.h"
 
+#include "WireCellUtil/Parallel.h"
+
 #include <unordered_map>
+#include <unordered_set>
 
 WIRECELL_FACTORY(OmnibusNoiseFilter,
                  WireCell::SigProc::OmnibusNoiseFilter,
@@ -24,6 +27,31 @@ using namespace WireCell;
 
 using namespace WireCell::SigProc;
 
+// True if all filters may apply concurrently.
+static bool all_thread_safe(const std::vector<IChannelFilter::pointer>& filters)
+{
+    for (const auto& filter : filters) {
+        if (!filter->thread_safe()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// True if no channel is in more than one group.
+static bool disjoint(const std::vector<const IChannelNoiseDatabase::channel_group_t*>& groups)
+{
+    std::unordered_set<int> seen;
+    for (const auto* group : groups) {
+        for (int ch : *group) {
+            if (!seen.insert(ch).second) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 OmnibusNoiseFilter::OmnibusNoiseFilter(std::string intag, std::string outtag)
   : Aux::Logger("OmnibusNoiseFilter", "sigproc")
   , m_nticks(0)
@@ -99,6 +127,18 @@ void OmnibusNoiseFilter::configure(const WireCell::Configuration& cfg)
 
     m_intag = get(cfg, "intraces", m_intag);
     m_outtag = get(cfg, "outtraces", m_outtag);
+
+    m_nthreads = std::max(1, get(cfg, "nthreads", (int) m_nthreads));
+    if (m_nthreads > 1) {
+        std::vector<IChannelFilter::pointer> all(m_perchan);
+        all.insert(all.end(), m_perchan_status.begin(), m_perchan_status.end());
+        for (const auto& mgcf : m_multigroup_chanfilters) {
+            all.insert(all.end(), mgcf.filters.begin(), mgcf.filters.end());
+        }
+        if (!all_thread_safe(all)) {
+            log->debug("some filters are not thread safe, their stages will run serially");
+        }
+    }
 }
 
 WireCell::Configuration OmnibusNoiseFilter::default_configuration() const
@@ -119,9 +159,40 @@ WireCell::Configuration OmnibusNoiseFilter::default_configuration() const
     // The tags for input and output traces
     cfg["intraces"] = m_intag;
     cfg["outtraces"] = m_outtag;
+
+    // Number of threads with which to apply per-channel and grouped
+    // filters.  A stage runs serially unless all of its filters are
+    // thread safe.  Results do not depend on this.
+    cfg["nthreads"] = (int) m_nthreads;
     return cfg;
 }
 
+void OmnibusNoiseFilter::apply_perchan(const std::vector<IChannelFilter::pointer>& filters,
+                                       const std::vector<Aux::SimpleTrace*>& working,
+                                       Waveform::ChannelMaskMap& cmm)
+{
+    if (filters.empty()) {
+        return;
+    }
+    const size_t nthreads = all_thread_safe(filters) ? m_nthreads : 1;
+
+    // Masks are kept by channel and filter so they may be merged in
+    // the same order as a serial run.
+    std::vector<std::vector<Waveform::ChannelMaskMap>> masks(working.size());
+    Parallel::for_each(working.size(), nthreads, [&](size_t ind) {
+        auto trace = working[ind];
+        for (auto filter : filters) {
+            // fixme: probably should assure these masks do not lead to out-of-bounds...
+            masks[ind].push_back(filter->apply(trace->channel(), trace->charge()));
+        }
+    });
+    for (auto& chan_masks : masks) {
+        for (auto& one : chan_masks) {
+            Waveform::merge(cmm, one, m_maskmap);
+        }
+    }
+}
+
 bool OmnibusNoiseFilter::operator()(const input_pointer& inframe, output_pointer& outframe)
 {
     if (!inframe) {  // eos
@@ -174,12 +245,14 @@ bool OmnibusNoiseFilter::operator()(const input_pointer& inframe, output_pointer
 
     // Collect our working area indexed by channel.
     std::unordered_map<int, Aux::SimpleTrace*> bychan;
+    std::vector<Aux::SimpleTrace*> working;
     for (auto trace : traces) {
         int ch = trace->channel();
 
         // make working area directly in simple trace to avoid memory fragmentation
         auto signal = new Aux::SimpleTrace(ch, 0, m_nticks);
         bychan[ch] = signal;
+        working.push_back(signal);
 
         // if good
         if (find(bad_channels.begin(), bad_channels.end(), ch) == bad_channels.end()) {
@@ -193,19 +266,11 @@ bool OmnibusNoiseFilter::operator()(const input_pointer& inframe, output_pointer
                 nchanged_samples += std::abs((int) m_nticks - (int) ncharges);
             }
         }
-
-        int filt_count = 0;
-        for (auto filter : m_perchan) {
-            auto masks = filter->apply(ch, signal->charge());
-
-            // fixme: probably should assure these masks do not lead to out-of-bounds...
-
-            Waveform::merge(cmm, masks, m_maskmap);
-            ++filt_count;
-        }
     }
     traces.clear();  // done with our copy of vector of shared pointers
 
+    apply_perchan(m_perchan, working, cmm);
+
     if (nchanged_samples) {
         log->warn("warning, truncated or extended {} samples", nchanged_samples);
     }
@@ -213,34 +278,50 @@ bool OmnibusNoiseFilter::operator()(const input_pointer& inframe, output_pointer
     // int group_counter = 0;
     int nunknownchans = 0;
     for (const auto& mgcf : m_multigroup_chanfilters) {
-        for (auto group : mgcf.channelgroups) {
-
+        // Complete groups in their configured order.
+        std::vector<const IChannelNoiseDatabase::channel_group_t*> groups;
+        for (const auto& group : mgcf.channelgroups) {
             int flag = 1;
-
-            IChannelFilter::channel_signals_t chgrp;
             for (auto ch : group) {  // fix me: check if we don't actually have this channel
-                                    // std::cout << group_counter << " " << ch << " " << std::endl;
                 if (bychan.find(ch) == bychan.end()) {
                     ++nunknownchans;
                     flag = 0;
                 }
-                else {
-                    chgrp[ch] = bychan[ch]->charge();  // copy...
-                }
             }
             if (flag == 0) continue;
+            groups.push_back(&group);
+        }
+
+        // Groups sharing a channel see each other's output and must
+        // be filtered in order.
+        size_t nthreads = m_nthreads;
+        if (nthreads > 1 and !(all_thread_safe(mgcf.filters) and disjoint(groups))) {
+            nthreads = 1;
+        }
+
+        // Masks are kept by group and filter so they may be merged in
+        // the same order as a serial run.
+        std::vector<std::vector<Waveform::ChannelMaskMap>> masks(groups.size());
+        Parallel::for_each(groups.size(), nthreads, [&](size_t igroup) {
+            IChannelFilter::channel_signals_t chgrp;
+            for (auto ch : *groups[igroup]) {
+                chgrp[ch] = bychan.at(ch)->charge();  // copy...
+            }
 
             for (auto filter : mgcf.filters) {
-                auto masks = filter->apply(chgrp);
-                Waveform::merge(cmm, masks, m_maskmap);
+                masks[igroup].push_back(filter->apply(chgrp));
             }
 
             for (auto cs : chgrp) {
                 // cs.second; // copy
-                bychan[cs.first]->charge().assign(cs.second.begin(), cs.second.end());
+                bychan.at(cs.first)->charge().assign(cs.second.begin(), cs.second.end());
             }
-
-        } // end of channel groups
+        });
+        for (auto& group_masks : masks) {
+            for (auto& one : group_masks) {
+                Waveform::merge(cmm, one, m_maskmap);
+            }
+        }
 
     } // end of MGCF
 
@@ -249,15 +330,11 @@ bool OmnibusNoiseFilter::operator()(const input_pointer& inframe, output_pointer
     }
 
     // run status
+    std::vector<Aux::SimpleTrace*> status_working;
     for (auto& it : bychan) {
-        const int ch = it.first;
-        IChannelFilter::signal_t& signal = it.second->charge();
-        for (auto filter : m_perchan_status) {
-            auto masks = filter->apply(ch, signal);
-
-            Waveform::merge(cmm, masks, m_maskmap);
-        }
+        status_working.push_back(it.second);
     }
+    apply_perchan(m_perchan_status, status_working, cmm);
 
     ITrace::vector itraces;
     for (auto& cs : bychan) {  // fixme: that tbin though
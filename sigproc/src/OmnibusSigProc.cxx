@@ -17,10 +17,9 @@
 #include "WireCellUtil/Exceptions.h"
 #include "WireCellUtil/String.h"
 #include "WireCellUtil/FFTBestLength.h"
+#include "WireCellUtil/Parallel.h"
 #include "WireCellUtil/Waveform.h"
 
-#include "WireCellUtil/NamedFactory.h"
-
 WIRECELL_FACTORY(OmnibusSigProc, WireCell::SigProc::OmnibusSigProc,
                  WireCell::INamed,
                  WireCell::IFrameFilter, WireCell::IConfigurable)
@@ -173,6 +172,10 @@ void OmnibusSigProc::configure(const WireCell::Configuration& config)
     m_use_roi_debug_mode = get(config, "use_roi_debug_mode", m_use_roi_debug_mode);
     m_save_negative_charge = get(config, "save_negative_charge", m_save_negative_charge);
     m_use_roi_refinement = get(config, "use_roi_refinement", m_use_roi_refinement);
+    m_parallel_planes = get(config, "parallel_planes", m_parallel_planes);
+    if (m_parallel_planes and m_use_roi_debug_mode) {
+        log->warn("parallel_planes is ignored in ROI debug mode");
+    }
     m_tight_lf_tag = get(config, "tight_lf_tag", m_tight_lf_tag);
     m_loose_lf_tag = get(config, "loose_lf_tag", m_loose_lf_tag);
     m_cleanup_roi_tag = get(config, "cleanup_roi_tag", m_cleanup_roi_tag);
@@ -337,6 +340,9 @@ WireCell::Configuration OmnibusSigProc::default_configuration() const
 
     cfg["use_roi_debug_mode"] = m_use_roi_debug_mode;  // default false
     cfg["use_roi_refinement"] = m_use_roi_refinement;  // default true
+    // If true, run the per-plane decon and ROI formation stages on
+    // one thread per plane.  Results do not depend on this.
+    cfg["parallel_planes"] = m_parallel_planes;  // default false
     cfg["tight_lf_tag"] = m_tight_lf_tag;
     cfg["loose_lf_tag"] = m_loose_lf_tag;
     cfg["cleanup_roi_tag"] = m_cleanup_roi_tag;
@@ -367,20 +373,27 @@ void OmnibusSigProc::load_data(const input_pointer& in, int plane)
 
     auto traces = in->traces();
 
-    auto& bad = m_wanmm["bad"];
+    // Only read shared maps here as planes may be loaded concurrently.
+    static const Waveform::ChannelMasks no_masks;
+    auto badit = m_wanmm.find("bad");
+    const auto& bad = badit == m_wanmm.end() ? no_masks : badit->second;
     int nbad = 0;
 
     for (auto trace : *traces.get()) {
         int wct_channel_ident = trace->channel();
-        OspChan och = m_channel_map[wct_channel_ident];
+        auto chit = m_channel_map.find(wct_channel_ident);
+        if (chit == m_channel_map.end()) {
+            continue;  // in case user gives us multi apa frame
+        }
+        const OspChan& och = chit->second;
         if (plane != och.plane) {
             continue;  // we'll catch it in another call to load_data
         }
 
         // fixme: this code uses tbin() but other places in this file will barf if tbin!=0.
         int tbin = trace->tbin();
-        auto const& charges = trace->charge();
-        const int ntbins = std::min((int) charges.size(), m_nticks);
+        const float* charges = trace->samples();
+        const int ntbins = std::min((int) trace->nsamples(), m_nticks);
         for (int qind = 0; qind < ntbins; ++qind) {
             const float q = charges[qind];
             m_r_data[plane](och.wire + m_pad_nwires[plane], tbin + qind) = q;
@@ -1484,7 +1497,11 @@ bool OmnibusSigProc::masked_neighbors(const std::string& cmname, OspChan& ochan,
         return false;
     }
 
-    auto& cm = m_wanmm[cmname];
+    auto cmit = m_wanmm.find(cmname);
+    if (cmit == m_wanmm.end()) {
+        return false;
+    }
+    const auto& cm = cmit->second;
     for (int och = lo_chan; och <= hi_chan; ++och) {
         if (cm.find(och) != cm.end()) {
             return true;
@@ -1623,9 +1640,9 @@ bool OmnibusSigProc::operator()(const input_pointer& in, output_pointer& out)
     const std::vector<float>* perplane_thresholds[3] = {&roi_form.get_uplane_rms(), &roi_form.get_vplane_rms(),
                                                         &roi_form.get_wplane_rms()};
 
-    for (int iplane = 0; iplane != 3; ++iplane) {
-        auto it = std::find(m_process_planes.begin(), m_process_planes.end(), iplane);
-        if (it == m_process_planes.end()) continue;
+    // The per-plane stages up to ROI refinement touch only per-plane
+    // working data and may run concurrently.
+    auto plane_stages = [&](int iplane) {
         const std::vector<float>& perwire_rmses = *perplane_thresholds[iplane];
 
         // load data into EIGEN matrices ...
@@ -1696,9 +1713,7 @@ bool OmnibusSigProc::operator()(const input_pointer& in, output_pointer& out)
 
         check_data(iplane, "after 2D ROI refine");
 
-        // Refine ROIs
-        if (m_use_roi_refinement) roi_refine.load_data(iplane, m_r_data[iplane], roi_form);
-        else {
+        if (!m_use_roi_refinement) {
             /// TODO: streamline the logics
             // special case to dump decon without needs of ROIs
             if (m_use_roi_debug_mode and !m_decon_charge_tag.empty()) {
@@ -1708,6 +1723,33 @@ bool OmnibusSigProc::operator()(const input_pointer& in, output_pointer& out)
             m_c_data[iplane].resize(0, 0);  // clear memory
             m_r_data[iplane].resize(0, 0);  // clear memory
         }
+    };
+
+    std::vector<int> planes;
+    for (int iplane = 0; iplane != 3; ++iplane) {
+        auto it = std::find(m_process_planes.begin(), m_process_planes.end(), iplane);
+        if (it == m_process_planes.end()) continue;
+        planes.push_back(iplane);
+    }
+
+    // Debug mode saves traces while the planes are processed so
+    // requires the planes to be visited in order.
+    if (m_parallel_planes and !m_use_roi_debug_mode and planes.size() > 1) {
+        Parallel::for_each(planes.size(), planes.size(), [&](size_t ind) {
+            plane_stages(planes[ind]);
+        });
+    }
+    else {
+        for (int iplane : planes) {
+            plane_stages(iplane);
+        }
+    }
+
+    // Refine ROIs.  The multi-plane stages below require all planes.
+    if (m_use_roi_refinement) {
+        for (int iplane : planes) {
+            roi_refine.load_data(iplane, m_r_data[iplane], roi_form);
+        }
     }
 
     if (m_use_roi_refinement) {
@@ -17,6 +17,7 @@
 
 #include "WireCellUtil/NamedFactory.h"
 
+#include <atomic>
 #include <cmath>
 #include <complex>
 #include <iostream>
@@ -772,7 +773,7 @@ WireCell::Waveform::ChannelMaskMap Protodune::OneChannelNoise::apply(int ch, sig
     bool is_partial = m_check_partial(spectrum);  // Xin's "IS_RC()"
 
     if (!is_partial) {
-        static bool warned = false;
+        static std::atomic<bool> warned{false};
         auto const& spec = m_noisedb->rcrc(ch);  // rc_layers set to 1 in channel noise db
         if (spec.size() == spectrum.size()) {
             WireCell::Waveform::shrink(spectrum, spec);
@@ -412,9 +412,9 @@ void ROI_formation::find_ROI_by_decon_itself(int plane, const Array::array_xxf&
             int ncount = 0;
             for (int icol = 0; icol != r_data.cols(); icol++) {
                 bool flag = true;
-                for (size_t i = 0; i != bad_ch_map[irow + offset].size(); i++) {
-                    if (icol >= bad_ch_map[irow + offset].at(i).first &&
-                        icol <= bad_ch_map[irow + offset].at(i).second) {
+                for (size_t i = 0; i != bad_ch_map.at(irow + offset).size(); i++) {
+                    if (icol >= bad_ch_map.at(irow + offset).at(i).first &&
+                        icol <= bad_ch_map.at(irow + offset).at(i).second) {
                         flag = false;
                         break;
                     }
@@ -709,9 +709,9 @@ void ROI_formation::find_ROI_loose(int plane, const Array::array_xxf& r_data)
             int ncount = 0;
             for (int icol = 0; icol != r_data.cols(); icol++) {
                 bool flag = true;
-                for (size_t i = 0; i != bad_ch_map[irow + offset].size(); i++) {
-                    if (icol >= bad_ch_map[irow + offset].at(i).first &&
-                        icol <= bad_ch_map[irow + offset].at(i).second) {
+                for (size_t i = 0; i != bad_ch_map.at(irow + offset).size(); i++) {
+                    if (icol >= bad_ch_map.at(irow + offset).at(i).first &&
+                        icol <= bad_ch_map.at(irow + offset).at(i).second) {
                         flag = false;
                         break;
                     }
@@ -82,38 +82,18 @@ ROI_refinement::~ROI_refinement() { Clear(); }
 
 void ROI_refinement::Clear()
 {
-    for (int i = 0; i != nwire_u; i++) {
-        for (auto it = rois_u_tight.at(i).begin(); it != rois_u_tight.at(i).end(); it++) {
-            delete *it;
-        }
-        rois_u_tight.at(i).clear();
-        for (auto it = rois_u_loose.at(i).begin(); it != rois_u_loose.at(i).end(); it++) {
-            delete *it;
-        }
-        rois_u_loose.at(i).clear();
-    }
-
-    for (int i = 0; i != nwire_v; i++) {
-        for (auto it = rois_v_tight.at(i).begin(); it != rois_v_tight.at(i).end(); it++) {
-            delete *it;
-        }
-        rois_v_tight.at(i).clear();
-        for (auto it = rois_v_loose.at(i).begin(); it != rois_v_loose.at(i).end(); it++) {
-            delete *it;
+    for (auto* lists : {&rois_u_tight, &rois_u_loose, &rois_v_tight, &rois_v_loose, &rois_w_tight}) {
+        for (auto& rois : *lists) {
+            rois.clear();
         }
-        rois_v_loose.at(i).clear();
-    }
-
-    for (int i = 0; i != nwire_w; i++) {
-        for (auto it = rois_w_tight.at(i).begin(); it != rois_w_tight.at(i).end(); it++) {
-            delete *it;
-        }
-        rois_w_tight.at(i).clear();
     }
 
     front_rois.clear();
     back_rois.clear();
     contained_rois.clear();
+
+    // All ROIs are owned by the pool.
+    pool.clear();
 }
 
 void ROI_refinement::apply_roi(int plane, Array::array_xxf &r_data)
@@ -317,10 +297,10 @@ void ROI_refinement::load_data(int plane, const Array::array_xxf &r_data, ROI_fo
         std::vector<std::pair<int, int>> &uboone_rois = roi_form.get_self_rois(irow + offset);
         for (size_t i = 0; i != uboone_rois.size(); i++) {
             SignalROI *tight_roi =
-                new SignalROI(plane, irow + offset, uboone_rois.at(i).first, uboone_rois.at(i).second, signal);
+                pool.make(plane, irow + offset, uboone_rois.at(i).first, uboone_rois.at(i).second, signal);
             float threshold = plane_rms.at(irow) * th_factor;
             if (tight_roi->get_above_threshold(threshold).size() == 0) {
-                delete tight_roi;
+                pool.release(tight_roi);
                 continue;
             }
 
@@ -491,10 +471,10 @@ void ROI_refinement::load_data(int plane, const Array::array_xxf &r_data, ROI_fo
             uboone_rois = roi_form.get_loose_rois(chid);
             for (size_t i = 0; i != uboone_rois.size(); i++) {
                 SignalROI *loose_roi =
-                    new SignalROI(plane, chid, uboone_rois.at(i).first, uboone_rois.at(i).second, signal);
+                    pool.make(plane, chid, uboone_rois.at(i).first, uboone_rois.at(i).second, signal);
                 float threshold = plane_rms.at(irow) * th_factor;
                 if (loose_roi->get_above_threshold(threshold).size() == 0) {
-                    delete loose_roi;
+                    pool.release(loose_roi);
                     continue;
                 }
                 if (plane == 0) {
@@ -780,7 +760,7 @@ void ROI_refinement::CleanUpROIs(int plane)
             for (auto it = to_be_removed.begin(); it != to_be_removed.end(); it++) {
                 auto it1 = find(rois_u_loose.at(i).begin(), rois_u_loose.at(i).end(), *it);
                 rois_u_loose.at(i).erase(it1);
-                delete (*it);
+                pool.release(*it);
             }
         }
     }
@@ -860,7 +840,7 @@ void ROI_refinement::CleanUpROIs(int plane)
             for (auto it = to_be_removed.begin(); it != to_be_removed.end(); it++) {
                 auto it1 = find(rois_v_loose.at(i).begin(), rois_v_loose.at(i).end(), *it);
                 rois_v_loose.at(i).erase(it1);
-                delete (*it);
+                pool.release(*it);
             }
         }
     }
@@ -903,7 +883,7 @@ void ROI_refinement::generate_merge_ROIs(int plane)
             for (auto it = saved_rois.begin(); it != saved_rois.end(); it++) {
                 SignalROI *roi = *it;
                 // Duplicate them
-                SignalROI *loose_roi = new SignalROI(roi);
+                SignalROI *loose_roi = pool.make(roi);
 
                 rois_u_loose.at(i).push_back(loose_roi);
 
@@ -1044,7 +1024,7 @@ void ROI_refinement::generate_merge_ROIs(int plane)
             for (auto it = saved_rois.begin(); it != saved_rois.end(); it++) {
                 SignalROI *roi = *it;
                 // Duplicate them
-                SignalROI *loose_roi = new SignalROI(roi);
+                SignalROI *loose_roi = pool.make(roi);
 
                 rois_v_loose.at(i).push_back(loose_roi);
 
@@ -1362,7 +1342,7 @@ void ROI_refinement::CleanUpCollectionROIs()
         auto it1 = find(rois_w_tight.at(chid).begin(), rois_w_tight.at(chid).end(), roi);
         if (it1 != rois_w_tight.at(chid).end()) rois_w_tight.at(chid).erase(it1);
 
-        delete roi;
+        pool.release(roi);
     }
 }
 
@@ -1526,7 +1506,7 @@ void ROI_refinement::CleanUpInductionROIs(int plane)
             auto it1 = find(rois_u_loose.at(chid).begin(), rois_u_loose.at(chid).end(), roi);
             if (it1 != rois_u_loose.at(chid).end()) rois_u_loose.at(chid).erase(it1);
 
-            delete roi;
+            pool.release(roi);
         }
     }
     else if (plane == 1) {
@@ -1598,7 +1578,7 @@ void ROI_refinement::CleanUpInductionROIs(int plane)
             auto it1 = find(rois_v_loose.at(chid).begin(), rois_v_loose.at(chid).end(), roi);
             if (it1 != rois_v_loose.at(chid).end()) rois_v_loose.at(chid).erase(it1);
 
-            delete roi;
+            pool.release(roi);
         }
     }
 }
@@ -1767,7 +1747,7 @@ void ROI_refinement::ShrinkROI(SignalROI *roi, ROI_formation &roi_form)
 
     SignalROISelection new_rois;
     if (new_start_bin >= 0 && new_end_bin > new_start_bin) {
-        SignalROI *new_roi = new SignalROI(plane, chid, new_start_bin, new_end_bin, signal);
+        SignalROI *new_roi = pool.make(plane, chid, new_start_bin, new_end_bin, signal);
         new_rois.push_back(new_roi);
     }
 
@@ -1838,7 +1818,7 @@ void ROI_refinement::ShrinkROI(SignalROI *roi, ROI_formation &roi_form)
     }
 
     // delete the old ROI
-    delete roi;
+    pool.release(roi);
 
     // delete htemp;
     // delete h1;
@@ -2373,7 +2353,7 @@ void ROI_refinement::BreakROI1(SignalROI *roi)
             //      h1->SetBinContent(j+1,htemp->GetBinContent(j-start_bin+1));
         }
         if (start_bin1 >= 0 && end_bin1 > start_bin1) {
-            SignalROI *sub_roi = new SignalROI(plane, chid, start_bin1, end_bin1, signal);
+            SignalROI *sub_roi = pool.make(plane, chid, start_bin1, end_bin1, signal);
             new_rois.push_back(sub_roi);
         }
     }
@@ -2443,7 +2423,7 @@ void ROI_refinement::BreakROI1(SignalROI *roi)
     }
 
     // delete the old ROI
-    delete roi;
+    pool.release(roi);
     //  delete h1;
     //  delete htemp;
 }
@@ -108,6 +108,9 @@ namespace WireCell {
             MapMPROI proteced_rois;  // using chid and start_bin as id
             MapMPROI mp_rois;        // using chid and start_bin as id
 
+            // Owns all ROIs in the lists and maps.
+            SignalROIPool pool;
+
             SignalROIMap front_rois;
             SignalROIMap back_rois;
             SignalROIMap contained_rois;
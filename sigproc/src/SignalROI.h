@@ -3,6 +3,8 @@
 
 #include "WireCellUtil/Waveform.h"
 
+#include <deque>
+#include <utility>
 #include <iostream>
 #include <vector>
 #include <list>
@@ -34,7 +36,12 @@ namespace WireCell {
             bool overlap(SignalROI* roi);
             bool overlap(SignalROI* roi1, float th, float th1);
 
+            // Dense index of this ROI in its SignalROIPool.
+            size_t get_index() const { return index; }
+            void set_index(size_t ind) { index = ind; }
+
            private:
+            size_t index{0};
             int plane;
             int chid;
             int start_bin;
@@ -50,7 +57,85 @@ namespace WireCell {
         typedef std::vector<SignalROI*> SignalROISelection;
         typedef std::vector<SignalROISelection> SignalROIChSelection;
         typedef std::vector<SignalROIList> SignalROIChList;
-        typedef std::map<SignalROI*, SignalROISelection> SignalROIMap;
+
+        /** An arena of ROIs.
+         *
+         * ROIs are never moved so pointers stay valid until clear().
+         * Each gets a dense index by which SignalROIMap is keyed.
+         */
+        class SignalROIPool {
+           public:
+            template <typename... Args>
+            SignalROI* make(Args&&... args)
+            {
+                m_rois.emplace_back(std::forward<Args>(args)...);
+                SignalROI* roi = &m_rois.back();
+                roi->set_index(m_rois.size() - 1);
+                return roi;
+            }
+
+            // Drop the contents of an ROI no longer in use.  Its slot
+            // is reclaimed by clear().
+            void release(SignalROI* roi) { std::vector<float>().swap(roi->get_contents()); }
+
+            void clear() { m_rois.clear(); }
+            size_t size() const { return m_rois.size(); }
+
+           private:
+            std::deque<SignalROI> m_rois;
+        };
+
+        /** Map an ROI to a selection of ROIs.
+         *
+         * This provides the subset of the std::map interface used for
+         * ROI contiguity but stores values in a vector indexed by the
+         * ROI pool index.  References to values stay valid as the map
+         * grows, as with std::map.
+         */
+        class SignalROIMap {
+           public:
+            typedef SignalROISelection* iterator;
+
+            iterator find(SignalROI* roi)
+            {
+                const size_t ind = roi->get_index();
+                if (ind < m_has.size() and m_has[ind]) {
+                    return &m_sel[ind];
+                }
+                return end();
+            }
+            iterator end() { return nullptr; }
+
+            SignalROISelection& operator[](SignalROI* roi)
+            {
+                const size_t ind = roi->get_index();
+                if (ind >= m_has.size()) {
+                    m_has.resize(ind + 1, false);
+                    m_sel.resize(ind + 1);
+                }
+                m_has[ind] = true;
+                return m_sel[ind];
+            }
+
+            void erase(SignalROI* roi)
+            {
+                const size_t ind = roi->get_index();
+                if (ind < m_has.size() and m_has[ind]) {
+                    m_has[ind] = false;
+                    m_sel[ind].clear();
+                }
+            }
+
+            void clear()
+            {
+                m_has.clear();
+                m_sel.clear();
+            }
+
+           private:
+            std::vector<bool> m_has;
+            std::deque<SignalROISelection> m_sel;
+        };
 
         struct CompareRois {
             bool operator()(SignalROI* roi1, SignalROI* roi2) const
@@ -0,0 +1,242 @@
+// OmnibusNoiseFilter gives the same frame with any "nthreads".
+#include "WireCellSigProc/OmnibusNoiseFilter.h"
+#include "WireCellSigProc/SimpleChannelNoiseDB.h"
+
+#include "WireCellAux/SimpleFrame.h"
+#include "WireCellAux/SimpleTrace.h"
+#include "WireCellAux/Testing.h"
+#include "WireCellIface/IChannelFilter.h"
+#include "WireCellIface/IChannelNoiseDatabase.h"
+#include "WireCellIface/IConfigurable.h"
+#include "WireCellUtil/NamedFactory.h"
+#include "WireCellUtil/PluginManager.h"
+#include "WireCellUtil/doctest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace WireCell;
+
+static const int nchannels = 64;
+static const int nticks = 500;
+
+// Subtract the mean and mark runs of ticks over threshold as noisy.
+class FakeChannelFilter : public IChannelFilter {
+  public:
+    virtual ~FakeChannelFilter() {}
+    virtual Waveform::ChannelMaskMap apply(int channel, signal_t& sig) const
+    {
+        const float mean = Waveform::mean_rms(sig).first;
+        for (auto& q : sig) {
+            q -= mean;
+        }
+        Waveform::ChannelMaskMap ret;
+        int beg = -1;
+        for (int ind = 0; ind <= (int) sig.size(); ++ind) {
+            const bool over = ind < (int) sig.size() and std::abs(sig[ind]) > 8;
+            if (over and beg < 0) {
+                beg = ind;
+            }
+            if (!over and beg >= 0) {
+                ret["noisy"][channel].push_back(Waveform::BinRange(beg, ind));
+                beg = -1;
+            }
+        }
+        if (Waveform::mean_rms(sig).second > 3) {
+            ret["lf_noisy"][channel].push_back(Waveform::BinRange(0, sig.size()));
+        }
+        return ret;
+    }
+    virtual Waveform::ChannelMaskMap apply(channel_signals_t& chansig) const { return {}; }
+    virtual bool thread_safe() const { return true; }
+};
+
+// Subtract the per-tick median of the group and mark where it was
+// large on the first channel of the group.
+class FakeGroupFilter : public IChannelFilter {
+  public:
+    virtual ~FakeGroupFilter() {}
+    virtual Waveform::ChannelMaskMap apply(int channel, signal_t& sig) const { return {}; }
+    virtual Waveform::ChannelMaskMap apply(channel_signals_t& chansig) const
+    {
+        Waveform::ChannelMaskMap ret;
+        const int first = chansig.begin()->first;
+        std::vector<float> tick;
+        for (int it = 0; it < nticks; ++it) {
+            tick.clear();
+            for (const auto& [ch, sig] : chansig) {
+                tick.push_back(sig[it]);
+            }
+            const float med = Waveform::median(tick);
+            for (auto& [ch, sig] : chansig) {
+                sig[it] -= med;
+            }
+            if (std::abs(med) > 2) {
+                ret["coherent"][first].push_back(Waveform::BinRange(it, it + 1));
+            }
+        }
+        return ret;
+    }
+    virtual bool thread_safe() const { return true; }
+};
+
+// Mark a channel with a large remaining excursion.
+class FakeStatusFilter : public IChannelFilter {
+  public:
+    virtual ~FakeStatusFilter() {}
+    virtual Waveform::ChannelMaskMap apply(int channel, signal_t& sig) const
+    {
+        Waveform::ChannelMaskMap ret;
+        auto mm = std::minmax_element(sig.begin(), sig.end());
+        if (*mm.second - *mm.first > 40) {
+            ret["noisy"][channel].push_back(Waveform::BinRange(0, sig.size()));
+        }
+        return ret;
+    }
+    virtual Waveform::ChannelMaskMap apply(channel_signals_t& chansig) const { return {}; }
+    virtual bool thread_safe() const { return true; }
+};
+
+// Channels in consecutive groups of the given size.
+static std::vector<std::vector<int>> make_groups(int size)
+{
+    std::vector<std::vector<int>> ret(nchannels / size);
+    for (int ch = 0; ch < nchannels; ++ch) {
+        ret[ch / size].push_back(ch);
+    }
+    return ret;
+}
+
+static void setup()
+{
+    static bool done = false;
+    if (done) {
+        return;
+    }
+    done = true;
+
+    PluginManager& pm = PluginManager::instance();
+    REQUIRE(pm.add("WireCellAux") != nullptr);
+    REQUIRE(pm.add("WireCellSigProc") != nullptr);
+
+    // Components are found, not made, by OmnibusNoiseFilter.
+    Testing::get_dft();
+    auto ndb = Factory::lookup<IChannelNoiseDatabase>("testChannelNoiseDB");
+    auto sndb = std::dynamic_pointer_cast<SigProc::SimpleChannelNoiseDB>(ndb);
+    REQUIRE(sndb);
+    auto cfgable = std::dynamic_pointer_cast<IConfigurable>(ndb);
+    cfgable->configure(cfgable->default_configuration());
+    sndb->set_sampling(0.5 * units::us, nticks);
+    sndb->set_channel_groups(make_groups(8));
+    sndb->set_bad_channels({5, 40});
+
+    make_named_factory_factory<FakeChannelFilter, IChannelFilter>("FakeChannelFilter");
+    Factory::lookup<IChannelFilter>("FakeChannelFilter");
+    make_named_factory_factory<FakeGroupFilter, IChannelFilter>("FakeGroupFilter");
+    Factory::lookup<IChannelFilter>("FakeGroupFilter");
+    make_named_factory_factory<FakeStatusFilter, IChannelFilter>("FakeStatusFilter");
+    Factory::lookup<IChannelFilter>("FakeStatusFilter");
+}
+
+// Noisy ADC with coherent noise over groups, some spikes and one
+// input mask.
+static IFrame::pointer make_frame()
+{
+    std::mt19937 gen(12345);
+    std::normal_distribution<float> noise(0, 2);
+    std::uniform_real_distribution<float> flat(0, 1);
+
+    std::vector<std::vector<float>> coherent(nchannels / 8, std::vector<float>(nticks));
+    for (auto& wave : coherent) {
+        for (auto& q : wave) {
+            q = 3 * noise(gen);
+        }
+    }
+
+    ITrace::vector traces;
+    for (int ch = 0; ch < nchannels; ++ch) {
+        ITrace::ChargeSequence adc(nticks);
+        const float baseline = 900 + 10 * ch;
+        for (int it = 0; it < nticks; ++it) {
+            adc[it] = baseline + noise(gen) + coherent[ch / 8][it];
+            if (flat(gen) < 0.01) {
+                adc[it] += 30;
+            }
+        }
+        traces.push_back(std::make_shared<Aux::SimpleTrace>(ch, 0, adc));
+    }
+    Waveform::ChannelMaskMap cmm;
+    cmm["bad"][3].push_back(Waveform::BinRange(10, 20));
+    auto sframe = std::make_shared<Aux::SimpleFrame>(1, 0, traces, 0.5 * units::us, cmm);
+    IFrame::trace_list_t indices(traces.size());
+    for (size_t ind = 0; ind < traces.size(); ++ind) {
+        indices[ind] = ind;
+    }
+    sframe->tag_traces("orig", indices);
+    return sframe;
+}
+
+static IFrame::pointer noise_filter(int nthreads)
+{
+    SigProc::OmnibusNoiseFilter onf;
+    auto cfg = onf.default_configuration();
+    cfg["nticks"] = nticks;
+    cfg["noisedb"] = "testChannelNoiseDB";
+    cfg["channel_filters"][0] = "FakeChannelFilter";
+    cfg["channel_status_filters"][0] = "FakeStatusFilter";
+    cfg["grouped_filters"][0] = "FakeGroupFilter";
+    Configuration mgcf;
+    for (const auto& group : make_groups(16)) {
+        Configuration jgroup = Json::arrayValue;
+        for (int ch : group) {
+            jgroup.append(ch);
+        }
+        mgcf["channelgroups"].append(jgroup);
+    }
+    mgcf["filters"][0] = "FakeGroupFilter";
+    cfg["multigroup_chanfilters"][0] = mgcf;
+    cfg["nthreads"] = nthreads;
+    onf.configure(cfg);
+
+    IFrame::pointer out;
+    REQUIRE(onf(make_frame(), out));
+    REQUIRE(out);
+    return out;
+}
+
+static ITrace::vector by_channel(const IFrame::pointer& frame)
+{
+    ITrace::vector ret(frame->traces()->begin(), frame->traces()->end());
+    std::sort(ret.begin(), ret.end(), [](const auto& a, const auto& b) { return a->channel() < b->channel(); });
+    return ret;
+}
+
+TEST_CASE("sigproc omnibus noise filter nthreads")
+{
+    setup();
+
+    auto serial = noise_filter(1);
+    auto threaded = noise_filter(4);
+
+    // Filters and the database all left their marks.
+    const auto masks = serial->masks();
+    REQUIRE(masks.count("bad"));
+    CHECK(masks.at("bad").count(3));
+    CHECK(masks.at("bad").count(5));
+    CHECK(masks.at("bad").count(40));
+    CHECK(masks.count("lf_noisy"));
+    CHECK(masks.count("coherent"));
+
+    const auto straces = by_channel(serial);
+    const auto ttraces = by_channel(threaded);
+    REQUIRE(straces.size() == nchannels);
+    REQUIRE(ttraces.size() == straces.size());
+    for (size_t ind = 0; ind < straces.size(); ++ind) {
+        REQUIRE(straces[ind]->channel() == ttraces[ind]->channel());
+        REQUIRE(straces[ind]->tbin() == ttraces[ind]->tbin());
+        REQUIRE(straces[ind]->charge() == ttraces[ind]->charge());
+    }
+    CHECK(serial->masks() == threaded->masks());
+    CHECK(serial->trace_tags() == threaded->trace_tags());
+}
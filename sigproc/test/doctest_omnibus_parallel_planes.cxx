@@ -0,0 +1,228 @@
+// OmnibusSigProc gives the same frame with and without
+// "parallel_planes".
+#include "WireCellSigProc/OmnibusSigProc.h"
+
+#include "WireCellAux/SimpleFrame.h"
+#include "WireCellAux/SimpleTrace.h"
+#include "WireCellAux/Testing.h"
+#include "WireCellIface/IAnodePlane.h"
+#include "WireCellIface/IConfigurable.h"
+#include "WireCellIface/IDFT.h"
+#include "WireCellIface/IFieldResponse.h"
+#include "WireCellIface/IWaveform.h"
+#include "WireCellUtil/NamedFactory.h"
+#include "WireCellUtil/PluginManager.h"
+#include "WireCellUtil/Response.h"
+#include "WireCellUtil/Units.h"
+#include "WireCellUtil/doctest.h"
+
+#include <cmath>
+#include <random>
+#include <set>
+
+using namespace WireCell;
+
+static const int nwires = 40;
+static const int nticks = 600;
+static const double tick = 0.5 * units::us;
+static const double pitch = 5 * units::mm;
+
+// Bipolar induction and unipolar collection currents falling off
+// with distance from the wire.  Collection integrates to the charge
+// of one electron.
+class FakeFieldResponse : public IFieldResponse {
+  public:
+    FakeFieldResponse()
+    {
+        using namespace Response::Schema;
+        const double period = 100 * units::ns;
+        const int nsamples = 1000;
+        std::vector<PlaneResponse> planes;
+        for (int iplane = 0; iplane < 3; ++iplane) {
+            std::vector<PathResponse> paths;
+            for (int ind = 0; ind <= 30; ++ind) {
+                const double pitchpos = ind * 0.5 * units::mm;
+                const double scale = std::exp(-2.0 * pitchpos / pitch);
+                Waveform::realseq_t current(nsamples, 0);
+                for (int it = 0; it < nsamples; ++it) {
+                    const double dt = (it * period - 80 * units::us) / (1 * units::us);
+                    const double gaus = std::exp(-0.5 * dt * dt) / (std::sqrt(2 * M_PI) * units::us);
+                    current[it] = -scale * (iplane == 2 ? gaus : -dt * gaus);
+                }
+                paths.emplace_back(current, pitchpos, 0);
+            }
+            // Response::wire_region_average() only learns the number
+            // of samples from a repeated position, as in real files.
+            paths.push_back(paths.front());
+            planes.emplace_back(paths, iplane, (3 - iplane) * units::mm, pitch);
+        }
+        m_fr = FieldResponse(planes, Vector(1, 0, 0), 10 * units::cm, 0, period, 1.6 * units::mm / units::us);
+    }
+    virtual ~FakeFieldResponse() {}
+    virtual const Response::Schema::FieldResponse& field_response() const { return m_fr; }
+
+  private:
+    Response::Schema::FieldResponse m_fr;
+};
+
+// Configurable only to be a component, as ColdElecResponse is.
+class FakeElecResponse : public IWaveform, public IConfigurable {
+  public:
+    virtual ~FakeElecResponse() {}
+    virtual void configure(const Configuration& cfg) {}
+    virtual Configuration default_configuration() const { return Configuration(); }
+    virtual double waveform_start() const { return 0; }
+    virtual double waveform_period() const { return tick; }
+    virtual const sequence_type& waveform_samples() const { return m_samples; }
+    virtual sequence_type waveform_samples(const Binning& tbins) const
+    {
+        Response::ColdElec ce(14 * units::mV / units::fC, 2 * units::us);
+        return ce.generate(tbins);
+    }
+
+  private:
+    sequence_type m_samples;
+};
+
+static void configure_filter(const std::string& type, const std::string& name, double sigma, double power = 2,
+                             bool flag = true)
+{
+    auto cfgable = Factory::lookup<IConfigurable>(type, name);
+    auto cfg = cfgable->default_configuration();
+    cfg["max_freq"] = flag ? 1 * units::megahertz : 1;
+    if (type == "LfFilter") {
+        cfg["tau"] = sigma;
+    }
+    else {
+        cfg["sigma"] = sigma;
+        cfg["power"] = power;
+        cfg["flag"] = flag;
+    }
+    cfgable->configure(cfg);
+}
+
+static void setup()
+{
+    static bool done = false;
+    if (done) {
+        return;
+    }
+    done = true;
+
+    PluginManager& pm = PluginManager::instance();
+    REQUIRE(pm.add("WireCellAux") != nullptr);
+    REQUIRE(pm.add("WireCellSigProc") != nullptr);
+
+    // Components are found, not made, by OmnibusSigProc.
+    Testing::get_dft();
+    Testing::fake_anode(nwires, pitch);
+    make_named_factory_factory<FakeFieldResponse, IFieldResponse>("FakeFieldResponse");
+    Factory::lookup_tn<IFieldResponse>("FakeFieldResponse");
+    make_named_factory_factory<FakeElecResponse, IWaveform>("FakeElecResponse");
+    Factory::lookup_tn<IWaveform>("FakeElecResponse");
+
+    // As in the usual sp-filters.jsonnet.
+    const double MHz = units::megahertz;
+    configure_filter("LfFilter", "ROI_tight_lf", 0.0185 * MHz);
+    configure_filter("LfFilter", "ROI_tighter_lf", 0.145 * MHz);
+    configure_filter("LfFilter", "ROI_loose_lf", 0.00175 * MHz);
+    configure_filter("HfFilter", "Gaus_tight", 0);
+    configure_filter("HfFilter", "Gaus_wide", 0.10 * MHz);
+    configure_filter("HfFilter", "Wiener_tight_U", 0.15 * MHz, 5.5);
+    configure_filter("HfFilter", "Wiener_tight_V", 0.15 * MHz, 5.0);
+    configure_filter("HfFilter", "Wiener_tight_W", 0.25 * MHz, 3.0);
+    configure_filter("HfFilter", "Wiener_wide_U", 0.186765 * MHz, 5.05429);
+    configure_filter("HfFilter", "Wiener_wide_V", 0.1936 * MHz, 5.77422);
+    configure_filter("HfFilter", "Wiener_wide_W", 0.175722 * MHz, 4.37928);
+    configure_filter("HfFilter", "Wire_ind", 1.0 / std::sqrt(M_PI) * 1.05, 2, false);
+    configure_filter("HfFilter", "Wire_col", 1.0 / std::sqrt(M_PI) * 3.60, 2, false);
+}
+
+// Noisy ADC with a few tracks crossing each plane and one bad channel.
+static IFrame::pointer make_frame()
+{
+    std::mt19937 gen(12345);
+    std::normal_distribution<float> noise(0, 1.5);
+
+    ITrace::vector traces;
+    for (int iplane = 0; iplane < 3; ++iplane) {
+        for (int iwire = 0; iwire < nwires; ++iwire) {
+            ITrace::ChargeSequence adc(nticks);
+            for (auto& q : adc) {
+                q = noise(gen);
+            }
+            for (int itrack = 0; itrack < 3; ++itrack) {
+                const double t0 = 100 + 150 * itrack + 2.0 * (itrack + 1) * (iwire - 10);
+                if (iwire < 5 + 10 * itrack or t0 < 10 or t0 > nticks - 20) {
+                    continue;
+                }
+                for (int it = 0; it < nticks; ++it) {
+                    const double dt = (it - t0) / 3.0;
+                    const double gaus = 60 * std::exp(-0.5 * dt * dt);
+                    adc[it] += iplane == 2 ? gaus : -0.5 * dt * gaus;
+                }
+            }
+            traces.push_back(std::make_shared<Aux::SimpleTrace>(100 * iplane + iwire, 0, adc));
+        }
+    }
+    Waveform::ChannelMaskMap cmm;
+    cmm["bad"][105].push_back(Waveform::BinRange(0, nticks));
+    return std::make_shared<Aux::SimpleFrame>(1, 0, traces, tick, cmm);
+}
+
+static IFrame::pointer sigproc(bool parallel_planes)
+{
+    SigProc::OmnibusSigProc osp;
+    auto cfg = osp.default_configuration();
+    cfg["anode"] = "FakeAnode";
+    cfg["field_response"] = "FakeFieldResponse";
+    cfg["elecresponse"] = "FakeElecResponse";
+    cfg["per_chan_resp"] = "";
+    cfg["parallel_planes"] = parallel_planes;
+    osp.configure(cfg);
+
+    IFrame::pointer out;
+    REQUIRE(osp(make_frame(), out));
+    REQUIRE(out);
+    return out;
+}
+
+static void require_same_traces(const ITrace::vector& a, const ITrace::vector& b)
+{
+    REQUIRE(a.size() == b.size());
+    for (size_t ind = 0; ind < a.size(); ++ind) {
+        REQUIRE(a[ind]->channel() == b[ind]->channel());
+        REQUIRE(a[ind]->tbin() == b[ind]->tbin());
+        REQUIRE(a[ind]->charge() == b[ind]->charge());
+    }
+}
+
+TEST_CASE("sigproc omnibus parallel planes")
+{
+    setup();
+
+    auto serial = sigproc(false);
+    auto parallel = sigproc(true);
+
+    // Some signal was found on every plane.
+    std::set<int> planes;
+    for (const auto& trace : *serial->traces()) {
+        for (float q : trace->charge()) {
+            if (q > 0) {
+                planes.insert(trace->channel() / 100);
+                break;
+            }
+        }
+    }
+    CHECK(planes == std::set<int>{0, 1, 2});
+
+    require_same_traces(*serial->traces(), *parallel->traces());
+    CHECK(serial->frame_tags() == parallel->frame_tags());
+    CHECK(serial->trace_tags() == parallel->trace_tags());
+    for (const auto& tag : serial->trace_tags()) {
+        CAPTURE(tag);
+        CHECK(serial->tagged_traces(tag) == parallel->tagged_traces(tag));
+        CHECK(serial->trace_summary(tag) == parallel->trace_summary(tag));
+    }
+    CHECK(serial->masks() == parallel->masks());
+}
@@ -51,6 +51,15 @@ namespace WireCell::Sio {
         */
         std::string m_outname{"cluster-file.tar.gz"};
 
+        /**
+           nthreads = 1
+
+           Number of threads used to compress .gz output.  If more
+           than one, blocks are compressed concurrently as independent
+           gzip members.
+        */
+        size_t m_nthreads{1};
+
         /**
            format = "json"
 
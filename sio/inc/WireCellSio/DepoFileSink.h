@@ -56,6 +56,9 @@ namespace WireCell::Sio {
         /// details.
         std::string m_outname{"wct-depos.tar.bz2"};
 
+        /// Number of threads used to compress .gz output.
+        size_t m_nthreads{1};
+
         // The output stream
         boost::iostreams::filtering_ostream m_out;
 
@@ -45,6 +45,11 @@ namespace WireCell::Sio {
         /// their "outname" forms are reserved.
         std::string m_outname;
 
+        /// Number of threads used to compress .gz output.  If more
+        /// than one, blocks are compressed concurrently as
+        /// independent gzip members.
+        size_t m_nthreads{1};
+
         /// The frame tag or trace tags to sink.  A tag first attempts
         /// to match a trace tag, else it attempts to match a frame
         /// tag.  If a tag is the empty string it matches untagged
@@ -11,6 +11,7 @@
 #include <boost/iostreams/filtering_stream.hpp>
 #pragma GCC diagnostic pop
 
+#include <set>
 #include <string>
 #include <vector>
 
@@ -68,6 +69,16 @@ namespace WireCell::Sio {
         */
         std::vector<std::string> m_frame_tags;        
 
+        /** Config: "idents".
+
+            If non-empty, only frames with these idents are produced,
+            in the order they appear in the input.  For uncompressed
+            .tar and for .npz/.zip input, the archive is indexed and
+            the members of other frames are never read.  Otherwise,
+            the input is read in full and other frames are skipped.
+        */
+        std::set<int> m_idents;
+
         // The output stream
         boost::iostreams::filtering_istream m_in;
 
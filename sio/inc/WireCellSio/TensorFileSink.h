@@ -59,6 +59,14 @@ namespace WireCell::Sio {
         */
         std::string m_outname{"tensors.npz"};
 
+        /** Config: "nthreads"
+
+            Number of threads used to compress .gz output.  If more
+            than one, blocks are compressed concurrently as
+            independent gzip members.
+        */
+        size_t m_nthreads{1};
+
 
         /** Config: "prefix"
 
@@ -5,6 +5,7 @@
 #include "WireCellIface/ITerminal.h"
 #include "WireCellIface/IConfigurable.h"
 #include "WireCellAux/Logger.h"
+#include "WireCellUtil/Stream.h"
 
 
 #pragma GCC diagnostic push
@@ -12,6 +13,9 @@
 #include <boost/iostreams/filtering_stream.hpp>
 #pragma GCC diagnostic pop
 
+#include <memory>
+#include <set>
+
 namespace WireCell::Sio {
 
     class TensorFileSource : public Aux::Logger, public ITensorSetSource,
@@ -72,6 +76,28 @@ namespace WireCell::Sio {
         */
         std::string m_prefix{""};
 
+        /** Config: "idents"
+
+            If non-empty, only tensor sets with these idents are
+            produced, in the order they appear in the input.  For
+            uncompressed .tar and for .npz/.zip input the archive is
+            indexed and files of other tensor sets are never read.
+            Otherwise the input is read in full and other tensor sets
+            are skipped.
+        */
+        std::set<int> m_idents;
+
+        /** Config: "mmap"
+
+            If true (default) and the input is an uncompressed .tar
+            or an .npz/.zip holding only stored (uncompressed)
+            members, the file is memory mapped and the array of each
+            ITensor refers directly to the mapping instead of a copy.
+            The mapping is released when the last such ITensor is
+            destroyed.  Otherwise the input is streamed.
+        */
+        bool m_mmap{true};
+
       private:
         
         using istream_t = boost::iostreams::filtering_istream;
@@ -79,6 +105,14 @@ namespace WireCell::Sio {
         size_t m_count{0};
         bool m_eos_sent{false};
 
+        // Set when the input is mapped.  Then members are read in
+        // order from the mapping instead of from m_in.
+        std::shared_ptr<const void> m_map;
+        const char* m_base{nullptr};
+        Stream::members_t m_members;
+        size_t m_memind{0};
+        bool open_mapped(const Stream::members_t& members);
+
         ITensorSet::pointer load();
         bool read_head();
         void clear();
@@ -90,6 +124,8 @@ namespace WireCell::Sio {
             header_t() :fname(""), fsize(0) {}
             std::string fname{""};
             size_t fsize{0};
+            const char* data{nullptr}; // if mapped
+
         };
         header_t m_cur;
 
@@ -40,6 +40,7 @@ WireCell::Configuration Sio::ClusterFileSink::default_configuration() const
     cfg["outname"] = m_outname;
     cfg["prefix"] = m_prefix;
     cfg["format"] = m_format;
+    cfg["nthreads"] = (int)m_nthreads;
 
     return cfg;
 }
@@ -105,8 +106,9 @@ void Sio::ClusterFileSink::numpify(const ICluster& cluster)
 void Sio::ClusterFileSink::configure(const WireCell::Configuration& cfg)
 {
     m_outname = get(cfg, "outname", m_outname);
+    m_nthreads = std::max(1, get(cfg, "nthreads", (int)m_nthreads));
     m_out.clear();
-    custard::output_filters(m_out, m_outname);
+    custard::output_filters(m_out, m_outname, 1, m_nthreads);
     if (m_out.empty()) {
         THROW(ValueError() << errmsg{"ClusterFileSink: unsupported outname: " + m_outname});
     }
@@ -36,15 +36,18 @@ WireCell::Configuration Sio::DepoFileSink::default_configuration() const
     Configuration cfg;
     // Output tar file name.
     cfg["outname"] = m_outname;
+    // Threads to compress .gz output.
+    cfg["nthreads"] = (int)m_nthreads;
     return cfg;
 }
 
 void Sio::DepoFileSink::configure(const WireCell::Configuration& cfg)
 {
     m_outname = get(cfg, "outname", m_outname);
+    m_nthreads = std::max(1, get(cfg, "nthreads", (int)m_nthreads));
 
     m_out.clear();
-    output_filters(m_out, m_outname);
+    output_filters(m_out, m_outname, 1, m_nthreads);
     if (m_out.size() < 1) {
         // must have at least one
         THROW(ValueError()
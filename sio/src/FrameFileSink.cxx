@@ -7,6 +7,10 @@
 #include "WireCellUtil/Waveform.h"
 
 #include "WireCellAux/FrameTools.h"
+#include "WireCellAux/DenseFrame.h"
+
+#include <algorithm>
+#include <functional>
 
 
 WIRECELL_FACTORY(FrameFileSink, WireCell::Sio::FrameFileSink,
@@ -40,6 +44,9 @@ WireCell::Configuration Sio::FrameFileSink::default_configuration() const
     // Output tar file name.
     cfg["outname"] = m_outname;
 
+    // Threads to compress .gz output.
+    cfg["nthreads"] = (int)m_nthreads;
+
     // Select which traces to consider.
     cfg["tags"] = Json::arrayValue;
 
@@ -78,8 +85,10 @@ void Sio::FrameFileSink::configure(const WireCell::Configuration& cfg)
 
     m_masks = get(cfg, "masks", m_masks);
 
+    m_nthreads = std::max(1, get(cfg, "nthreads", (int)m_nthreads));
+
     m_out.clear();
-    output_filters(m_out, m_outname);
+    output_filters(m_out, m_outname, 1, m_nthreads);
     if (m_out.size() < 1) {
         THROW(ValueError() << errmsg{"FrameFileSink: unsupported outname: " + m_outname});
     }
@@ -145,9 +154,20 @@ void Sio::FrameFileSink::one_tag(const IFrame::pointer& frame,
     log->debug("call={} frame={} ntraces={} tag=\"{}\"",
                m_count, frame->ident(),traces.size(), tag);
 
+    // All traces of a dense frame with ordered channels are exactly
+    // its block, which is then copied whole.
+    const auto view = frame->dense();
+    const bool use_view = view and tag == "*" and !m_dense
+        and std::adjacent_find(view.channels->begin(), view.channels->end(),
+                               std::greater_equal<int>()) == view.channels->end();
+
     Aux::channel_list channels;
     std::pair<int, int> tbinmm;
-    if (m_dense) {
+    if (use_view) {
+        channels.assign(view.channels->begin(), view.channels->end());
+        tbinmm = std::make_pair(view.tbin, view.tbin + (int) view.ncols);
+    }
+    else if (m_dense) {
         channels.resize(m_chend-m_chbeg, 0);
         std::iota(channels.begin(), channels.end(), m_chbeg);
         tbinmm = std::make_pair(m_tbbeg, m_tbend);
@@ -164,8 +184,14 @@ void Sio::FrameFileSink::one_tag(const IFrame::pointer& frame,
     const size_t ncols = tbinmm.second - tbinmm.first;
     const size_t nrows = std::distance(channels.begin(), channels.end());
 
-    Array::array_xxf arr = Array::array_xxf::Zero(nrows, ncols) + m_baseline;
-    Aux::fill(arr, traces, channels.begin(), channels.end(), tbinmm.first);
+    Array::array_xxf arr;
+    if (use_view) {
+        arr = Aux::dense_map(view) + m_baseline;
+    }
+    else {
+        arr = Array::array_xxf::Zero(nrows, ncols) + m_baseline;
+        Aux::fill(arr, traces, channels.begin(), channels.end(), tbinmm.first);
+    }
     arr = arr * m_scale + m_offset;
 
     {  // the 2D frame array
@@ -22,6 +22,17 @@ using namespace WireCell::Stream;
 using namespace WireCell::String;
 using namespace WireCell::Waveform;
 
+// Return the <ident> from a <type>_<tag>_<ident>.<ext> name or -1.
+static int parse_ident(const std::string& fname)
+{
+    auto parts = split(fname, "_");
+    if (parts.size() != 3) {
+        return -1;
+    }
+    auto rparts = split(parts[2], ".");
+    return std::atoi(rparts[0].c_str());
+}
+
 FrameFileSource::FrameFileSource()
     : Aux::Logger("FrameFileSource", "io")
 {
@@ -42,6 +53,9 @@ WireCell::Configuration FrameFileSource::default_configuration() const
 
     cfg["frame_tags"] = Json::arrayValue;
 
+    // Frame idents to select, empty means all.
+    cfg["idents"] = Json::arrayValue;
+
     return cfg;
 }
 
@@ -49,8 +63,26 @@ void FrameFileSource::configure(const WireCell::Configuration& cfg)
 {
     m_inname = get(cfg, "inname", m_inname);
 
+    m_idents.clear();
+    for (auto jid : cfg["idents"]) {
+        m_idents.insert(jid.asInt());
+    }
+
     m_in.clear();
-    input_filters(m_in, m_inname);
+    if (!m_idents.empty() and seekable(m_inname)) {
+        custard::members_t keep;
+        const auto members = custard::index(m_inname);
+        for (const auto& mem : members) {
+            if (m_idents.count(parse_ident(mem.name))) {
+                keep.push_back(mem);
+            }
+        }
+        log->debug("indexed {}, reading {} of {} members", m_inname, keep.size(), members.size());
+        input_filters(m_in, m_inname, keep);
+    }
+    else {
+        input_filters(m_in, m_inname);
+    }
     if (m_in.size() < 1) {
         raise<ValueError>("FrameFileSource: unsupported inname: %s", m_inname);
     }
@@ -180,6 +212,11 @@ IFrame::pointer FrameFileSource::load()
             }
         }
 
+        if (!m_idents.empty() and !m_idents.count(m_cur.ident)) {
+            clear();            // not selected
+            continue;
+        }
+
         if (ident < 0) {
             // first time
             ident = m_cur.ident;
@@ -26,14 +26,16 @@ WireCell::Configuration TensorFileSink::default_configuration() const
     Configuration cfg;
     cfg["outname"] = m_outname;
     cfg["prefix"] = m_prefix;
+    cfg["nthreads"] = (int)m_nthreads;
     return cfg;
 }
 
 void TensorFileSink::configure(const WireCell::Configuration& cfg)
 {
     m_outname = get(cfg, "outname", m_outname);
+    m_nthreads = std::max(1, get(cfg, "nthreads", (int)m_nthreads));
     m_out.clear();
-    custard::output_filters(m_out, m_outname);
+    custard::output_filters(m_out, m_outname, 1, m_nthreads);
     if (m_out.empty()) {
         const std::string msg = "ClusterFileSink: unsupported outname: " + m_outname;
         log->critical(msg);
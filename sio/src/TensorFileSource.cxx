@@ -4,6 +4,17 @@
 #include "WireCellUtil/Dtype.h"
 #include "WireCellAux/SimpleTensorSet.h"
 
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+#pragma GCC diagnostic pop
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
 #include "WireCellUtil/NamedFactory.h"
 
 WIRECELL_FACTORY(TensorFileSource, WireCell::Sio::TensorFileSource,
@@ -29,32 +40,6 @@ TensorFileSource::~TensorFileSource()
 }
 
 
-WireCell::Configuration TensorFileSource::default_configuration() const
-{
-    Configuration cfg;
-    cfg["inname"] = m_inname;
-    cfg["prefix"] = m_prefix;
-    return cfg;
-}
-
-void TensorFileSource::configure(const WireCell::Configuration& cfg)
-{
-    m_inname = get(cfg, "inname", m_inname);
-    m_prefix = get(cfg, "prefix", m_prefix);
-
-    m_in.clear();
-    input_filters(m_in, m_inname);
-    if (m_in.empty()) {
-        THROW(ValueError() << errmsg{"TensorFileSource: unsupported inname: " + m_inname});
-    }
-
-    log->debug("reading file={} with prefix={}", m_inname, m_prefix);
-}
-
-void TensorFileSource::finalize()
-{
-}
-
 /*
   <prefix>tensorset_<ident>_metadata.json 
   <prefix>tensor_<ident>_<index>_metadata.npy
@@ -115,33 +100,115 @@ ParsedFilename parse_fname(const std::string& fname,
     else return ret;
 }
 
+WireCell::Configuration TensorFileSource::default_configuration() const
+{
+    Configuration cfg;
+    cfg["inname"] = m_inname;
+    cfg["prefix"] = m_prefix;
+    cfg["idents"] = Json::arrayValue;
+    cfg["mmap"] = m_mmap;
+    return cfg;
+}
+
+void TensorFileSource::configure(const WireCell::Configuration& cfg)
+{
+    m_inname = get(cfg, "inname", m_inname);
+    m_prefix = get(cfg, "prefix", m_prefix);
+
+    m_idents.clear();
+    for (auto jid : cfg["idents"]) {
+        m_idents.insert(jid.asInt());
+    }
+
+    m_mmap = get(cfg, "mmap", m_mmap);
+
+    m_in.clear();
+    m_map = nullptr;
+    m_members.clear();
+    m_memind = 0;
+    if ((m_mmap or !m_idents.empty()) and seekable(m_inname)) {
+        custard::members_t keep;
+        const auto members = custard::index(m_inname);
+        for (const auto& mem : members) {
+            if (m_idents.empty() or m_idents.count(parse_fname(mem.name, m_prefix).ident)) {
+                keep.push_back(mem);
+            }
+        }
+        log->debug("indexed {}, reading {} of {} members", m_inname, keep.size(), members.size());
+        if (!(m_mmap and open_mapped(keep))) {
+            input_filters(m_in, m_inname, keep);
+        }
+    }
+    else {
+        input_filters(m_in, m_inname);
+    }
+    if (!m_map and m_in.empty()) {
+        THROW(ValueError() << errmsg{"TensorFileSource: unsupported inname: " + m_inname});
+    }
+
+    log->debug("reading file={} with prefix={}", m_inname, m_prefix);
+}
+
+void TensorFileSource::finalize()
+{
+}
+
+bool TensorFileSource::open_mapped(const custard::members_t& members)
+{
+    for (const auto& mem : members) {
+        if (mem.stored < 0) {
+            log->debug("not mapping {}: member {} is compressed", m_inname, mem.name);
+            return false;
+        }
+    }
+    auto map = std::make_shared<boost::iostreams::mapped_file_source>();
+    if (!members.empty()) {
+        try {
+            map->open(m_inname);
+        }
+        catch (const std::exception& err) {
+            log->warn("not mapping {}: {}", m_inname, err.what());
+            return false;
+        }
+    }
+    m_base = map->is_open() ? map->data() : nullptr;
+    m_map = map;
+    m_members = members;
+    m_memind = 0;
+    log->debug("mapped {} with {} members", m_inname, members.size());
+    return true;
+}
+
 static
-Configuration load_json(std::istream& in, size_t fsize)
+Configuration load_json(const std::string& buffer)
 {
     Configuration cfg;
+    std::istringstream ss(buffer);
+    ss >> cfg;
+    return cfg;
+}
 
+static
+Configuration load_json(std::istream& in, size_t fsize)
+{
     // Read into a buffer string to assure we consume fsize bytes and
     // protect against malformed JSON or leading/trailing spaces.
     std::string buffer;
     buffer.resize(fsize);
     in.read(buffer.data(), buffer.size());
-    if (!in) { return cfg; }
-
-    std::istringstream ss(buffer);
-    ss >> cfg;
-    return cfg;
+    if (!in) { return Configuration(); }
+    return load_json(buffer);
 }
 
 struct TFSTensor : public WireCell::ITensor {
-    // pigenc::File pig;
     TFSTensor() {}
     virtual ~TFSTensor() {}
-    // explicit TFSTensor(pigenc::File&& pig)
-    //     : pig(std::move(pig))
-    // {
-    // }
     size_t m_element_size{0};
     std::vector<std::byte> m_store;
+    // Array data, either in m_store or in memory held by m_keep.
+    const std::byte* m_data{nullptr};
+    size_t m_size{0};
+    std::shared_ptr<const void> m_keep;
     std::string m_dtype{""};
     shape_t m_shape;
     Configuration m_cfg;
@@ -151,9 +218,24 @@ struct TFSTensor : public WireCell::ITensor {
         , m_shape(pig.header().shape())
         , m_cfg(cfg)
     {
-        auto vec = pig.data();
+        const auto& vec = pig.data();
         const std::byte* data = reinterpret_cast<const std::byte*>(vec.data());
-        m_store.insert(m_store.end(), data, data + pig.data().size());
+        m_store.insert(m_store.end(), data, data + vec.size());
+        m_data = m_store.data();
+        m_size = m_store.size();
+    }
+
+    // Refer to array data held by keep, without copy.
+    TFSTensor(const pigenc::Header& head, const std::byte* data,
+              std::shared_ptr<const void> keep)
+        : m_element_size(head.type_size())
+        , m_data(data)
+        , m_size(head.data_size())
+        , m_keep(keep)
+        , m_dtype(head.dtype())
+        , m_shape(head.shape())
+        , m_cfg(Json::objectValue)
+    {
     }
 
     // An ITensor may not have an array part.
@@ -163,33 +245,27 @@ struct TFSTensor : public WireCell::ITensor {
     }
     virtual const std::type_info& element_type() const
     {
-        // return dtype_info(dtype());
         return dtype_info(m_dtype);
     }
     virtual size_t element_size() const
     {
-        // return pig.header().type_size();
         return m_element_size;
     }
     virtual std::string dtype() const
     {
-        // return pig.header().dtype();
         return m_dtype;
     }
     virtual shape_t shape() const
     {
-        // return pig.header().shape();
         return m_shape;
     }
     virtual const std::byte* data() const
     {
-        // return (const std::byte*)pig.data().data();
-        return m_store.data();
+        return m_data;
     }
     virtual size_t size() const
     {
-        // return pig.header().data_size();
-        return m_store.size();
+        return m_size;
     }
     virtual Configuration metadata() const
     {
@@ -197,6 +273,31 @@ struct TFSTensor : public WireCell::ITensor {
     }
 };
 
+// Make a tensor from an npy file held in memory.  The array refers
+// into the memory if it is suitably aligned, else it is copied.
+static
+std::shared_ptr<TFSTensor> load_npy(const char* data, size_t fsize,
+                                    std::shared_ptr<const void> keep)
+{
+    boost::iostreams::stream<boost::iostreams::array_source> ss(data, fsize);
+    pigenc::Header head;
+    head.read(ss);
+    if (!ss) { return nullptr; }
+    const size_t hsize = ss.tellg();
+    if (hsize + head.data_size() > fsize) { return nullptr; }
+
+    const std::byte* arr = reinterpret_cast<const std::byte*>(data + hsize);
+    const size_t esize = head.type_size();
+    if (esize and reinterpret_cast<uintptr_t>(arr) % std::min(esize, alignof(std::max_align_t))) {
+        ss.seekg(0);
+        pigenc::File pig;
+        pig.read(ss);
+        if (!ss) { return nullptr; }
+        return std::make_shared<TFSTensor>(pig);
+    }
+    return std::make_shared<TFSTensor>(head, arr, keep);
+}
+
 ITensorSet::pointer TensorFileSource::load()
 {
     int ident = -1;
@@ -213,7 +314,22 @@ ITensorSet::pointer TensorFileSource::load()
 
         // log->debug("loop file={} size={}", m_cur.fname, m_cur.fsize);
 
-        if (m_cur.fsize == 0) {
+        if (m_cur.fsize == 0 and m_map) {
+            clear();
+            // Empty members hold nothing to load.  A zip index lists
+            // them while a tar index does not.
+            while (m_memind < m_members.size() and m_members[m_memind].size == 0) {
+                ++m_memind;
+            }
+            if (m_memind == m_members.size()) {
+                break;
+            }
+            const auto& mem = m_members[m_memind++];
+            m_cur.fname = mem.name;
+            m_cur.fsize = mem.size;
+            m_cur.data = m_base + mem.stored;
+        }
+        else if (m_cur.fsize == 0) {
             clear();
             custard::read(m_in, m_cur.fname, m_cur.fsize);
             if (m_in.eof()) {
@@ -221,16 +337,20 @@ ITensorSet::pointer TensorFileSource::load()
                 //            m_count, m_inname);
                 break;
             }
-            if (!m_cur.fsize) {
-                log->critical("call={}, short read from file={}",
-                              m_count, m_inname);
-                return nullptr;
-            }
             if (!m_in) {
                 log->critical("call={}, read stream error with file={}",
                               m_count, m_inname);
                 return nullptr;
             }
+            if (!m_cur.fsize) {
+                if (m_cur.fname.empty()) {
+                    log->critical("call={}, short read from file={}",
+                                  m_count, m_inname);
+                    return nullptr;
+                }
+                clear();        // an empty member
+                continue;
+            }
         }
 
         auto pf = parse_fname(m_cur.fname, m_prefix);
@@ -239,8 +359,13 @@ ITensorSet::pointer TensorFileSource::load()
         //            m_cur.fname, m_cur.fsize,
         //            pf.type, pf.form, pf.ident, pf.index);
 
-        if (pf.type == ParsedFilename::bad or pf.form == ParsedFilename::unknown) {
-            m_in.seekg(m_cur.fsize, m_in.cur);
+        if (pf.type == ParsedFilename::bad or pf.form == ParsedFilename::unknown
+            or (!m_idents.empty() and !m_idents.count(pf.ident))) {
+            if (!m_map) {
+                // Read past rather than seek as filtered (eg
+                // decompressing) streams can not seek.
+                m_in.ignore(m_cur.fsize);
+            }
             clear();
             continue;
         }
@@ -253,7 +378,8 @@ ITensorSet::pointer TensorFileSource::load()
 
         // tensor set md 
         if (pf.type == ParsedFilename::set) {
-            setmd = load_json(m_in, m_cur.fsize);
+            setmd = m_map ? load_json(std::string(m_cur.data, m_cur.fsize))
+                          : load_json(m_in, m_cur.fsize);
             clear();
             continue;
         }
@@ -261,7 +387,18 @@ ITensorSet::pointer TensorFileSource::load()
         // tensor md or array
         if (pf.type == ParsedFilename::ten) {
             if (pf.form == ParsedFilename::json) {
-                teninfo[pf.index].md = load_json(m_in, m_cur.fsize);
+                teninfo[pf.index].md = m_map ? load_json(std::string(m_cur.data, m_cur.fsize))
+                                             : load_json(m_in, m_cur.fsize);
+                clear();
+            }
+            else if (m_map) {
+                auto ten = load_npy(m_cur.data, m_cur.fsize, m_map);
+                if (!ten) {
+                    log->critical("call={}, malformed array {} in file={}",
+                                  m_count, m_cur.fname, m_inname);
+                    return nullptr;
+                }
+                teninfo[pf.index].ten = ten;
                 clear();
             }
             else {
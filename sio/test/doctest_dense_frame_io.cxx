@@ -0,0 +1,136 @@
+// A dense frame from the Digitizer saved by FrameFileSink without
+// copying its traces to vectors.
+#include "WireCellSio/FrameFileSink.h"
+#include "WireCellSio/FrameFileSource.h"
+
+#include "WireCellAux/DenseFrame.h"
+#include "WireCellAux/SimpleFrame.h"
+#include "WireCellAux/SimpleTrace.h"
+#include "WireCellAux/Testing.h"
+#include "WireCellIface/IAnodePlane.h"
+#include "WireCellIface/IConfigurable.h"
+#include "WireCellIface/IFrameFilter.h"
+#include "WireCellUtil/NamedFactory.h"
+#include "WireCellUtil/Persist.h"
+#include "WireCellUtil/PluginManager.h"
+#include "WireCellUtil/Units.h"
+#include "WireCellUtil/doctest.h"
+
+using namespace WireCell;
+
+static IFrameFilter::pointer make_digitizer()
+{
+    PluginManager& pm = PluginManager::instance();
+    REQUIRE(pm.add("WireCellGen") != nullptr);
+    Testing::fake_anode(); // found, not made, by Digitizer
+    auto cfgable = Factory::lookup<IConfigurable>("Digitizer");
+    auto cfg = cfgable->default_configuration();
+    cfg["anode"] = "FakeAnode";
+    cfgable->configure(cfg);
+    return Factory::find<IFrameFilter>("Digitizer");
+}
+
+// Voltage traces of varied extent, one on a channel with no plane.
+static IFrame::pointer make_voltage()
+{
+    ITrace::vector traces;
+    for (int chid : {7, 3, 5, 4, -1}) {
+        ITrace::ChargeSequence volts(10 + chid, 0.0);
+        for (size_t ind = 0; ind < volts.size(); ++ind) {
+            volts[ind] = 0.01 * units::mV * (chid + 3) * ind;
+        }
+        const int tbin = chid < 0 ? 8 : 2 * chid;
+        traces.push_back(std::make_shared<Aux::SimpleTrace>(chid, tbin, volts));
+    }
+    return std::make_shared<Aux::SimpleFrame>(1, 0, traces, 0.5 * units::us);
+}
+
+// A vector-backed copy of a frame.
+static IFrame::pointer make_simple(const IFrame::pointer& frame)
+{
+    ITrace::vector traces;
+    for (const auto& trace : *frame->traces()) {
+        const float* beg = trace->samples();
+        ITrace::ChargeSequence charge(beg, beg + trace->nsamples());
+        traces.push_back(std::make_shared<Aux::SimpleTrace>(trace->channel(), trace->tbin(), charge));
+    }
+    return std::make_shared<Aux::SimpleFrame>(frame->ident(), frame->time(), traces, frame->tick());
+}
+
+static void write_frame(const std::string& path, const IFrame::pointer& frame)
+{
+    Sio::FrameFileSink sink;
+    auto cfg = sink.default_configuration();
+    cfg["outname"] = path;
+    sink.configure(cfg);
+    REQUIRE(sink(frame));
+    REQUIRE(sink(nullptr));
+    sink.finalize();
+}
+
+static IFrame::pointer read_frame(const std::string& path)
+{
+    Sio::FrameFileSource src;
+    auto cfg = src.default_configuration();
+    cfg["inname"] = path;
+    src.configure(cfg);
+    IFrame::pointer frame;
+    REQUIRE(src(frame));
+    REQUIRE(frame);
+    return frame;
+}
+
+static bool any_charged(const IFrame::pointer& frame)
+{
+    for (const auto& trace : *frame->traces()) {
+        auto dtrace = std::dynamic_pointer_cast<const Aux::DenseTrace>(trace);
+        REQUIRE(dtrace);
+        if (dtrace->charged()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST_CASE("sio dense frame from digitizer to file")
+{
+    auto digitizer = make_digitizer();
+
+    IFrame::pointer adc;
+    REQUIRE((*digitizer)(make_voltage(), adc));
+    REQUIRE(adc);
+
+    // One row per channel with a plane, in channel order, spanning
+    // the tbins of all input traces.
+    auto view = adc->dense();
+    REQUIRE(view);
+    CHECK(*view.channels == std::vector<int>{3, 4, 5, 7});
+    CHECK(view.tbin == 6);
+    CHECK(view.ncols == 31 - 6);
+    REQUIRE(adc->traces()->size() == 4);
+    CHECK(!any_charged(adc));
+
+    Persist::TempDir td;
+    const std::string dense_path = (td.path / "dense.tar").string();
+    write_frame(dense_path, adc);
+    CHECK(!any_charged(adc));
+
+    // The same samples held in vectors take the per-trace path.
+    const std::string simple_path = (td.path / "simple.tar").string();
+    write_frame(simple_path, make_simple(adc));
+    CHECK(!any_charged(adc));
+
+    auto dense = read_frame(dense_path);
+    auto simple = read_frame(simple_path);
+    const auto& dtraces = *dense->traces();
+    const auto& straces = *simple->traces();
+    REQUIRE(dtraces.size() == 4);
+    REQUIRE(straces.size() == 4);
+    for (size_t ind = 0; ind < 4; ++ind) {
+        CHECK(dtraces[ind]->channel() == straces[ind]->channel());
+        CHECK(dtraces[ind]->tbin() == straces[ind]->tbin());
+        CHECK(dtraces[ind]->charge() == straces[ind]->charge());
+        const float* beg = adc->traces()->at(ind)->samples();
+        CHECK(dtraces[ind]->charge() == ITrace::ChargeSequence(beg, beg + view.ncols));
+    }
+}
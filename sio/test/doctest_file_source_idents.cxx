@@ -0,0 +1,170 @@
+// File sources selecting frames and tensor sets by ident.
+#include "WireCellSio/FrameFileSink.h"
+#include "WireCellSio/FrameFileSource.h"
+#include "WireCellSio/TensorFileSink.h"
+#include "WireCellSio/TensorFileSource.h"
+
+#include "WireCellAux/SimpleFrame.h"
+#include "WireCellAux/SimpleTensor.h"
+#include "WireCellAux/SimpleTensorSet.h"
+#include "WireCellAux/SimpleTrace.h"
+#include "WireCellUtil/Persist.h"
+#include "WireCellUtil/Units.h"
+#include "WireCellUtil/doctest.h"
+
+using namespace WireCell;
+
+static const std::vector<int> all_idents{1, 2, 3, 4, 5};
+
+static IFrame::pointer make_frame(int ident)
+{
+    ITrace::vector traces;
+    for (int chid = 10; chid < 13; ++chid) {
+        ITrace::ChargeSequence charge(4, 100 * ident + chid);
+        traces.push_back(std::make_shared<Aux::SimpleTrace>(chid, 0, charge));
+    }
+    return std::make_shared<Aux::SimpleFrame>(ident, ident * units::ms, traces, 0.5 * units::us);
+}
+
+static ITensorSet::pointer make_set(int ident)
+{
+    std::vector<float> data(6, ident);
+    Configuration md;
+    md["ident"] = ident;
+    auto tens = std::make_shared<ITensor::vector>();
+    tens->push_back(std::make_shared<Aux::SimpleTensor>(ITensor::shape_t{2, 3}, data.data(), md));
+    return std::make_shared<Aux::SimpleTensorSet>(ident, md, tens);
+}
+
+static Configuration jidents(const std::vector<int>& idents)
+{
+    Configuration ret = Json::arrayValue;
+    for (int ident : idents) {
+        ret.append(ident);
+    }
+    return ret;
+}
+
+static void write_frames(const std::string& path)
+{
+    Sio::FrameFileSink sink;
+    auto cfg = sink.default_configuration();
+    cfg["outname"] = path;
+    sink.configure(cfg);
+    for (int ident : all_idents) {
+        REQUIRE(sink(make_frame(ident)));
+    }
+    REQUIRE(sink(nullptr));
+    sink.finalize();
+}
+
+static std::vector<int> read_frames(const std::string& path, const std::vector<int>& idents)
+{
+    Sio::FrameFileSource src;
+    auto cfg = src.default_configuration();
+    cfg["inname"] = path;
+    cfg["idents"] = jidents(idents);
+    src.configure(cfg);
+
+    std::vector<int> got;
+    while (true) {
+        IFrame::pointer frame;
+        REQUIRE(src(frame));
+        if (!frame) {
+            break;
+        }
+        got.push_back(frame->ident());
+
+        const auto want = make_frame(frame->ident());
+        CHECK(frame->time() == want->time());
+        const auto& traces = *frame->traces();
+        REQUIRE(traces.size() == want->traces()->size());
+        for (size_t ind = 0; ind < traces.size(); ++ind) {
+            CHECK(traces[ind]->channel() == want->traces()->at(ind)->channel());
+            CHECK(traces[ind]->charge() == want->traces()->at(ind)->charge());
+        }
+    }
+    IFrame::pointer frame;
+    CHECK(!src(frame));         // past EOS
+    CHECK(!frame);
+    return got;
+}
+
+static void write_sets(const std::string& path)
+{
+    Sio::TensorFileSink sink;
+    auto cfg = sink.default_configuration();
+    cfg["outname"] = path;
+    sink.configure(cfg);
+    for (int ident : all_idents) {
+        REQUIRE(sink(make_set(ident)));
+    }
+    REQUIRE(sink(nullptr));
+    sink.finalize();
+}
+
+static std::vector<int> read_sets(const std::string& path, const std::vector<int>& idents, bool mmap)
+{
+    Sio::TensorFileSource src;
+    auto cfg = src.default_configuration();
+    cfg["inname"] = path;
+    cfg["idents"] = jidents(idents);
+    cfg["mmap"] = mmap;
+    src.configure(cfg);
+
+    std::vector<int> got;
+    while (true) {
+        ITensorSet::pointer ts;
+        REQUIRE(src(ts));
+        if (!ts) {
+            break;
+        }
+        got.push_back(ts->ident());
+        CHECK(ts->metadata()["ident"].asInt() == ts->ident());
+        const auto& tens = *ts->tensors();
+        REQUIRE(tens.size() == 1);
+        REQUIRE(tens[0]->size() == 6 * sizeof(float));
+        const float* data = reinterpret_cast<const float*>(tens[0]->data());
+        CHECK(data[5] == ts->ident());
+    }
+    ITensorSet::pointer ts;
+    CHECK(!src(ts));            // past EOS
+    CHECK(!ts);
+    return got;
+}
+
+// Selected idents come out in file order, whatever their order in
+// the configuration.
+static const std::vector<int> select_idents{4, 2};
+static const std::vector<int> want_idents{2, 4};
+
+TEST_CASE("sio frame file source idents")
+{
+    Persist::TempDir td;
+    for (std::string ext : {".tar", ".npz", ".tar.gz"}) {
+        CAPTURE(ext);
+        const std::string path = (td.path / ("frames" + ext)).string();
+        write_frames(path);
+        CHECK(read_frames(path, {}) == all_idents);
+        CHECK(read_frames(path, select_idents) == want_idents);
+        CHECK(read_frames(path, {5}) == std::vector<int>{5});
+        CHECK(read_frames(path, {42}).empty());
+    }
+}
+
+TEST_CASE("sio tensor file source idents")
+{
+    Persist::TempDir td;
+    for (std::string ext : {".tar", ".npz", ".tar.gz"}) {
+        const std::string path = (td.path / ("tensors" + ext)).string();
+        write_sets(path);
+        for (bool mmap : {false, true}) {
+            CAPTURE(ext);
+            CAPTURE(mmap);
+            CHECK(read_sets(path, {}, mmap) == all_idents);
+            CHECK(read_sets(path, select_idents, mmap) == want_idents);
+            CHECK(read_sets(path, {5}, mmap) == std::vector<int>{5});
+            CHECK(read_sets(path, {42}, mmap).empty());
+        }
+    }
+}
@@ -0,0 +1,249 @@
+// TensorFileSource reading memory mapped archives.
+#include "WireCellSio/TensorFileSink.h"
+#include "WireCellSio/TensorFileSource.h"
+
+#include "WireCellAux/SimpleTensor.h"
+#include "WireCellAux/SimpleTensorSet.h"
+#include "WireCellUtil/Persist.h"
+#include "WireCellUtil/Stream.h"
+#include "WireCellUtil/doctest.h"
+
+#include <boost/filesystem.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace WireCell;
+
+static ITensorSet::pointer make_set(int ident)
+{
+    auto tens = std::make_shared<ITensor::vector>();
+
+    std::vector<double> dbl(3 * 5);
+    for (size_t ind = 0; ind < dbl.size(); ++ind) {
+        dbl[ind] = ident + 0.25 * ind;
+    }
+    Configuration md;
+    md["name"] = "dbl";
+    tens->push_back(std::make_shared<Aux::SimpleTensor>(ITensor::shape_t{3, 5}, dbl.data(), md));
+
+    std::vector<int> ints(7);
+    for (size_t ind = 0; ind < ints.size(); ++ind) {
+        ints[ind] = 100 * ident + ind;
+    }
+    md["name"] = "int";
+    tens->push_back(std::make_shared<Aux::SimpleTensor>(ITensor::shape_t{7}, ints.data(), md));
+
+    // Array-less
+    md["name"] = "none";
+    tens->push_back(std::make_shared<Aux::SimpleTensor>(md));
+
+    Configuration setmd;
+    setmd["ident"] = ident;
+    return std::make_shared<Aux::SimpleTensorSet>(ident, setmd, tens);
+}
+
+static void write_sets(const std::string& path, const std::vector<int>& idents, const std::string& prefix = "")
+{
+    Sio::TensorFileSink sink;
+    auto cfg = sink.default_configuration();
+    cfg["outname"] = path;
+    cfg["prefix"] = prefix;
+    sink.configure(cfg);
+    for (int ident : idents) {
+        REQUIRE(sink(make_set(ident)));
+    }
+    REQUIRE(sink(nullptr));
+    sink.finalize();
+}
+
+// Rewrite a tar as a zip with uncompressed members, as numpy.savez
+// makes, after an empty member.
+static void tar_to_stored_zip(const std::string& tarpath, const std::string& zippath)
+{
+    mz_zip_archive zip;
+    memset(&zip, 0, sizeof(mz_zip_archive));
+    REQUIRE(mz_zip_writer_init_file(&zip, zippath.c_str(), 0));
+    REQUIRE(mz_zip_writer_add_mem(&zip, "empty.txt", "", 0, MZ_NO_COMPRESSION));
+
+    boost::iostreams::filtering_istream in;
+    Stream::input_filters(in, tarpath);
+    while (true) {
+        std::string fname;
+        size_t fsize = 0;
+        custard::read(in, fname, fsize);
+        if (!in) {
+            break;
+        }
+        std::string buf(fsize, 0);
+        in.read(buf.data(), fsize);
+        REQUIRE(mz_zip_writer_add_mem(&zip, fname.c_str(), buf.data(), fsize, MZ_NO_COMPRESSION));
+    }
+    REQUIRE(mz_zip_writer_finalize_archive(&zip));
+    REQUIRE(mz_zip_writer_end(&zip));
+}
+
+static std::shared_ptr<Sio::TensorFileSource> make_source(const std::string& path, bool mmap,
+                                                          const std::string& prefix = "")
+{
+    auto src = std::make_shared<Sio::TensorFileSource>();
+    auto cfg = src->default_configuration();
+    cfg["inname"] = path;
+    cfg["prefix"] = prefix;
+    cfg["mmap"] = mmap;
+    src->configure(cfg);
+    return src;
+}
+
+static ITensorSet::vector read_sets(Sio::TensorFileSource& src)
+{
+    ITensorSet::vector ret;
+    while (true) {
+        ITensorSet::pointer ts;
+        REQUIRE(src(ts));
+        if (!ts) {
+            break;
+        }
+        ret.push_back(ts);
+    }
+    ITensorSet::pointer ts;
+    CHECK(!src(ts));            // past EOS
+    return ret;
+}
+
+static void require_same(const ITensorSet::vector& got, const std::vector<int>& idents)
+{
+    REQUIRE(got.size() == idents.size());
+    for (size_t iset = 0; iset < got.size(); ++iset) {
+        const auto want = make_set(idents[iset]);
+        REQUIRE(got[iset]->ident() == want->ident());
+        REQUIRE(got[iset]->metadata() == want->metadata());
+        const auto& gtens = *got[iset]->tensors();
+        const auto& wtens = *want->tensors();
+        REQUIRE(gtens.size() == wtens.size());
+        for (size_t iten = 0; iten < gtens.size(); ++iten) {
+            REQUIRE(gtens[iten]->metadata() == wtens[iten]->metadata());
+            REQUIRE(gtens[iten]->size() == wtens[iten]->size());
+            if (!wtens[iten]->size()) {
+                continue;
+            }
+            REQUIRE(gtens[iten]->dtype() == wtens[iten]->dtype());
+            REQUIRE(gtens[iten]->shape() == wtens[iten]->shape());
+            REQUIRE(0 == memcmp(gtens[iten]->data(), wtens[iten]->data(), wtens[iten]->size()));
+        }
+    }
+}
+
+// Return the address ranges at which the file is mapped into this
+// process.
+static std::vector<std::pair<uintptr_t, uintptr_t>> mapped_ranges(const std::string& path)
+{
+    const std::string want = boost::filesystem::canonical(path).string();
+    std::vector<std::pair<uintptr_t, uintptr_t>> ret;
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    while (std::getline(maps, line)) {
+        std::istringstream ss(line);
+        std::string range, perms, offset, dev, inode, fname;
+        ss >> range >> perms >> offset >> dev >> inode >> fname;
+        if (fname != want) {
+            continue;
+        }
+        const auto dash = range.find('-');
+        ret.emplace_back(std::stoull(range.substr(0, dash), nullptr, 16),
+                         std::stoull(range.substr(dash + 1), nullptr, 16));
+    }
+    return ret;
+}
+
+// Count array tensors whose data is inside and outside the mapping.
+// Those inside must be aligned.
+static std::pair<size_t, size_t> count_mapped(const ITensorSet::vector& sets, const std::string& path)
+{
+    const auto ranges = mapped_ranges(path);
+    size_t nin = 0, nout = 0;
+    for (const auto& ts : sets) {
+        for (const auto& ten : *ts->tensors()) {
+            if (!ten->size()) {
+                continue;
+            }
+            const auto addr = reinterpret_cast<uintptr_t>(ten->data());
+            bool inside = false;
+            for (const auto& [lo, hi] : ranges) {
+                inside = inside or (lo <= addr and addr + ten->size() <= hi);
+            }
+            if (inside) {
+                ++nin;
+                CHECK(addr % ten->element_size() == 0);
+            }
+            else {
+                ++nout;
+            }
+        }
+    }
+    return {nin, nout};
+}
+
+TEST_CASE("sio tensor file source mmap tar")
+{
+    Persist::TempDir td;
+    const std::string path = (td.path / "tensors.tar").string();
+    const std::vector<int> idents{1, 2, 3};
+    write_sets(path, idents);
+
+    auto streamed = read_sets(*make_source(path, false));
+    require_same(streamed, idents);
+    CHECK(count_mapped(streamed, path) == std::make_pair<size_t, size_t>(0, 6));
+
+    auto src = make_source(path, true);
+    auto mapped = read_sets(*src);
+    require_same(mapped, idents);
+    // Tar member data and npy arrays are always aligned.
+    CHECK(count_mapped(mapped, path) == std::make_pair<size_t, size_t>(6, 0));
+
+    // Tensors keep the mapping after the source is gone, and the
+    // mapping goes when they are.
+    src = nullptr;
+    CHECK(!mapped_ranges(path).empty());
+    require_same(mapped, idents);
+    mapped.clear();
+    CHECK(mapped_ranges(path).empty());
+}
+
+TEST_CASE("sio tensor file source mmap npz")
+{
+    Persist::TempDir td;
+    const std::vector<int> idents{4, 5};
+
+    // The sink deflates zip members which can not be mapped.
+    const std::string npz = (td.path / "deflated.npz").string();
+    write_sets(npz, idents);
+    auto deflated = read_sets(*make_source(npz, true));
+    require_same(deflated, idents);
+    CHECK(mapped_ranges(npz).empty());
+
+    // Stored members are mapped unless their data is misaligned.
+    // Prefixes of different length shift the data in the file so
+    // that some arrays must be copied.
+    size_t nin = 0, nout = 0;
+    for (std::string prefix : {"", "a", "ab", "abc", "abcd", "abcde", "abcdef", "abcdefg"}) {
+        CAPTURE(prefix);
+        const std::string tar = (td.path / ("stored" + prefix + ".tar")).string();
+        const std::string zip = (td.path / ("stored" + prefix + ".npz")).string();
+        write_sets(tar, idents, prefix);
+        tar_to_stored_zip(tar, zip);
+
+        auto streamed = read_sets(*make_source(zip, false, prefix));
+        require_same(streamed, idents);
+
+        auto mapped = read_sets(*make_source(zip, true, prefix));
+        require_same(mapped, idents);
+        const auto [in, out] = count_mapped(mapped, zip);
+        CHECK(in + out == 4);
+        nin += in;
+        nout += out;
+    }
+    CHECK(nin > 0);
+    CHECK(nout > 0);
+}
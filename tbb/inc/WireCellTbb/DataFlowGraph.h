@@ -40,6 +40,10 @@ namespace WireCellTbb {
 
         // if 0, no summary logged, else log at level 1=debug, 2=info
         int m_summary{1};
+
+        // if nonempty, write a Chrome trace-event file of node calls
+        std::string m_trace_file{""};
+        bool m_trace_rss{false};
         std::unordered_set<WireCellTbb::Node> m_nodes;
     };
 
@@ -37,9 +37,9 @@ namespace WireCellTbb {
         TupleType operator()(msg_t in) const
         {
             any_vector anyvec;
-            m_info.start();
+            auto call = m_info.start();
             bool ok = (*m_wcnode)(in.second, anyvec);
-            m_info.stop();
+            m_info.stop(call);
             if (!ok ) {
                 std::cerr << "TbbFlow: fanout call fails\n";
             }
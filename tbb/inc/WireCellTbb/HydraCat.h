@@ -158,9 +158,9 @@ namespace WireCellTbb {
             size_t index = in.first;
             iqv[index].push_back(in.second.second);
 
-            m_info.start();
+            auto call = m_info.start();
             bool ok = (*m_wcnode)(iqv, oqv);
-            m_info.stop();
+            m_info.stop(call);
             if (!ok) {
                 std::cerr << "TbbFlow: hydra body return false ignored\n";
             }
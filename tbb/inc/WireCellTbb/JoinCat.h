@@ -36,9 +36,9 @@ namespace WireCellTbb {
                 in.push_back(msg.second);
             }
             wct_t out;
-            m_info.start();
+            auto call = m_info.start();
             bool ok = (*m_wcnode)(in, out);
-            m_info.stop();
+            m_info.stop(call);
             if (!ok) {
                 std::cerr << "TbbFlow: join node return false ignored\n";
             }
@@ -4,6 +4,8 @@
 #include "WireCellIface/INode.h"
 #include "WireCellIface/INamed.h"
 #include "WireCellUtil/TupleHelpers.h"
+#include "WireCellUtil/TraceEvents.h"
+#include "WireCellUtil/Type.h"
 
 #include <tbb/flow_graph.h>
 #include <boost/any.hpp>
@@ -13,6 +15,7 @@
 #include <memory>
 #include <chrono>
 #include <map>
+#include <mutex>
 
 namespace WireCellTbb {
 
@@ -60,17 +63,44 @@ namespace WireCellTbb {
             return "(unknown)";
         }
 
+        // If set, also record each call as a span.
+        void set_trace(std::shared_ptr<WireCell::TraceEvents> trace) {
+            m_trace = trace;
+            m_trace_name = WireCell::type(*m_inode) + ":" + instance_name();
+        }
+
+        using clock_t = std::chrono::high_resolution_clock;
+
+        // The state of one call, held by the caller so that calls
+        // overlapping on a node with concurrency > 1 do not clobber
+        // each other.
+        struct Call {
+            clock_t::time_point clock;
+            WireCell::TraceEvents::Stamp stamp;
+        };
+
         // Start/stop the stop watch.
-        void start() {
-            m_clock = std::chrono::high_resolution_clock::now();
+        Call start() const {
+            Call call;
+            if (m_trace) {
+                call.stamp = m_trace->start();
+            }
+            call.clock = clock_t::now();
+            return call;
         }
-        void stop() {
-            duration_t delta = std::chrono::high_resolution_clock::now() - m_clock;
-            m_runtime += delta;
-            if (delta > m_maxrt) {
-                m_maxrt = delta;
+        void stop(const Call& call) {
+            duration_t delta = clock_t::now() - call.clock;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_runtime += delta;
+                if (delta > m_maxrt) {
+                    m_maxrt = delta;
+                }
+                ++m_calls;
+            }
+            if (m_trace) {
+                m_trace->stop(call.stamp, m_trace_name);
             }
-            ++m_calls;
         }
 
         //using duration_t = std::chrono::high_resolution_clock::duration;
@@ -92,11 +122,11 @@ namespace WireCellTbb {
       private:
         WireCell::INode::pointer m_inode;
         duration_t m_runtime {0}, m_maxrt{0};
-        using clock_t = std::chrono::high_resolution_clock;
-        using time_point_t = clock_t::time_point;
-        time_point_t m_clock;
-
         size_t m_calls{0};
+        std::mutex m_mutex;
+
+        std::shared_ptr<WireCell::TraceEvents> m_trace;
+        std::string m_trace_name;
     };
     std::ostream& operator<<(std::ostream& os, const NodeInfo& info);
 
@@ -114,6 +144,8 @@ namespace WireCellTbb {
         virtual void initialize() {}
 
         const NodeInfo& info() const { return m_info; };
+
+        void set_trace(std::shared_ptr<WireCell::TraceEvents> trace) { m_info.set_trace(trace); }
       protected:
         NodeInfo m_info;
     };
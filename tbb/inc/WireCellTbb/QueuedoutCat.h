@@ -29,9 +29,9 @@ namespace WireCellTbb {
         void operator()(const msg_t& in, mfunc_port& out)
         {
             WireCell::IQueuedoutNodeBase::queuedany outq;
-            m_info.start();
+            auto call = m_info.start();
             bool ok = (*m_wcnode)(in.second, outq);
-            m_info.stop();
+            m_info.stop(call);
             if (!ok) {
                 std::cerr << "TbbFlow: queuedout node return false ignored\n";
                 return;
@@ -24,9 +24,9 @@ namespace WireCellTbb {
         }
         tbb::flow::continue_msg operator()(const msg_t& in)
         {
-            m_info.start();
+            auto call = m_info.start();
             bool ok = (*m_wcnode)(in.second);
-            m_info.stop();
+            m_info.stop(call);
             if (!ok) {
                 std::cerr << "TbbFlow: sink node return false ignored\n";
             }
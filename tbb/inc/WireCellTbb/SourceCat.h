@@ -24,9 +24,9 @@ namespace WireCellTbb {
         }
         msg_t operator()(tbb::flow_control& fc) {
             wct_t out;
-            m_info.start();
+            auto call = m_info.start();
             bool ok = (*m_wcnode)(out);
-            m_info.stop();
+            m_info.stop(call);
             if (ok) {
                 return msg_t(m_seqno++, out);
             }
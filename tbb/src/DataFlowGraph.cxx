@@ -27,6 +27,12 @@ Configuration DataFlowGraph::default_configuration() const
     Configuration cfg;
     cfg["max_threads"] = 0;
     cfg["summary"] = m_summary;
+    // Name a file to receive a Chrome trace-event JSON timeline of
+    // node calls.  See WireCellUtil/TraceEvents.h.
+    cfg["trace_file"] = m_trace_file;
+    // Sample resident memory for each call, requires a read of /proc.
+    // This is process memory so by default it is sampled only when
+    // max_threads is 1 as otherwise concurrent nodes blur it.
     return cfg;
 }
 
@@ -36,6 +42,8 @@ void DataFlowGraph::configure(const Configuration& cfg)
         m_thread_limit = cfg["max_threads"].asInt();
     }
     m_summary = get(cfg, "summary", m_summary);
+    m_trace_file = get(cfg, "trace_file", m_trace_file);
+    m_trace_rss = get(cfg, "trace_rss", m_thread_limit == 1);
 }
 
 bool DataFlowGraph::connect(INode::pointer tail, INode::pointer head, size_t sport, size_t rport)
@@ -114,6 +122,14 @@ bool DataFlowGraph::run()
         it.second->initialize();
     }
 
+    std::shared_ptr<TraceEvents> trace;
+    if (!m_trace_file.empty()) {
+        trace = std::make_shared<TraceEvents>(m_trace_rss);
+        for (const auto& node : m_nodes) {
+            node->set_trace(trace);
+        }
+    }
+
     std::unique_ptr<tbb::global_control> gc;
     if (m_thread_limit) {
         gc = std::make_unique<tbb::global_control>(
@@ -122,6 +138,14 @@ bool DataFlowGraph::run()
     }
     m_graph.wait_for_all();
 
+    if (trace) {
+        log->debug("writing trace events to {}", m_trace_file);
+        trace->write(m_trace_file);
+        for (const auto& node : m_nodes) {
+            node->set_trace(nullptr);
+        }
+    }
+
     if (m_summary) {
         std::vector<WireCellTbb::Node> nodes(m_nodes.begin(), m_nodes.end());
         std::sort(nodes.begin(), nodes.end(),
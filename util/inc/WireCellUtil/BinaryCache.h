@@ -0,0 +1,183 @@
+/** A compact, memory-mappable binary form for data otherwise loaded
+    from (compressed) JSON files such as field responses and wires.
+
+    A binary file is a fixed header followed by a flat payload of
+    native-endian plain data and length-prefixed arrays.  Arrays start
+    on 8 byte boundaries so the reader may hand out pointers directly
+    into the mapped file.
+
+    The header carries a "kind" code and a hash of the bytes of the
+    source file from which the binary was made.  When the environment
+    variable WIRECELL_CACHE names a directory, loaders will look there
+    for a binary keyed by the hash of their source file and will fill
+    it on a miss.  A change to the source file changes the hash and so
+    a stale binary is never used.
+
+    Binary files are specific to the host byte order and the format
+    version.  Either mismatch is reported as an IOError by the reader
+    and loaders fall back to parsing the source.
+ */
+
+#ifndef WIRECELLUTIL_BINARYCACHE
+#define WIRECELLUTIL_BINARYCACHE
+
+#include "WireCellUtil/Exceptions.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace WireCell::BinaryCache {
+
+    /// File name extension marking a binary file.
+    const std::string extension = ".wcb";
+
+    /// Kind codes for the payload types.
+    enum Kind : uint32_t {
+        field_response = 0x50535246,  // "FRSP"
+        wire_store = 0x45524957,      // "WIRE"
+    };
+
+    /// Return true if filename has the binary extension.
+    bool is_binary(const std::string& filename);
+
+    /// Return a 64 bit FNV-1a hash of the bytes of the file.  Throws
+    /// IOError if the file can not be read.
+    uint64_t content_hash(const std::string& filename);
+
+    /// Return the cache directory from WIRECELL_CACHE or empty string
+    /// if caching is not enabled.
+    std::string cache_dir();
+
+    /// Return the path in the cache directory for a binary made from
+    /// the source file with the given content hash.  Returns empty
+    /// string if caching is not enabled.
+    std::string cache_path(const std::string& source, uint64_t hash);
+
+    /// Accumulate a payload and write it as a binary file.
+    class Writer {
+       public:
+        template <typename T>
+        void put(const T& val)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "binary cache holds plain data");
+            append(&val, sizeof(T));
+        }
+
+        template <typename T>
+        void put_array(const T* data, uint64_t n)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "binary cache holds plain data");
+            pad();
+            put(n);
+            append(data, n * sizeof(T));
+        }
+
+        template <typename T>
+        void put_array(const std::vector<T>& vec)
+        {
+            put_array(vec.data(), vec.size());
+        }
+
+        /// Write header and payload to filename.  The file is first
+        /// written to a temporary name in the same directory and then
+        /// renamed so concurrent readers never see a partial file.
+        void write(const std::string& filename, uint32_t kind, uint64_t hash) const;
+
+       private:
+        void append(const void* data, size_t size);
+        void pad();
+        std::string m_buf;
+    };
+
+    /// Map a binary file and read its payload in order.
+    class Reader {
+       public:
+        /// Map the file and check its header.  A nonzero hash must
+        /// match the one in the header.  Throws IOError on mismatch
+        /// or if the file can not be mapped.
+        Reader(const std::string& filename, uint32_t kind, uint64_t hash = 0);
+
+        template <typename T>
+        T get()
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "binary cache holds plain data");
+            T val;
+            std::memcpy(&val, take(sizeof(T)), sizeof(T));
+            return val;
+        }
+
+        /// Return pointer to n elements directly in the mapped file.
+        /// It is valid for the lifetime of the Reader.
+        template <typename T>
+        const T* get_array(uint64_t& n)
+        {
+            skip_pad();
+            n = get<uint64_t>();
+            return reinterpret_cast<const T*>(take(n * sizeof(T)));
+        }
+
+        template <typename T>
+        std::vector<T> get_vector()
+        {
+            uint64_t n = 0;
+            const T* data = get_array<T>(n);
+            return std::vector<T>(data, data + n);
+        }
+
+        /// The source hash recorded in the header.
+        uint64_t hash() const { return m_hash; }
+
+        /// True if the whole payload has been consumed.
+        bool done() const { return m_pos == m_end; }
+
+       private:
+        const char* take(size_t size);
+        void skip_pad();
+        std::shared_ptr<const void> m_map;
+        const char *m_beg{nullptr}, *m_pos{nullptr}, *m_end{nullptr};
+        uint64_t m_hash{0};
+        std::string m_filename;
+    };
+
+    /// Return the cache path for source and set its content hash.
+    /// Returns empty string if caching is not enabled.
+    std::string cache_lookup(const std::string& source, uint64_t& hash);
+
+    /// Write to the cache path.  Failures are logged, not thrown, as
+    /// the cache is only an optimization.
+    void cache_store(const Writer& writer, const std::string& path, uint32_t kind, uint64_t hash);
+
+    /// Return an object made from the source file, going through the
+    /// cache if enabled.  The parse(source) callable makes the object
+    /// from the source file, read(Reader&) makes it from a binary and
+    /// write(Writer&, obj) serializes it.  A missing, stale or
+    /// unreadable binary falls back to parse() and refills the cache.
+    template <typename T, typename Parse, typename Read, typename Write>
+    T load_cached(const std::string& source, uint32_t kind, Parse parse, Read read, Write write)
+    {
+        uint64_t hash = 0;
+        const auto path = cache_lookup(source, hash);
+        if (path.empty()) {
+            return parse(source);
+        }
+        try {
+            Reader reader(path, kind, hash);
+            return read(reader);
+        }
+        catch (const IOError&) {
+            // miss
+        }
+        T obj = parse(source);
+        Writer writer;
+        write(writer, obj);
+        cache_store(writer, path, kind, hash);
+        return obj;
+    }
+
+}  // namespace WireCell::BinaryCache
+
+#endif
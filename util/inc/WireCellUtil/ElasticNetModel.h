@@ -31,6 +31,13 @@ namespace WireCell {
         // These can be ignored or the fit may be retried with these variables removed.
         virtual std::vector<size_t> Fit();
 
+        // Fit with a sparse design matrix given in place of GetX().
+        // Coordinate descent runs on the active set and keeps the
+        // residual y - X*beta updated in place so each coordinate
+        // step costs only the non-zeros of its column.  Any beta
+        // already set (of matching size) is used as a warm start.
+        std::vector<size_t> FitSparse(const Eigen::SparseMatrix<double>& X);
+
        protected:
         double _soft_thresholding(double x, double lambda_);
         std::vector<bool> _active_beta;
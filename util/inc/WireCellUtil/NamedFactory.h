@@ -13,6 +13,7 @@
 
 #include <iostream>  // fixme: remove
 #include <exception>
+#include <mutex>
 #include <string>
 #include <set>
 
@@ -40,6 +41,7 @@ namespace WireCell {
         /// Return existing instance of given name or nullptr if not found.
         Interface::pointer find(const std::string& name)
         {
+            std::lock_guard<std::recursive_mutex> lock(m_mutex);
             auto it = m_objects.find(name);
             if (it == m_objects.end()) {
                 return nullptr;
@@ -51,6 +53,7 @@ namespace WireCell {
         Interface::pointer create() { return create(""); }
         Interface::pointer create(const std::string& name)
         {
+            std::lock_guard<std::recursive_mutex> lock(m_mutex);
             auto it = m_objects.find(name);
             if (it == m_objects.end()) {
                 pointer_type p(new Type);
@@ -66,6 +69,7 @@ namespace WireCell {
        private:
         std::unordered_map<std::string, pointer_type> m_objects;
         std::string m_classname;
+        std::recursive_mutex m_mutex;
     };
 
     /** A registry of factories that produce instances which implement
@@ -87,14 +91,20 @@ namespace WireCell {
         }
         size_t hello(const std::string& classname)
         {
+            std::lock_guard<std::mutex> lock(m_mutex);
             m_known_types.insert(classname);
             return m_known_types.size();
         }
-        known_type_set known_types() const { return m_known_types; }
+        known_type_set known_types() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_known_types;
+        }
 
         /// Register an existing factory by the "class" name of the instance it can create.
         bool associate(const std::string& classname, factory_ptr factory)
         {
+            std::lock_guard<std::mutex> lock(m_mutex);
             m_lookup[classname] = factory;
             return true;
         }
@@ -107,12 +117,16 @@ namespace WireCell {
                 return nullptr;
             }
 
-            auto it = m_lookup.find(classname);
-            if (it != m_lookup.end()) {
-                return it->second;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_lookup.find(classname);
+                if (it != m_lookup.end()) {
+                    return it->second;
+                }
             }
 
-            // cache miss, try plugin
+            // cache miss, try plugin.  The lock is not held here as
+            // the factory maker will associate() with registries.
 
             WireCell::PluginManager& pm = WireCell::PluginManager::instance();
 
@@ -138,6 +152,7 @@ namespace WireCell {
             }
 
             factory_ptr fptr = reinterpret_cast<factory_ptr>(fac_void_ptr);
+            std::lock_guard<std::mutex> lock(m_mutex);
             m_lookup[classname] = fptr;
             return fptr;
         }
@@ -199,6 +214,7 @@ namespace WireCell {
         /// automatically register their factories.
         std::vector<std::string> known_classes()
         {
+            std::lock_guard<std::mutex> lock(m_mutex);
             std::vector<std::string> ret;
             for (auto it : m_lookup) {
                 ret.push_back(it.first);
@@ -209,6 +225,7 @@ namespace WireCell {
        private:
         factory_lookup m_lookup;
         known_type_set m_known_types;
+        mutable std::mutex m_mutex;
     };
 
     /// Singleton interface
@@ -326,12 +343,12 @@ namespace WireCell {
 template <class Concrete, class... Interface>
 void* make_named_factory_factory(std::string name)
 {
-    static void* void_factory = nullptr;
-    if (!void_factory) {
-        void_factory = new WireCell::NamedFactory<Concrete>;
-        WireCell::NamedFactory<Concrete>* factory = reinterpret_cast<WireCell::NamedFactory<Concrete>*>(void_factory);
+    // Function-local static initialization is thread safe.
+    static void* void_factory = [&]() {
+        auto* factory = new WireCell::NamedFactory<Concrete>;
         std::vector<bool> ret{WireCell::Factory::associate<Interface>(name, factory)...};
-    }
+        return reinterpret_cast<void*>(factory);
+    }();
     return void_factory;
 }
 
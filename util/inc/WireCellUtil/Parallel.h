@@ -0,0 +1,28 @@
+/** Simple fork-join helpers for loops with independent iterations.
+
+    These are meant for use inside a single component call where a
+    loop over independent work items (planes, channel groups, faces)
+    may be spread over a few threads.  They do not nest well with an
+    outer threaded executor and callers should keep nthreads small.
+ */
+
+#ifndef WIRECELLUTIL_PARALLEL
+#define WIRECELLUTIL_PARALLEL
+
+#include <functional>
+#include <cstddef>
+
+namespace WireCell::Parallel {
+
+    /// Call func(ind) for every ind in [0, n) using up to nthreads
+    /// threads, the calling thread included.  Items are handed out in
+    /// increasing order but may complete in any order.  If nthreads
+    /// is 0 or 1 or n is 1 the loop runs serially in the calling
+    /// thread.  If any call throws, remaining items are skipped and
+    /// the exception of the lowest failing index is rethrown after
+    /// all threads are joined.
+    void for_each(size_t n, size_t nthreads, const std::function<void(size_t)>& func);
+
+}  // namespace WireCell::Parallel
+
+#endif
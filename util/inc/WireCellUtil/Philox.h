@@ -0,0 +1,177 @@
+/** A counter-based pseudo random number engine.
+
+    This implements the Philox4x32-10 bijection of Salmon et al, "Parallel
+    Random Numbers: As Easy as 1, 2, 3" (SC11) as a C++ uniform random bit
+    generator so it may be used with <random> distributions.
+
+    The output is a pure function of a 64 bit key and a 128 bit counter.
+    Here the upper half of the counter names a "stream" and the lower half
+    is the position in the stream.  Independent, reproducible substreams
+    are had by giving each unit of work (eg event, anode, plane, channel)
+    its own stream number with no need to share or advance any state.
+ */
+
+#ifndef WIRECELLUTIL_PHILOX
+#define WIRECELLUTIL_PHILOX
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace WireCell {
+
+    class Philox4x32 {
+       public:
+        using result_type = uint32_t;
+        using key_type = std::array<uint32_t, 2>;
+        using ctr_type = std::array<uint32_t, 4>;
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return 0xFFFFFFFF; }
+
+        explicit Philox4x32(uint64_t key = 0, uint64_t stream = 0) { reset(key, stream); }
+
+        /// Seed key and stream from a seed sequence as std engines do.
+        template <typename SeedSeq>
+        void seed(SeedSeq& seq)
+        {
+            std::array<uint32_t, 4> words;
+            seq.generate(words.begin(), words.end());
+            m_key = {words[0], words[1]};
+            m_ctr = {0, 0, words[2], words[3]};
+            m_index = 4;
+        }
+
+        /// Start at the beginning of the given stream.
+        void reset(uint64_t key, uint64_t stream)
+        {
+            m_key = {uint32_t(key), uint32_t(key >> 32)};
+            m_ctr = {0, 0, uint32_t(stream), uint32_t(stream >> 32)};
+            m_index = 4;
+        }
+
+        result_type operator()()
+        {
+            if (m_index == 4) {
+                m_block = block(m_ctr, m_key);
+                increment();
+                m_index = 0;
+            }
+            return m_block[m_index++];
+        }
+
+        void discard(unsigned long long n)
+        {
+            for (; n and m_index < 4; --n) {
+                ++m_index;
+            }
+            // skip whole blocks
+            uint64_t pos = (uint64_t(m_ctr[1]) << 32 | m_ctr[0]) + n / 4;
+            m_ctr[0] = uint32_t(pos);
+            m_ctr[1] = uint32_t(pos >> 32);
+            for (n %= 4; n; --n) {
+                (*this)();
+            }
+        }
+
+        /// The bare bijection: 10 rounds of Philox4x32.
+        static ctr_type block(ctr_type ctr, key_type key)
+        {
+            for (int round = 0; round < 10; ++round) {
+                if (round) {
+                    key[0] += 0x9E3779B9;
+                    key[1] += 0xBB67AE85;
+                }
+                const uint64_t p0 = uint64_t(0xD2511F53) * ctr[0];
+                const uint64_t p1 = uint64_t(0xCD9E8D57) * ctr[2];
+                ctr = {uint32_t(p1 >> 32) ^ ctr[1] ^ key[0], uint32_t(p1),
+                       uint32_t(p0 >> 32) ^ ctr[3] ^ key[1], uint32_t(p0)};
+            }
+            return ctr;
+        }
+
+        /// Fill with uniform in [lo, hi).  One word is drawn per value
+        /// so words left over in the current block are used first and
+        /// any left at the end carry over to the next draw.
+        void fill_uniform(float* out, size_t n, double lo, double hi)
+        {
+            const double scale = (hi - lo) * 0x1p-32;
+            // Rounding to float may reach hi, keep below it.
+            const float top = std::nextafter(float(hi), float(lo));
+            for (size_t ind = 0; ind < n; ++ind) {
+                out[ind] = std::min(float(lo + scale * (*this)()), top);
+            }
+        }
+
+        /// Fill with normal samples using Box-Muller on pairs of words.
+        void fill_normal(float* out, size_t n, double mean, double sigma)
+        {
+            const double twopi = 2 * M_PI;
+            size_t ind = 0;
+            while (ind < n) {
+                // (0,1] so log() is finite
+                const double u1 = ((*this)() + 1.0) * 0x1p-32;
+                const double u2 = (*this)() * 0x1p-32;
+                const double rad = sigma * std::sqrt(-2.0 * std::log(u1));
+                out[ind++] = mean + rad * std::cos(twopi * u2);
+                if (ind < n) {
+                    out[ind++] = mean + rad * std::sin(twopi * u2);
+                }
+            }
+        }
+
+        const key_type& key() const { return m_key; }
+        const ctr_type& counter() const { return m_ctr; }
+
+       private:
+        void increment()
+        {
+            if (++m_ctr[0] == 0) {
+                ++m_ctr[1];
+            }
+        }
+
+        key_type m_key;
+        ctr_type m_ctr;
+        ctr_type m_block{};
+        int m_index{4};
+    };
+
+    /// Combine a list of keys (eg event, anode, plane, channel) into
+    /// one 64 bit stream number.  Each key is folded into the hash as
+    /// boost::hash_combine() does, with a 64 bit golden ratio constant,
+    /// and the result is then mixed with the splitmix64 finalizer
+    /// before the next key.  The order of keys matters.
+    inline uint64_t philox_stream(const std::vector<size_t>& keys)
+    {
+        uint64_t h = 0x9E3779B97F4A7C15ULL;
+        for (size_t k : keys) {
+            h ^= uint64_t(k) + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+            h ^= h >> 30;
+            h *= 0xBF58476D1CE4E5B9ULL;
+            h ^= h >> 27;
+            h *= 0x94D049BB133111EBULL;
+            h ^= h >> 31;
+        }
+        return h;
+    }
+
+    /// Return a stream key naming, eg, a component "type:name".  This
+    /// is FNV-1a so the key is the same on every platform.
+    inline uint64_t philox_stream_of(const std::string& name)
+    {
+        uint64_t h = 0xCBF29CE484222325ULL;
+        for (unsigned char c : name) {
+            h ^= c;
+            h *= 0x100000001B3ULL;
+        }
+        return h;
+    }
+
+}  // namespace WireCell
+
+#endif
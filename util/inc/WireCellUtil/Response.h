@@ -10,6 +10,11 @@
 
 namespace WireCell {
 
+    namespace BinaryCache {
+        class Writer;
+        class Reader;
+    }
+
     namespace Response {
 
         //// Units notice: all quantities are expressed in the WCT
@@ -145,9 +150,20 @@ namespace WireCell {
                 ~FieldResponse();
             };
 
+            /// Load a field response file.  A file with the binary
+            /// extension (see BinaryCache.h) is memory-mapped
+            /// directly.  Otherwise it is parsed as (compressed)
+            /// JSON, going through the binary cache if enabled.
             FieldResponse load(const char* filename);
+
+            /// Dump a field response to file as binary if the file
+            /// name has the binary extension, else as JSON.
             void dump(const char* filename, const FieldResponse& fr);
 
+            /// Serialize a field response to or from a binary payload.
+            void write(BinaryCache::Writer& writer, const FieldResponse& fr);
+            FieldResponse read(BinaryCache::Reader& reader);
+
         }  // namespace Schema
 
         /// Return a reduced FieldResponse structure where the
@@ -25,6 +25,7 @@ namespace WireCell {
 
         typedef Eigen::VectorXd vector_t;
         typedef Eigen::MatrixXd matrix_t;
+        typedef Eigen::SparseMatrix<double> sparse_matrix_t;
 
         enum Model {
             unknown = 0,
@@ -55,6 +56,17 @@ namespace WireCell {
             // optional initial measurement weights
             vector_t weights = Eigen::VectorXd());
 
+        // Solve m = R*s for s with R held sparse.  The fit never
+        // forms a dense matrix and each coordinate step costs only the
+        // non-zeros in its column so this suits large, sparsely
+        // connected systems.  With params.set_init, the source is
+        // used as a warm start.
+        vector_t solve(const sparse_matrix_t& response,
+                       const vector_t& measured,
+                       const Params& params = Params(),
+                       const vector_t& source = Eigen::VectorXd(),
+                       const vector_t& weights = Eigen::VectorXd());
+
         // These function provide values derived from a solution
         // ("solved"/"source") and the input response and measured
         // vectors.
@@ -64,6 +76,10 @@ namespace WireCell {
         {
             return response * source;
         }
+        inline vector_t predict(const sparse_matrix_t& response, const vector_t& source)
+        {
+            return response * source;
+        }
 
         // Return the unbiased part of the chi2.
         inline double chi2_base(vector_t measured, vector_t predicted)
@@ -43,6 +43,12 @@ namespace WireCell::Stream {
     /// supported file types.
     using custard::output_filters;
 
+    /// Uncompressed tar and zip/npz files allow random access to
+    /// their members.  See custard::index() to list members and the
+    /// input_filters() taking a list of members to stream just those.
+    using custard::seekable;
+    using custard::members_t;
+
     /// Note, to use these practically, the ostreams need to end in a
     /// tar, zip or other container filter.
 
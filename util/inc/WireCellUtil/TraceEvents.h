@@ -0,0 +1,96 @@
+/** Record per-call timing of data flow graph nodes.
+
+    A TraceEvents collects one "span" for each call of a node giving
+    its wall-clock start and duration on a monotonic clock, the CPU
+    time consumed by the calling thread, the calling thread and the
+    change in resident memory (see MemUsage) across the call.  Nodes
+    may also report input and output counts.
+
+    Resident memory is that of the whole process.  When nodes run
+    concurrently the change over one call also counts what other
+    nodes allocated meanwhile and says little about the node itself.
+    It is written as "process_rss_kb" to make that plain.
+
+    The collection may be written as a Chrome trace-event JSON file
+    which can be loaded by chrome://tracing or https://ui.perfetto.dev
+    to view the timeline of all nodes on all threads.
+
+    Use like:
+
+      TraceEvents te;
+      ...
+      auto stamp = te.start();
+      call_node();
+      te.stop(stamp, "MyNode:name", nin, nout);
+      ...
+      te.write("trace.json");
+
+    All methods are thread safe.
+ */
+
+#ifndef WIRECELLUTIL_TRACEEVENTS
+#define WIRECELLUTIL_TRACEEVENTS
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace WireCell {
+
+    class TraceEvents {
+      public:
+        using clock_t = std::chrono::steady_clock;
+
+        // The state at the start of a call.
+        struct Stamp {
+            clock_t::time_point wall;
+            double cpu{0};      // thread CPU time in seconds
+            double rss{0};      // resident memory in kB
+        };
+
+        // One completed call.
+        struct Span {
+            std::string name;
+            size_t tid{0};       // small integer thread index
+            double start{0};     // seconds since construction
+            double wall{0};      // duration in seconds
+            double cpu{0};       // thread CPU time in seconds
+            double rss{0};       // change in process resident memory in kB
+            long nin{-1}, nout{-1};  // negative if unknown
+        };
+
+        // If with_rss is false, memory is not sampled which saves a
+        // read of /proc for each call.
+        explicit TraceEvents(bool with_rss = true);
+
+        // Sample the state at the start of a call.
+        Stamp start() const;
+
+        // Record a span from a prior start() to now.
+        void stop(const Stamp& stamp, const std::string& name,
+                  long nin = -1, long nout = -1);
+
+        // Return a copy of all spans recorded so far.
+        std::vector<Span> spans() const;
+
+        // Write all spans as Chrome trace-event JSON.  Throws IOError.
+        void write(const std::string& filename) const;
+
+        // Return CPU time consumed by the calling thread in seconds.
+        static double thread_cpu();
+
+      private:
+        const bool m_with_rss;
+        const clock_t::time_point m_origin;
+
+        mutable std::mutex m_mutex;
+        std::vector<Span> m_spans;
+        std::unordered_map<std::thread::id, size_t> m_tids;
+    };
+
+}  // namespace WireCell
+
+#endif
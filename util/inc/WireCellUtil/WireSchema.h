@@ -9,7 +9,8 @@
    - generate() :: parameterized wire store generator
 
    - load() :: loader of WCT "wires file" following the "wire data
-   schema" (typically as compressed JSON) producing a "store" object.
+   schema" (typically as compressed JSON, optionally through a binary
+   cache) producing a "store" object.
 
    - dump() :: save a store to file.
 
@@ -33,6 +34,11 @@
 
 namespace WireCell {
 
+    namespace BinaryCache {
+        class Writer;
+        class Reader;
+    }
+
     namespace WireSchema {
 
         // IWire
@@ -238,9 +244,15 @@ namespace WireCell {
         /// Load file into store performing correction
         Store load(const char* filename, Correction correction = Correction::pitch);
 
-        /// Dump store to file
+        /// Dump store to file.  If the file name has the binary
+        /// extension (see BinaryCache.h) the binary form is written
+        /// else JSON.
         void dump(const char* filename, const Store& store);
 
+        /// Serialize a store to or from a binary payload.
+        void write(BinaryCache::Writer& writer, const StoreDB& store);
+        StoreDB read(BinaryCache::Reader& reader);
+
 
         /// Return only if store is considered valid else throw ValueError.
         ///
@@ -22,6 +22,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/iostreams/device/file.hpp>
 #include <boost/iostreams/device/file_descriptor.hpp>
+#include <boost/iostreams/device/null.hpp>
 // Optional: throws link errors on some systems
 #ifdef CUSTARD_BOOST_USE_LZMA
 #include <boost/iostreams/filter/lzma.hpp>
@@ -40,8 +41,12 @@
 
 #include <vector>
 
+#include <exception>
+#include <fstream>
 #include <regex>
 #include <sstream>
+#include <thread>
+#include <zlib.h>
 
 #include <iostream> // debug
 
@@ -213,8 +218,11 @@ namespace custard {
             public boost::iostreams::closable_tag
         { };
 
-        miniz_source(const std::string& inname)
+        /// Read all members or, if "only" is given, just the
+        /// members at those indices in that order.
+        miniz_source(const std::string& inname, const std::vector<size_t>& only = {})
             : zip(std::make_shared<mz_zip_archive>())
+            , only(only)
         {
             memset(zip.get(), 0, sizeof(mz_zip_archive));
             if (!mz_zip_reader_init_file(zip.get(), inname.c_str(), 0)) {
@@ -223,7 +231,7 @@ namespace custard {
                 std::string errs = mz_zip_get_error_string(err);
                 throw std::runtime_error("failed to initialize miniz reading from " + inname + ": " + errs);
             }
-            memnum = mz_zip_reader_get_num_files(zip.get());
+            memnum = only.empty() ? mz_zip_reader_get_num_files(zip.get()) : only.size();
             memind = 0;
             memptr = member.end();
         }
@@ -257,6 +265,7 @@ namespace custard {
 
       private:
         std::shared_ptr<mz_zip_archive> zip;
+        std::vector<size_t> only;
         size_t memnum{0}, memind{0};
         std::vector<char> member;
         std::vector<char>::iterator memptr{member.end()};
@@ -269,7 +278,7 @@ namespace custard {
                 return memnum;
             }
 
-            const size_t index = memind;
+            const size_t index = only.empty() ? memind : only[memind];
             ++memind;
 
             mz_zip_archive_file_stat fs;
@@ -353,6 +362,120 @@ namespace custard {
     };
 #endif
 
+    /// A pigz-style gzip compressor.  Input is cut into blocks which
+    /// are compressed concurrently, each as an independent gzip
+    /// member.  The concatenation of members is a valid gzip file
+    /// which any gzip reader, including gzip_decompressor, accepts.
+    /// Compression ratio is slightly lower than a single member as
+    /// the dictionary is reset at each block boundary.
+    class parallel_gzip_compressor : public boost::iostreams::multichar_output_filter {
+      public:
+
+        parallel_gzip_compressor(int level = 1, size_t nthreads = 2,
+                                 size_t block_size = 1<<20)
+            : p(std::make_shared<impl>())
+        {
+            p->level = level;
+            p->nthreads = std::max<size_t>(1, nthreads);
+            p->block_size = std::max<size_t>(1<<12, block_size);
+        }
+
+        template<typename Sink>
+        std::streamsize write(Sink& dest, const char* buf, std::streamsize bufsiz)
+        {
+            p->pending.insert(p->pending.end(), buf, buf+bufsiz);
+            if (p->pending.size() >= p->nthreads * p->block_size) {
+                flush_blocks(dest, false);
+            }
+            return bufsiz;
+        }
+
+        template<typename Sink>
+        void close(Sink& dest)
+        {
+            flush_blocks(dest, true);
+        }
+
+      private:
+
+        // Compress one block as a complete gzip member.
+        static buffer_t compress(const char* data, size_t size, int level)
+        {
+            z_stream zs;
+            memset(&zs, 0, sizeof(zs));
+            // 15 window bits plus 16 for gzip header and trailer.
+            if (deflateInit2(&zs, level, Z_DEFLATED, 15+16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+                throw std::runtime_error("parallel_gzip_compressor: deflateInit2 failed");
+            }
+            buffer_t out(deflateBound(&zs, size) + 32);
+            zs.next_in = (Bytef*)data;
+            zs.avail_in = size;
+            zs.next_out = (Bytef*)out.data();
+            zs.avail_out = out.size();
+            int rc = deflate(&zs, Z_FINISH);
+            deflateEnd(&zs);
+            if (rc != Z_STREAM_END) {
+                throw std::runtime_error("parallel_gzip_compressor: deflate failed");
+            }
+            out.resize(zs.total_out);
+            return out;
+        }
+
+        // Compress whole blocks of pending data, or all of it if
+        // final, and write them in order.
+        template<typename Sink>
+        void flush_blocks(Sink& dest, bool final)
+        {
+            const size_t bs = p->block_size;
+            const size_t nblocks = final
+                ? (p->pending.size() + bs - 1) / bs
+                : p->pending.size() / bs;
+            if (!nblocks) {
+                return;
+            }
+            std::vector<buffer_t> outs(nblocks);
+            std::vector<std::exception_ptr> errs(nblocks);
+            auto work = [&](size_t first) {
+                for (size_t ind = first; ind < nblocks; ind += p->nthreads) {
+                    const size_t beg = ind*bs;
+                    const size_t size = std::min(bs, p->pending.size() - beg);
+                    try {
+                        outs[ind] = compress(p->pending.data() + beg, size, p->level);
+                    }
+                    catch (...) {
+                        errs[ind] = std::current_exception();
+                    }
+                }
+            };
+            std::vector<std::thread> threads;
+            for (size_t ith = 1; ith < std::min(p->nthreads, nblocks); ++ith) {
+                threads.emplace_back(work, ith);
+            }
+            work(0);
+            for (auto& th : threads) {
+                th.join();
+            }
+            for (auto& err : errs) {
+                if (err) {
+                    std::rethrow_exception(err);
+                }
+            }
+            for (const auto& out : outs) {
+                boost::iostreams::write(dest, out.data(), out.size());
+            }
+            p->pending.erase(p->pending.begin(),
+                             p->pending.begin() + std::min(p->pending.size(), nblocks*bs));
+        }
+
+        // this class must be copyable
+        struct impl {
+            int level{1};
+            size_t nthreads{2}, block_size{1<<20};
+            buffer_t pending;
+        };
+        std::shared_ptr<impl> p;
+    };
+
     inline
     bool assuredir(const std::string& pathname)
     {
@@ -482,13 +605,15 @@ namespace custard {
                 bodyleft -= put;
                 if (bodyleft == 0) {
                     state = State::filedone;
-                    // slurp padding
-                    const size_t jump = 512 - th.size()%512;
-                    std::string pad(jump, 0);
-                    auto got = boost::iostreams::read(src, &pad[0], jump);
-                    // std::cerr << "padleft: " << jump << " " << got << "\n";
-                    if (got < 0) {
-                        return got;
+                    // slurp padding, if any
+                    const size_t jump = (512 - th.size()%512) % 512;
+                    if (jump) {
+                        std::string pad(jump, 0);
+                        auto got = boost::iostreams::read(src, &pad[0], jump);
+                        // std::cerr << "padleft: " << jump << " " << got << "\n";
+                        if (got < 0) {
+                            return got;
+                        }
                     }
                 }
                 return put;
@@ -532,6 +657,197 @@ namespace custard {
         
     };
 
+    /// One member of an archive file.  For tar, offset is the byte
+    /// offset of the member data in the file.  For zip it is the
+    /// index of the member in the zip directory.  For either, stored
+    /// is the byte offset of the member data in the file if the data
+    /// is held uncompressed, else it is -1.
+    struct member_t {
+        std::string name{""};
+        uint64_t offset{0};
+        uint64_t size{0};
+        int64_t stored{-1};
+    };
+    using members_t = std::vector<member_t>;
+
+    /// Return true if the file supports random access to members
+    /// via index() and input_filters() with a member list.  That is
+    /// uncompressed tar and zip (whose members are compressed
+    /// individually).
+    inline
+    bool seekable(const std::string& inname)
+    {
+        auto has = [&](const std::string& things) {
+            return std::regex_search(inname, std::regex("[_.]("+things+")$"));
+        };
+#ifdef CUSTARD_BOOST_USE_MINIZ
+        if (has("zip|npz")) {
+            return true;
+        }
+#endif
+        return has("tar");
+    }
+
+    /// Return the members of a seekable archive in file order.  For
+    /// tar, only the 512 byte headers are read and bodies are
+    /// skipped.  Throws std::runtime_error if the file can not be
+    /// read.
+    inline
+    members_t index(const std::string& inname)
+    {
+        members_t ret;
+#ifdef CUSTARD_BOOST_USE_MINIZ
+        if (std::regex_search(inname, std::regex("[_.](zip|npz)$"))) {
+            mz_zip_archive zip;
+            memset(&zip, 0, sizeof(mz_zip_archive));
+            if (!mz_zip_reader_init_file(&zip, inname.c_str(), 0)) {
+                throw std::runtime_error("failed to index zip file " + inname);
+            }
+            const size_t num = mz_zip_reader_get_num_files(&zip);
+            for (size_t ind = 0; ind < num; ++ind) {
+                mz_zip_archive_file_stat fs;
+                if (!mz_zip_reader_file_stat(&zip, ind, &fs)) {
+                    mz_zip_reader_end(&zip);
+                    throw std::runtime_error("failed to stat zip member in " + inname);
+                }
+                if (mz_zip_reader_is_file_a_directory(&zip, ind)) {
+                    continue;
+                }
+                ret.push_back(member_t{fs.m_filename, ind, fs.m_uncomp_size});
+                if (fs.m_method == 0 and fs.m_comp_size == fs.m_uncomp_size) {
+                    ret.back().stored = fs.m_local_header_ofs;
+                }
+            }
+            mz_zip_reader_end(&zip);
+
+            // The data of a stored member follows its local header
+            // whose name and extra field lengths may differ from
+            // those in the central directory.
+            std::ifstream fi(inname, std::ios::binary);
+            for (auto& mem : ret) {
+                if (mem.stored < 0) {
+                    continue;
+                }
+                unsigned char lh[30];
+                fi.seekg(mem.stored);
+                fi.read((char*)lh, sizeof(lh));
+                if (!fi or lh[0] != 'P' or lh[1] != 'K' or lh[2] != 3 or lh[3] != 4) {
+                    throw std::runtime_error("bad local zip header in " + inname);
+                }
+                const uint64_t nlen = lh[26] | (lh[27] << 8);
+                const uint64_t xlen = lh[28] | (lh[29] << 8);
+                mem.stored += sizeof(lh) + nlen + xlen;
+            }
+            return ret;
+        }
+#endif
+        std::ifstream fi(inname, std::ios::binary);
+        if (!fi) {
+            throw std::runtime_error("failed to index tar file " + inname);
+        }
+        custard::Header th;
+        uint64_t pos = 0;
+        while (th.read(fi)) {
+            pos += 512;
+            const uint64_t size = th.size();
+            if (size == 0) {    // end blocks, directories, empties
+                continue;
+            }
+            ret.push_back(member_t{th.name(), pos, size, (int64_t)pos});
+            pos += (size + 511) / 512 * 512;
+            fi.seekg(pos);
+        }
+        return ret;
+    }
+
+    /// A source producing a custard stream from the given members of
+    /// an uncompressed tar file, in the given order, seeking past all
+    /// others.
+    class tar_member_source {
+      public:
+        typedef char char_type;
+        struct category :
+            public boost::iostreams::source_tag,
+            public boost::iostreams::closable_tag
+        { };
+
+        tar_member_source(const std::string& inname, const members_t& members)
+            : p(std::make_shared<impl>())
+        {
+            p->fi.open(inname, std::ios::binary);
+            if (!p->fi) {
+                throw std::runtime_error("failed to open tar file " + inname);
+            }
+            p->members = members;
+        }
+
+        std::streamsize read(char* s, std::streamsize n)
+        {
+            if (p->head.empty() and p->bodyleft == 0) {
+                if (p->memind >= p->members.size()) {
+                    return -1;
+                }
+                const auto& mem = p->members[p->memind++];
+                p->head = "name " + mem.name + "\nbody " + std::to_string(mem.size) + "\n";
+                p->bodyleft = mem.size;
+                p->fi.seekg(mem.offset);
+            }
+            if (!p->head.empty()) {
+                std::streamsize take = std::min<std::streamsize>(n, p->head.size());
+                std::memcpy(s, p->head.data(), take);
+                p->head.erase(0, take);
+                return take;
+            }
+            std::streamsize take = std::min<uint64_t>(n, p->bodyleft);
+            p->fi.read(s, take);
+            if (p->fi.gcount() != take) {
+                throw std::runtime_error("short read of tar member");
+            }
+            p->bodyleft -= take;
+            return take;
+        }
+
+        void close()
+        {
+            p->fi.close();
+        }
+
+      private:
+        // this class must be copyable
+        struct impl {
+            std::ifstream fi;
+            members_t members;
+            size_t memind{0};
+            std::string head{""};
+            uint64_t bodyleft{0};
+        };
+        std::shared_ptr<impl> p;
+    };
+
+    /// Build an input stream producing a custard stream of just the
+    /// given members, as returned by index(), of a seekable file.
+    inline
+    void input_filters(boost::iostreams::filtering_istream& in,
+                       const std::string& inname,
+                       const members_t& members)
+    {
+#ifdef CUSTARD_BOOST_USE_MINIZ
+        if (std::regex_search(inname, std::regex("[_.](zip|npz)$"))) {
+            std::vector<size_t> only;
+            for (const auto& mem : members) {
+                only.push_back(mem.offset);
+            }
+            if (only.empty()) { // empty means all to miniz_source
+                in.push(boost::iostreams::null_source());
+                return;
+            }
+            in.push(custard::miniz_source(inname, only));
+            return;
+        }
+#endif
+        in.push(custard::tar_member_source(inname, members));
+    }
+
     // Build input filtering stream based on parsing the filename.
     inline
     void input_filters(boost::iostreams::filtering_istream& in,
@@ -572,11 +888,12 @@ namespace custard {
     /// Parse outname and based complete the filter ostream.  If
     /// parsing fails, nothing is added to "out".  The compression
     /// level is interpreted as being from 0-9, higher is more,
-    /// slower.
+    /// slower.  If nthreads is more than one, gzip compression is
+    /// done with the parallel_gzip_compressor.
     inline
     void output_filters(boost::iostreams::filtering_ostream& out,
                         std::string outname,
-                        int level = 1)
+                        int level = 1, size_t nthreads = 1)
     {
         auto has = [&](const std::string& things) {
             return std::regex_search(outname, std::regex("[_.]("+things+")\\b"));
@@ -592,7 +909,12 @@ namespace custard {
         // In addition, if compression is wanted, add the appropriate
         // filter next.
         if (has("gz|tgz")) {
-            out.push(boost::iostreams::gzip_compressor(level));
+            if (nthreads > 1) {
+                out.push(custard::parallel_gzip_compressor(level, nthreads));
+            }
+            else {
+                out.push(boost::iostreams::gzip_compressor(level));
+            }
         }
         else if (has("bz2|tbz|tbz2")) {
             out.push(boost::iostreams::bzip2_compressor(level));
@@ -0,0 +1,198 @@
+#include "WireCellUtil/BinaryCache.h"
+#include "WireCellUtil/Logging.h"
+
+#include <cstdlib>  // getenv
+#include <fstream>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/filesystem.hpp>
+#pragma GCC diagnostic pop
+
+using namespace WireCell;
+
+#define WIRECELL_CACHE_VARNAME "WIRECELL_CACHE"
+
+namespace {
+    const char magic[4] = {'W', 'C', 'B', 'C'};
+    const uint32_t byte_order = 0x01020304;
+    const uint32_t format_version = 1;
+
+    struct Header {
+        char magic[4];
+        uint32_t byte_order;
+        uint32_t version;
+        uint32_t kind;
+        uint64_t hash;
+        uint64_t size;
+    };
+    static_assert(sizeof(Header) == 32, "binary cache header must be packed");
+
+    using mapped_t = boost::iostreams::mapped_file_source;
+}
+
+bool BinaryCache::is_binary(const std::string& filename)
+{
+    return filename.size() > extension.size() and
+           filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+uint64_t BinaryCache::content_hash(const std::string& filename)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    boost::system::error_code ec;
+    const auto size = boost::filesystem::file_size(filename, ec);
+    if (ec) {
+        raise<IOError>("binary cache: can not hash %s", filename);
+    }
+    if (size == 0) {
+        return hash;
+    }
+    mapped_t map;
+    try {
+        map.open(filename);
+    }
+    catch (const std::exception& err) {
+        raise<IOError>("binary cache: can not map %s: %s", filename, err.what());
+    }
+    const auto* data = reinterpret_cast<const unsigned char*>(map.data());
+    for (size_t ind = 0; ind < map.size(); ++ind) {
+        hash ^= data[ind];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+std::string BinaryCache::cache_dir()
+{
+    const char* dir = std::getenv(WIRECELL_CACHE_VARNAME);
+    if (!dir) {
+        return "";
+    }
+    return dir;
+}
+
+std::string BinaryCache::cache_path(const std::string& source, uint64_t hash)
+{
+    const auto dir = cache_dir();
+    if (dir.empty()) {
+        return "";
+    }
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", (unsigned long long) hash);
+    const auto name = boost::filesystem::path(source).filename().string() + "-" + hex + extension;
+    return (boost::filesystem::path(dir) / name).string();
+}
+
+std::string BinaryCache::cache_lookup(const std::string& source, uint64_t& hash)
+{
+    if (cache_dir().empty()) {
+        return "";
+    }
+    hash = content_hash(source);
+    return cache_path(source, hash);
+}
+
+void BinaryCache::cache_store(const Writer& writer, const std::string& path, uint32_t kind, uint64_t hash)
+{
+    try {
+        writer.write(path, kind, hash);
+    }
+    catch (const std::exception& err) {
+        spdlog::warn("binary cache: not caching {}: {}", path, err.what());
+        return;
+    }
+    spdlog::debug("binary cache: wrote {}", path);
+}
+
+void BinaryCache::Writer::append(const void* data, size_t size)
+{
+    m_buf.append(reinterpret_cast<const char*>(data), size);
+}
+
+void BinaryCache::Writer::pad()
+{
+    m_buf.resize((m_buf.size() + 7) / 8 * 8, '\0');
+}
+
+void BinaryCache::Writer::write(const std::string& filename, uint32_t kind, uint64_t hash) const
+{
+    Header head;
+    std::memcpy(head.magic, magic, sizeof(magic));
+    head.byte_order = byte_order;
+    head.version = format_version;
+    head.kind = kind;
+    head.hash = hash;
+    head.size = m_buf.size();
+
+    boost::filesystem::path path(filename);
+    if (path.has_parent_path()) {
+        boost::filesystem::create_directories(path.parent_path());
+    }
+    const auto tmp = path.parent_path() / boost::filesystem::unique_path(path.filename().string() + ".%%%%%%%%");
+    {
+        std::ofstream out(tmp.string(), std::ios::binary);
+        out.write(reinterpret_cast<const char*>(&head), sizeof(head));
+        out.write(m_buf.data(), m_buf.size());
+        if (!out) {
+            boost::system::error_code ec;
+            boost::filesystem::remove(tmp, ec);
+            raise<IOError>("binary cache: failed to write %s", filename);
+        }
+    }
+    boost::filesystem::rename(tmp, path);
+}
+
+BinaryCache::Reader::Reader(const std::string& filename, uint32_t kind, uint64_t hash)
+  : m_filename(filename)
+{
+    auto map = std::make_shared<mapped_t>();
+    try {
+        map->open(filename);
+    }
+    catch (const std::exception& err) {
+        raise<IOError>("binary cache: can not map %s: %s", filename, err.what());
+    }
+    if (map->size() < sizeof(Header)) {
+        raise<IOError>("binary cache: truncated header in %s", filename);
+    }
+    Header head;
+    std::memcpy(&head, map->data(), sizeof(head));
+    if (std::memcmp(head.magic, magic, sizeof(magic)) != 0) {
+        raise<IOError>("binary cache: not a binary cache file: %s", filename);
+    }
+    if (head.byte_order != byte_order or head.version != format_version) {
+        raise<IOError>("binary cache: incompatible byte order or version %d in %s", head.version, filename);
+    }
+    if (head.kind != kind) {
+        raise<IOError>("binary cache: unexpected kind in %s", filename);
+    }
+    if (hash and head.hash != hash) {
+        raise<IOError>("binary cache: stale content hash in %s", filename);
+    }
+    if (map->size() != sizeof(Header) + head.size) {
+        raise<IOError>("binary cache: truncated payload in %s", filename);
+    }
+    m_hash = head.hash;
+    m_beg = map->data() + sizeof(Header);
+    m_pos = m_beg;
+    m_end = m_beg + head.size;
+    m_map = map;
+}
+
+const char* BinaryCache::Reader::take(size_t size)
+{
+    if (size > size_t(m_end - m_pos)) {
+        raise<IOError>("binary cache: read past end of %s", m_filename);
+    }
+    const char* ret = m_pos;
+    m_pos += size;
+    return ret;
+}
+
+void BinaryCache::Reader::skip_pad()
+{
+    const size_t off = m_pos - m_beg;
+    take((off + 7) / 8 * 8 - off);
+}
@@ -27,37 +27,46 @@ WireCell::ElasticNetModel::ElasticNetModel(double lambda, double alpha, int max_
 WireCell::ElasticNetModel::~ElasticNetModel() {}
 
 std::vector<size_t> WireCell::ElasticNetModel::Fit()
+{
+    // The residual-updating sparse descent is the same algorithm as
+    // the former per-coordinate recomputation of y - X*beta.
+    Eigen::SparseMatrix<double> X = GetX().sparseView();
+    return FitSparse(X);
+}
+
+std::vector<size_t> WireCell::ElasticNetModel::FitSparse(const Eigen::SparseMatrix<double>& X)
 {
     std::vector<size_t> below_threshold;
+    const int nbeta = X.cols();
 
     // initialize solution to zero unless user set beta already
     Eigen::VectorXd beta = _beta;
-    if (0 == beta.size()) {
-        beta = VectorXd::Zero(_X.cols());
+    if (beta.size() != nbeta) {
+        beta = VectorXd::Zero(nbeta);
+    }
+    if (lambda_weight.size() != nbeta) {
+        lambda_weight = VectorXd::Constant(nbeta, 1.);
     }
 
     // initialize active_beta to true
-    int nbeta = beta.size();
     _active_beta = vector<bool>(nbeta, true);
 
-    // use alias for easy notation
-    Eigen::VectorXd y = Gety();
-    Eigen::MatrixXd X = GetX();
-
-    // cooridate decsent
-
-    // int N = y.size();
+    VectorXd colnorm(nbeta);
     VectorXd norm(nbeta);
     for (int j = 0; j < nbeta; j++) {
-        norm(j) = X.col(j).squaredNorm();
+        colnorm(j) = X.col(j).squaredNorm();
+        norm(j) = colnorm(j);
         if (norm(j) < 1e-6) {
-            // cerr << "warning: the " << j << "th variable is not used, please consider removing it." << endl;
             below_threshold.push_back(j);
             norm(j) = 1;
         }
     }
     double tol2 = TOL * TOL * nbeta;
 
+    // residual, kept current as beta changes
+    VectorXd resid = Gety() - X * beta;
+    const double l2scale = 1 + lambda * (1 - alpha);
+
     int double_check = 0;
     for (int i = 0; i < max_iter; i++) {
         VectorXd betalast = beta;
@@ -65,29 +74,27 @@ std::vector<size_t> WireCell::ElasticNetModel::Fit()
             if (!_active_beta[j]) {
                 continue;
             }
-            VectorXd X_j = X.col(j);
-            VectorXd beta_tmp = beta;
-            beta_tmp(j) = 0;
-            VectorXd r_j = (y - X * beta_tmp);
-            double delta_j = X_j.dot(r_j);
-            //            beta(j) = _soft_thresholding(delta_j, N*lambda*alpha*lambda_weight(j)) / (1+lambda*(1-alpha))
-            //            / norm(j);
-            beta(j) =
-                _soft_thresholding(delta_j / norm(j), lambda * alpha * lambda_weight(j)) / (1 + lambda * (1 - alpha));
-
-            // cout << i << " " << j << " " << beta(j) << std::endl;
+            // X_j . (y - X*beta + X_j*beta_j)
+            double delta_j = colnorm(j) * beta(j);
+            for (SparseMatrix<double>::InnerIterator it(X, j); it; ++it) {
+                delta_j += it.value() * resid(it.row());
+            }
+            const double bnew =
+                _soft_thresholding(delta_j / norm(j), lambda * alpha * lambda_weight(j)) / l2scale;
+            const double step = bnew - beta(j);
+            if (step != 0) {
+                for (SparseMatrix<double>::InnerIterator it(X, j); it; ++it) {
+                    resid(it.row()) -= it.value() * step;
+                }
+                beta(j) = bnew;
+            }
             if (fabs(beta(j)) < 1e-6) {
                 _active_beta[j] = false;
             }
-            // else { cout << beta(j) << endl;}
-            // beta(j) = _soft_thresholding(delta_j, N*lambda*alpha, j) / (1+lambda*(1-alpha)) / norm(j);
-            // if (j==0) cout << beta(j) << ", " << arg1 << endl;
         }
         double_check++;
-        // cout << endl;
         VectorXd diff = beta - betalast;
 
-        // std::cout << i << " " << diff.squaredNorm() << " " << tol2 << std::endl;
         if (diff.squaredNorm() < tol2) {
             if (double_check != 1) {
                 double_check = 0;
@@ -96,7 +103,6 @@ std::vector<size_t> WireCell::ElasticNetModel::Fit()
                 }
             }
             else {
-                //                cout << "found minimum at iteration: " << i << endl;
                 break;
             }
         }
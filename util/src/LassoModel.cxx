@@ -42,8 +42,8 @@ std::vector<size_t> WireCell::LassoModel::Fit()
     int nbeta = beta.size();
     _active_beta = vector<bool>(nbeta, true);
 
-    Eigen::VectorXd y = Gety();
-    Eigen::MatrixXd X = GetX();
+    const Eigen::VectorXd& y = Gety();
+    const Eigen::MatrixXd& X = GetX();
 
     // cooridate decsent
     // int N = y.size();
@@ -58,20 +58,12 @@ std::vector<size_t> WireCell::LassoModel::Fit()
     }
     double tol2 = TOL * TOL * nbeta;
 
-    // calculate the inner product
-    Eigen::VectorXd ydX(nbeta);
-    Eigen::SparseMatrix<double> XdX(nbeta, nbeta);
-    for (int i = 0; i != nbeta; i++) {
-        ydX(i) = y.dot(X.col(i));
-        // beta(i) = ydX(i) / norm(i); // first time result saved here ...
-        for (int j = 0; j != nbeta; j++) {
-            double value = X.col(i).dot(X.col(j));
-            if (value != 0) XdX.insert(i, j) = value;
-            // std::cout << i << " " << j << " " << value << " " << XdX.coeffRef(i,j) << std::endl;
-        }
-        // std::cout << ydX(i) << " " << norm(i) << std::endl;
-    }
-    //  std::cout << "Xin " << nbeta << std::endl;
+    // calculate the inner products.  X is typically very sparse so
+    // form the Gram matrix as a sparse product rather than by dotting
+    // every pair of columns.
+    Eigen::VectorXd ydX = X.transpose() * y;
+    Eigen::SparseMatrix<double> Xs = X.sparseView();
+    Eigen::SparseMatrix<double> XdX = (Xs.transpose() * Xs).pruned();
 
     // start interation ...
     int double_check = 0;
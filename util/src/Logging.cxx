@@ -8,6 +8,7 @@
 #include "spdlog/sinks/null_sink.h"
 #include "spdlog/cfg/env.h"
 
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 
@@ -114,8 +115,12 @@ void Log::add_stderr(bool color, std::string level)
 
 static std::vector<std::string> g_needs_level;
 
+static std::mutex g_logger_mutex;
+
 Log::logptr_t Log::logger(std::string name, bool shared_sinks)
 {
+    // Components may make loggers while being configured in parallel.
+    std::lock_guard<std::mutex> lock(g_logger_mutex);
     wct_base_logger();  // make sure base logger is installed.
     auto l = spdlog::get(name);
     if (l) {
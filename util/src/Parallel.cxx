@@ -0,0 +1,55 @@
+#include "WireCellUtil/Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+using namespace WireCell;
+
+void Parallel::for_each(size_t n, size_t nthreads, const std::function<void(size_t)>& func)
+{
+    nthreads = std::min(nthreads, n);
+    if (nthreads <= 1) {
+        for (size_t ind = 0; ind < n; ++ind) {
+            func(ind);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::vector<std::exception_ptr> errors(n);
+
+    auto worker = [&]() {
+        while (!failed) {
+            const size_t ind = next++;
+            if (ind >= n) {
+                return;
+            }
+            try {
+                func(ind);
+            }
+            catch (...) {
+                errors[ind] = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t ith = 1; ith < nthreads; ++ith) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    for (auto& err : errors) {
+        if (err) {
+            std::rethrow_exception(err);
+        }
+    }
+}
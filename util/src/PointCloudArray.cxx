@@ -110,7 +110,7 @@ Array Array::slice(size_t position, size_t count, bool share)
     }
 
     // Build array on the slice 
-    return Array(m_store.data() + start_bytes, m_dtype, shape, share);
+    return Array(m_bytes.data() + start_bytes, m_dtype, shape, share);
 }
 Array Array::slice(size_t position, size_t count) const
 {
@@ -126,7 +126,7 @@ Array Array::slice(size_t position, size_t count) const
     }
 
     // Build array on the slice 
-    return Array(m_store.data() + start_bytes, m_dtype, shape);
+    return Array(m_bytes.data() + start_bytes, m_dtype, shape);
 }
 
 Array Array::zeros_like(size_t nmaj)
@@ -1,3 +1,4 @@
+#include "WireCellUtil/BinaryCache.h"
 #include "WireCellUtil/Persist.h"
 #include "WireCellUtil/ExecMon.h"
 #include "WireCellUtil/Response.h"
@@ -29,12 +30,10 @@ Response::Schema::PathResponse::~PathResponse() {}
  ['shape', 'elements']
 
  */
-WireCell::Response::Schema::FieldResponse WireCell::Response::Schema::load(const char* filename)
+static Response::Schema::FieldResponse load_json(const std::string& filename)
 {
-    if (!filename) {
-        error("Response::Schema::load(): empty field response file name");
-        return FieldResponse();
-    }
+    using namespace WireCell::Response::Schema;
+
     Json::Value top = WireCell::Persist::load(filename);
     if (top.isNull()) {
         error("Response::Schema::load(): failed to load {}", filename);
@@ -42,8 +41,6 @@ WireCell::Response::Schema::FieldResponse WireCell::Response::Schema::load(const
     }
     Json::Value fr = top["FieldResponse"];
 
-    using namespace WireCell::Response::Schema;
-
     std::vector<PlaneResponse> planes;
     for (auto plane : fr["planes"]) {
         auto plr = plane["PlaneResponse"];
@@ -71,7 +68,127 @@ WireCell::Response::Schema::FieldResponse WireCell::Response::Schema::load(const
     return ret;
 }
 
-void Response::Schema::dump(const char* filename, const Response::Schema::FieldResponse& fr) {}
+WireCell::Response::Schema::FieldResponse WireCell::Response::Schema::load(const char* filename)
+{
+    if (!filename) {
+        error("Response::Schema::load(): empty field response file name");
+        return FieldResponse();
+    }
+    const std::string path = Persist::resolve(filename);
+    if (path.empty()) {
+        return load_json(filename);  // throws with a helpful message
+    }
+    if (BinaryCache::is_binary(path)) {
+        BinaryCache::Reader reader(path, BinaryCache::field_response);
+        return read(reader);
+    }
+    return BinaryCache::load_cached<FieldResponse>(
+        path, BinaryCache::field_response, load_json,
+        [](BinaryCache::Reader& reader) { return read(reader); },
+        [](BinaryCache::Writer& writer, const FieldResponse& fr) { write(writer, fr); });
+}
+
+void Response::Schema::write(BinaryCache::Writer& writer, const FieldResponse& fr)
+{
+    writer.put(fr.axis.x());
+    writer.put(fr.axis.y());
+    writer.put(fr.axis.z());
+    writer.put(fr.origin);
+    writer.put(fr.tstart);
+    writer.put(fr.period);
+    writer.put(fr.speed);
+    writer.put<uint64_t>(fr.planes.size());
+    for (const auto& plane : fr.planes) {
+        writer.put<int64_t>(plane.planeid);
+        writer.put(plane.location);
+        writer.put(plane.pitch);
+        writer.put<uint64_t>(plane.paths.size());
+        for (const auto& path : plane.paths) {
+            writer.put(path.pitchpos);
+            writer.put(path.wirepos);
+            writer.put_array(path.current);
+        }
+    }
+}
+
+Response::Schema::FieldResponse Response::Schema::read(BinaryCache::Reader& reader)
+{
+    FieldResponse fr;
+    const double x = reader.get<double>();
+    const double y = reader.get<double>();
+    const double z = reader.get<double>();
+    fr.axis = Vector(x, y, z);
+    fr.origin = reader.get<double>();
+    fr.tstart = reader.get<double>();
+    fr.period = reader.get<double>();
+    fr.speed = reader.get<double>();
+    fr.planes.resize(reader.get<uint64_t>());
+    for (auto& plane : fr.planes) {
+        plane.planeid = reader.get<int64_t>();
+        plane.location = reader.get<double>();
+        plane.pitch = reader.get<double>();
+        plane.paths.resize(reader.get<uint64_t>());
+        for (auto& path : plane.paths) {
+            path.pitchpos = reader.get<double>();
+            path.wirepos = reader.get<double>();
+            path.current = reader.get_vector<Waveform::real_t>();
+        }
+    }
+    return fr;
+}
+
+static Json::Value jo_wrap(const char* name, const Json::Value& j)
+{
+    Json::Value ret = Json::objectValue;
+    ret[name] = j;
+    return ret;
+}
+
+void Response::Schema::dump(const char* filename, const Response::Schema::FieldResponse& fr)
+{
+    if (BinaryCache::is_binary(filename)) {
+        BinaryCache::Writer writer;
+        write(writer, fr);
+        writer.write(filename, BinaryCache::field_response, 0);
+        return;
+    }
+
+    Json::Value jplanes = Json::arrayValue;
+    for (const auto& plane : fr.planes) {
+        Json::Value jpaths = Json::arrayValue;
+        for (const auto& path : plane.paths) {
+            Json::Value jarr = Json::objectValue;
+            jarr["shape"].append((Json::UInt64) path.current.size());
+            jarr["elements"] = Json::arrayValue;
+            for (auto val : path.current) {
+                jarr["elements"].append(val);
+            }
+            Json::Value jpath = Json::objectValue;
+            jpath["current"]["array"] = jarr;
+            jpath["pitchpos"] = path.pitchpos;
+            jpath["wirepos"] = path.wirepos;
+            jpaths.append(jo_wrap("PathResponse", jpath));
+        }
+        Json::Value jplane = Json::objectValue;
+        jplane["paths"] = jpaths;
+        jplane["planeid"] = plane.planeid;
+        jplane["location"] = plane.location;
+        jplane["pitch"] = plane.pitch;
+        jplanes.append(jo_wrap("PlaneResponse", jplane));
+    }
+    Json::Value jfr = Json::objectValue;
+    jfr["planes"] = jplanes;
+    for (int ind = 0; ind < 3; ++ind) {
+        jfr["axis"].append(fr.axis[ind]);
+    }
+    jfr["origin"] = fr.origin;
+    jfr["tstart"] = fr.tstart;
+    jfr["period"] = fr.period;
+    jfr["speed"] = fr.speed;
+    Json::Value jtop = Json::objectValue;
+    jtop["FieldResponse"] = jfr;
+    Persist::dump(filename, jtop);
+}
 
 /// Warning!  this function is NOT GENERAL.  It is actually specific
 /// to Garfield 1D line of paths with half the impact positions
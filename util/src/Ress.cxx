@@ -12,11 +12,11 @@ Ress::vector_t Ress::solve(Ress::matrix_t matrix, Ress::vector_t measured, const
 
     if (params.model == Ress::lasso) {
         WireCell::LassoModel model(params.lambda, params.max_iter, params.tolerance, params.non_negative);
+        // FIXME: SetData overwrites SetLambdaWeight and beta
+        model.SetData(matrix, measured);
         if (params.set_init) {
 	  model.Setbeta(initial);
 	}
-        // FIXME: SetData overwrites SetLambdaWeight
-        model.SetData(matrix, measured);
         if (weights.size()) {
             model.SetLambdaWeight(weights);
         }
@@ -27,10 +27,10 @@ Ress::vector_t Ress::solve(Ress::matrix_t matrix, Ress::vector_t measured, const
     if (params.model == Ress::elnet) {
         WireCell::ElasticNetModel model(params.lambda, params.alpha, params.max_iter, params.tolerance,
                                         params.non_negative);
+        model.SetData(matrix, measured);
 	if (params.set_init) {
 	  model.Setbeta(initial);
         }
-        model.SetData(matrix, measured);
 	if (weights.size()) {
             model.SetLambdaWeight(weights);
         }
@@ -41,3 +41,29 @@ Ress::vector_t Ress::solve(Ress::matrix_t matrix, Ress::vector_t measured, const
     return Ress::vector_t();
 }
 
+
+Ress::vector_t Ress::solve(const Ress::sparse_matrix_t& matrix, const Ress::vector_t& measured,
+                           const Ress::Params& params, const Ress::vector_t& initial,
+                           const Ress::vector_t& weights)
+{
+    // Lasso is elastic net with alpha=1.
+    double alpha = params.alpha;
+    if (params.model == Ress::lasso) {
+        alpha = 1.0;
+    }
+    else if (params.model != Ress::elnet) {
+        return Ress::vector_t();
+    }
+
+    WireCell::ElasticNetModel model(params.lambda, alpha, params.max_iter, params.tolerance,
+                                    params.non_negative);
+    model.Sety(measured);
+    if (params.set_init and initial.size() == matrix.cols()) {
+        model.Setbeta(initial);
+    }
+    if (weights.size()) {
+        model.SetLambdaWeight(weights);
+    }
+    model.FitSparse(matrix);
+    return model.Getbeta();
+}
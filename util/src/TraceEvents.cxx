@@ -0,0 +1,126 @@
+#include "WireCellUtil/TraceEvents.h"
+#include "WireCellUtil/MemUsage.h"
+#include "WireCellUtil/Exceptions.h"
+
+#include <ctime>
+#include <fstream>
+#include <sstream>
+
+using namespace WireCell;
+
+TraceEvents::TraceEvents(bool with_rss)
+    : m_with_rss(with_rss)
+    , m_origin(clock_t::now())
+{
+}
+
+double TraceEvents::thread_cpu()
+{
+    timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts)) {
+        return 0;
+    }
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+TraceEvents::Stamp TraceEvents::start() const
+{
+    Stamp stamp;
+    if (m_with_rss) {
+        stamp.rss = memusage_resident();
+    }
+    stamp.cpu = thread_cpu();
+    stamp.wall = clock_t::now();
+    return stamp;
+}
+
+void TraceEvents::stop(const Stamp& stamp, const std::string& name, long nin, long nout)
+{
+    const auto now = clock_t::now();
+    Span span;
+    span.cpu = thread_cpu() - stamp.cpu;
+    if (m_with_rss) {
+        span.rss = memusage_resident() - stamp.rss;
+    }
+    span.name = name;
+    span.start = std::chrono::duration<double>(stamp.wall - m_origin).count();
+    span.wall = std::chrono::duration<double>(now - stamp.wall).count();
+    span.nin = nin;
+    span.nout = nout;
+
+    const auto id = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_tids.find(id);
+    if (it == m_tids.end()) {
+        it = m_tids.emplace(id, m_tids.size()).first;
+    }
+    span.tid = it->second;
+    m_spans.push_back(span);
+}
+
+std::vector<TraceEvents::Span> TraceEvents::spans() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_spans;
+}
+
+static std::string json_escape(const std::string& s)
+{
+    std::stringstream ss;
+    for (char c : s) {
+        switch (c) {
+        case '"': ss << "\\\""; break;
+        case '\\': ss << "\\\\"; break;
+        case '\n': ss << "\\n"; break;
+        case '\t': ss << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                ss << ' ';
+            }
+            else {
+                ss << c;
+            }
+        }
+    }
+    return ss.str();
+}
+
+void TraceEvents::write(const std::string& filename) const
+{
+    std::ofstream out(filename);
+    if (!out) {
+        raise<IOError>("failed to open trace file %s", filename);
+    }
+
+    auto spans = this->spans();
+
+    // Chrome trace-event "complete" events with times in microseconds.
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    for (const auto& span : spans) {
+        if (!first) {
+            out << ",\n";
+        }
+        first = false;
+        out << "{\"name\":\"" << json_escape(span.name) << "\""
+            << ",\"cat\":\"node\",\"ph\":\"X\",\"pid\":0"
+            << ",\"tid\":" << span.tid
+            << ",\"ts\":" << (long long)(span.start * 1e6)
+            << ",\"dur\":" << (long long)(span.wall * 1e6)
+            << ",\"args\":{\"cpu_us\":" << (long long)(span.cpu * 1e6);
+        if (m_with_rss) {
+            out << ",\"process_rss_kb\":" << span.rss;
+        }
+        if (span.nin >= 0) {
+            out << ",\"nin\":" << span.nin;
+        }
+        if (span.nout >= 0) {
+            out << ",\"nout\":" << span.nout;
+        }
+        out << "}}";
+    }
+    out << "\n]}\n";
+    if (!out) {
+        raise<IOError>("failed to write trace file %s", filename);
+    }
+}
@@ -1,9 +1,11 @@
 #include "WireCellUtil/WireSchema.h"
+#include "WireCellUtil/BinaryCache.h"
 #include "WireCellUtil/Persist.h"
 #include "WireCellUtil/Configuration.h"
 #include "WireCellUtil/Logging.h"
 #include "WireCellUtil/Intersection.h"
 
+#include <mutex>
 #include <numeric>
 
 using namespace WireCell;
@@ -379,6 +381,8 @@ Store WireCell::WireSchema::load(const char* filename, Correction correction)
 {
     using cache_key_t = std::pair<std::string, WireSchema::Correction>;
     static std::map<cache_key_t, StoreDBPtr> cache;
+    static std::mutex cache_mutex;
+    std::lock_guard<std::mutex> lock(cache_mutex);  // components may configure concurrently
 
     // turn into absolute real path
     std::string realpath = WireCell::Persist::resolve(filename);
@@ -415,7 +419,21 @@ Store WireCell::WireSchema::load(const char* filename, Correction correction)
 
     // always load if we start empty
     if (have_level == Correction::empty) {
-        load_file(realpath, *store);
+        if (BinaryCache::is_binary(realpath)) {
+            BinaryCache::Reader reader(realpath, BinaryCache::wire_store);
+            *store = read(reader);
+        }
+        else {
+            *store = BinaryCache::load_cached<StoreDB>(
+                realpath, BinaryCache::wire_store,
+                [](const std::string& path) {
+                    StoreDB db;
+                    load_file(path, db);
+                    return db;
+                },
+                [](BinaryCache::Reader& reader) { return read(reader); },
+                [](BinaryCache::Writer& writer, const StoreDB& db) { write(writer, db); });
+        }
         have_level = Correction::load;
     };
 
@@ -454,8 +472,86 @@ static Json::Value jo_wrap(const char* name, Json::Value& j)
     return ret;
 }
 
+template <typename Type>
+static void write_children(BinaryCache::Writer& writer, const std::vector<Type>& objs,
+                           std::vector<int> Type::*children)
+{
+    writer.put<uint64_t>(objs.size());
+    for (const auto& obj : objs) {
+        writer.put<int32_t>(obj.ident);
+        writer.put_array(obj.*children);
+    }
+}
+
+template <typename Type>
+static void read_children(BinaryCache::Reader& reader, std::vector<Type>& objs,
+                          std::vector<int> Type::*children)
+{
+    objs.resize(reader.get<uint64_t>());
+    for (auto& obj : objs) {
+        obj.ident = reader.get<int32_t>();
+        obj.*children = reader.get_vector<int>();
+    }
+}
+
+void WireCell::WireSchema::write(BinaryCache::Writer& writer, const StoreDB& store)
+{
+    // Wires are stored as two flat arrays of numbers.
+    std::vector<int32_t> ints;
+    std::vector<double> coords;
+    ints.reserve(3 * store.wires.size());
+    coords.reserve(6 * store.wires.size());
+    for (const auto& wire : store.wires) {
+        ints.insert(ints.end(), {wire.ident, wire.channel, wire.segment});
+        for (const auto* pt : {&wire.tail, &wire.head}) {
+            coords.insert(coords.end(), {pt->x(), pt->y(), pt->z()});
+        }
+    }
+    writer.put_array(ints);
+    writer.put_array(coords);
+
+    write_children(writer, store.planes, &Plane::wires);
+    write_children(writer, store.faces, &Face::planes);
+    write_children(writer, store.anodes, &Anode::faces);
+    write_children(writer, store.detectors, &Detector::anodes);
+}
+
+StoreDB WireCell::WireSchema::read(BinaryCache::Reader& reader)
+{
+    StoreDB store;
+    uint64_t nints = 0, ncoords = 0;
+    const int32_t* ints = reader.get_array<int32_t>(nints);
+    const double* coords = reader.get_array<double>(ncoords);
+    const size_t nwires = nints / 3;
+    if (nints != 3 * nwires or ncoords != 6 * nwires) {
+        raise<IOError>("WireSchema: corrupt wires in binary store");
+    }
+    store.wires.resize(nwires);
+    for (size_t ind = 0; ind < nwires; ++ind, ints += 3, coords += 6) {
+        auto& wire = store.wires[ind];
+        wire.ident = ints[0];
+        wire.channel = ints[1];
+        wire.segment = ints[2];
+        wire.tail = Point(coords[0], coords[1], coords[2]);
+        wire.head = Point(coords[3], coords[4], coords[5]);
+    }
+
+    read_children(reader, store.planes, &Plane::wires);
+    read_children(reader, store.faces, &Face::planes);
+    read_children(reader, store.anodes, &Anode::faces);
+    read_children(reader, store.detectors, &Detector::anodes);
+    return store;
+}
+
 void WireCell::WireSchema::dump(const char* filename, const Store& store)
 {
+    if (BinaryCache::is_binary(filename)) {
+        BinaryCache::Writer writer;
+        write(writer, *store.db());
+        writer.write(filename, BinaryCache::wire_store, 0);
+        return;
+    }
+
     Json::Value jstore = Json::objectValue;
 
     Json::Value jpoints = Json::arrayValue; // we don't bother deduplicating
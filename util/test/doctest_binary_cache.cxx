@@ -0,0 +1,137 @@
+#include "WireCellUtil/BinaryCache.h"
+#include "WireCellUtil/Response.h"
+#include "WireCellUtil/WireSchema.h"
+#include "WireCellUtil/Persist.h"
+#include "WireCellUtil/Units.h"
+#include "WireCellUtil/doctest.h"
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <cstdlib>
+
+using namespace WireCell;
+namespace fs = boost::filesystem;
+
+static Response::Schema::FieldResponse make_fr(int npaths)
+{
+    using namespace Response::Schema;
+    std::vector<PlaneResponse> planes;
+    for (int pid = 0; pid < 3; ++pid) {
+        std::vector<PathResponse> paths;
+        for (int ind = 0; ind < npaths; ++ind) {
+            Waveform::realseq_t current(100 + ind);
+            for (size_t it = 0; it < current.size(); ++it) {
+                current[it] = 0.1 * pid + 1e-3 * ind * it;
+            }
+            paths.emplace_back(current, ind * 0.3 * units::mm, 0);
+        }
+        planes.emplace_back(paths, pid, (3 - pid) * units::mm, 5 * units::mm);
+    }
+    return FieldResponse(planes, Vector(1, 0, 0), 10 * units::cm, 0, 100 * units::ns, 1.6 * units::mm / units::us);
+}
+
+static void check_same(const Response::Schema::FieldResponse& a, const Response::Schema::FieldResponse& b)
+{
+    REQUIRE(a.planes.size() == b.planes.size());
+    CHECK(a.axis == b.axis);
+    CHECK(a.origin == b.origin);
+    CHECK(a.tstart == b.tstart);
+    CHECK(a.period == b.period);
+    CHECK(a.speed == b.speed);
+    for (size_t ip = 0; ip < a.planes.size(); ++ip) {
+        const auto& pa = a.planes[ip];
+        const auto& pb = b.planes[ip];
+        CHECK(pa.planeid == pb.planeid);
+        CHECK(pa.location == pb.location);
+        CHECK(pa.pitch == pb.pitch);
+        REQUIRE(pa.paths.size() == pb.paths.size());
+        for (size_t ind = 0; ind < pa.paths.size(); ++ind) {
+            CHECK(pa.paths[ind].pitchpos == pb.paths[ind].pitchpos);
+            CHECK(pa.paths[ind].wirepos == pb.paths[ind].wirepos);
+            CHECK(pa.paths[ind].current == pb.paths[ind].current);
+        }
+    }
+}
+
+TEST_CASE("binary cache field response round trip")
+{
+    Persist::TempDir td;
+    const auto fr = make_fr(5);
+
+    const auto bin = (td.path / "fr.wcb").string();
+    Response::Schema::dump(bin.c_str(), fr);
+    check_same(fr, Response::Schema::load(bin.c_str()));
+
+    // Wrong kind is refused.
+    CHECK_THROWS_AS(BinaryCache::Reader(bin, BinaryCache::wire_store), IOError);
+
+    // JSON round trip is lossless for float currents.
+    const auto json = (td.path / "fr.json").string();
+    Response::Schema::dump(json.c_str(), fr);
+    check_same(fr, Response::Schema::load(json.c_str()));
+}
+
+TEST_CASE("binary cache fills and detects stale source")
+{
+    Persist::TempDir td;
+    const auto cache = td.path / "cache";
+    setenv("WIRECELL_CACHE", cache.c_str(), 1);
+
+    const auto json = (td.path / "fr.json").string();
+    Response::Schema::dump(json.c_str(), make_fr(3));
+    const auto hash1 = BinaryCache::content_hash(json);
+    const auto path1 = BinaryCache::cache_path(json, hash1);
+    CHECK(!fs::exists(path1));
+
+    check_same(make_fr(3), Response::Schema::load(json.c_str()));  // miss
+    REQUIRE(fs::exists(path1));
+    check_same(make_fr(3), Response::Schema::load(json.c_str()));  // hit
+    CHECK(BinaryCache::Reader(path1, BinaryCache::field_response, hash1).hash() == hash1);
+
+    // Changing the source changes the key.
+    Response::Schema::dump(json.c_str(), make_fr(4));
+    const auto hash2 = BinaryCache::content_hash(json);
+    CHECK(hash2 != hash1);
+    check_same(make_fr(4), Response::Schema::load(json.c_str()));
+    CHECK(fs::exists(BinaryCache::cache_path(json, hash2)));
+
+    // A stale binary under the current key is rejected and refilled.
+    fs::copy_file(path1, BinaryCache::cache_path(json, hash2), fs::copy_options::overwrite_existing);
+    CHECK_THROWS_AS(BinaryCache::Reader(BinaryCache::cache_path(json, hash2), BinaryCache::field_response, hash2),
+                    IOError);
+    check_same(make_fr(4), Response::Schema::load(json.c_str()));
+
+    unsetenv("WIRECELL_CACHE");
+}
+
+TEST_CASE("binary cache wire store round trip")
+{
+    using namespace WireSchema;
+    StoreDB db;
+    for (int pid = 0; pid < 3; ++pid) {
+        auto& plane = get_append(db, pid, 0, 0, 0);
+        const Ray pitch(Point(0, 0, 0), Point(0, 3 * units::mm, (1 + pid) * units::mm));
+        const Ray bounds(Point(0, -1 * units::m, -1 * units::m), Point(0, 1 * units::m, 1 * units::m));
+        generate(db, plane, pitch, bounds, 100 * pid);
+    }
+
+    Persist::TempDir td;
+    const auto bin = (td.path / "wires.wcb").string();
+    Store store(std::make_shared<const StoreDB>(db));
+    dump(bin.c_str(), store);
+
+    Store got = load(bin.c_str(), Correction::load);
+    REQUIRE(got.wires().size() == db.wires.size());
+    for (size_t ind = 0; ind < db.wires.size(); ++ind) {
+        CHECK(got.wires()[ind].ident == db.wires[ind].ident);
+        CHECK(got.wires()[ind].tail == db.wires[ind].tail);
+        CHECK(got.wires()[ind].head == db.wires[ind].head);
+    }
+    REQUIRE(got.planes().size() == db.planes.size());
+    for (size_t ind = 0; ind < db.planes.size(); ++ind) {
+        CHECK(got.planes()[ind].wires == db.planes[ind].wires);
+    }
+    CHECK(got.faces().size() == db.faces.size());
+    CHECK(got.anodes().size() == db.anodes.size());
+    CHECK(got.detectors().size() == db.detectors.size());
+}
@@ -0,0 +1,35 @@
+#include "WireCellUtil/Parallel.h"
+#include "WireCellUtil/Exceptions.h"
+#include "WireCellUtil/doctest.h"
+
+#include <atomic>
+#include <vector>
+
+using namespace WireCell;
+
+TEST_CASE("parallel for each")
+{
+    const size_t n = 1000;
+    for (size_t nthreads : {0, 1, 3, 8}) {
+        std::vector<int> out(n, 0);
+        Parallel::for_each(n, nthreads, [&](size_t ind) { out[ind] = 2 * ind; });
+        for (size_t ind = 0; ind < n; ++ind) {
+            REQUIRE(out[ind] == (int) (2 * ind));
+        }
+    }
+
+    // Empty is a no-op.
+    Parallel::for_each(0, 4, [](size_t) { REQUIRE(false); });
+}
+
+TEST_CASE("parallel for each exception")
+{
+    std::atomic<size_t> ncalls{0};
+    CHECK_THROWS_AS(Parallel::for_each(100, 4, [&](size_t ind) {
+        ++ncalls;
+        if (ind == 10) {
+            raise<ValueError>("bad index %d", ind);
+        }
+    }), ValueError);
+    CHECK(ncalls >= 11);
+}
@@ -0,0 +1,98 @@
+#include "WireCellUtil/Philox.h"
+#include "WireCellUtil/doctest.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace WireCell;
+
+TEST_CASE("philox known answers")
+{
+    // From the Random123 kat_vectors for philox4x32 with 10 rounds.
+    using ctr_t = Philox4x32::ctr_type;
+    using key_t = Philox4x32::key_type;
+
+    CHECK(Philox4x32::block(ctr_t{0, 0, 0, 0}, key_t{0, 0}) ==
+          ctr_t{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8});
+    CHECK(Philox4x32::block(ctr_t{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, key_t{0xffffffff, 0xffffffff}) ==
+          ctr_t{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd});
+    CHECK(Philox4x32::block(ctr_t{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, key_t{0xa4093822, 0x299f31d0}) ==
+          ctr_t{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1});
+}
+
+TEST_CASE("philox engine")
+{
+    Philox4x32 a(42, 7), b(42, 7), c(42, 8);
+    std::vector<uint32_t> va, vc;
+    for (int ind = 0; ind < 100; ++ind) {
+        va.push_back(a());
+        vc.push_back(c());
+    }
+    CHECK(va != vc);
+
+    // discard matches drawing
+    b.discard(37);
+    for (int ind = 37; ind < 100; ++ind) {
+        CHECK(b() == va[ind]);
+    }
+
+    // usable with std distributions
+    Philox4x32 d(1, 2);
+    std::normal_distribution<double> normal(0, 1);
+    double sum = 0;
+    for (int ind = 0; ind < 1000; ++ind) {
+        sum += normal(d);
+    }
+    CHECK(std::abs(sum / 1000) < 0.2);
+}
+
+TEST_CASE("philox bulk fills")
+{
+    const size_t n = 100001;
+    std::vector<float> vals(n);
+    Philox4x32 eng(3, philox_stream({1, 2, 3, 4}));
+
+    eng.fill_normal(vals.data(), n, 10.0, 2.0);
+    double sum = 0, sum2 = 0;
+    for (float v : vals) {
+        sum += v;
+        sum2 += v * v;
+    }
+    const double mean = sum / n;
+    const double rms = std::sqrt(sum2 / n - mean * mean);
+    CHECK(mean == doctest::Approx(10.0).epsilon(0.01));
+    CHECK(rms == doctest::Approx(2.0).epsilon(0.02));
+
+    eng.fill_uniform(vals.data(), n, -1.0, 1.0);
+    sum = 0;
+    float lo = 2, hi = -2;
+    for (float v : vals) {
+        lo = std::min(lo, v);
+        hi = std::max(hi, v);
+        sum += v;
+    }
+    CHECK(lo >= -1.0f);
+    CHECK(hi < 1.0f);
+    CHECK(std::abs(sum / n) < 0.01);
+
+    // Floats are 2 apart here so half of the draws would round to hi.
+    const double big = 0x1p24;
+    eng.fill_uniform(vals.data(), n, big, big + 2);
+    for (float v : vals) {
+        REQUIRE(v >= float(big));
+        REQUIRE(v < float(big + 2));
+    }
+
+    CHECK(philox_stream({1, 2, 3, 4}) != philox_stream({4, 3, 2, 1}));
+    CHECK(philox_stream({0, 1}) != philox_stream({1, 0}));
+}
+
+TEST_CASE("philox named streams")
+{
+    CHECK(philox_stream_of("DepoTransform:a") == philox_stream_of("DepoTransform:a"));
+    CHECK(philox_stream_of("DepoTransform:a") != philox_stream_of("DepoTransform:b"));
+    CHECK(philox_stream_of("DepoTransform:a") != philox_stream_of("DepoSplat:a"));
+    CHECK(philox_stream_of("") == 0xCBF29CE484222325ULL);  // FNV-1a offset basis
+    CHECK(philox_stream_of("a") == 0xAF63DC4C8601EC8CULL);
+}
@@ -139,6 +139,15 @@ TEST_CASE("point cloud slice")
     check_b_slice(bbs);
     CHECK(bbs.dtype() == bb.dtype());
 
+    // Slices of an array sharing user data.
+    Array bbshared(counts.data(), shape, true);
+    check_b_slice(bbshared.slice(1,1));
+    const Array& bbconst = bbshared;
+    check_b_slice(bbconst.slice(1,1));
+    auto bbss = bbshared.slice(1,1,true);
+    check_b_slice(bbss);
+    CHECK(bbss.elements<int>().data() == counts.data() + 8);
+
     Dataset ds({
             {"a", aa},
             {"b", bb}});
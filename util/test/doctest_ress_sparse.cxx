@@ -0,0 +1,82 @@
+#include "WireCellUtil/Ress.h"
+#include "WireCellUtil/doctest.h"
+
+#include <random>
+#include <vector>
+
+using namespace WireCell;
+
+// A blob/wire like system: each source touches a few measures.
+static Ress::sparse_matrix_t make_response(int nmeas, int nsrc, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> pick(0, nmeas - 1);
+    std::vector<Eigen::Triplet<double>> trips;
+    for (int isrc = 0; isrc < nsrc; ++isrc) {
+        for (int ind = 0; ind < 3; ++ind) {
+            trips.emplace_back(pick(rng), isrc, 1.0);
+        }
+    }
+    Ress::sparse_matrix_t R(nmeas, nsrc);
+    R.setFromTriplets(trips.begin(), trips.end(), [](const double&, const double& b) { return b; });
+    return R;
+}
+
+static Ress::vector_t make_source(int nsrc, std::mt19937& rng)
+{
+    std::uniform_real_distribution<double> val(50, 200);
+    std::bernoulli_distribution zero(0.6);
+    Ress::vector_t s(nsrc);
+    for (int ind = 0; ind < nsrc; ++ind) {
+        s(ind) = zero(rng) ? 0 : val(rng);
+    }
+    return s;
+}
+
+TEST_CASE("ress sparse matches dense")
+{
+    std::mt19937 rng(42);
+    const int nmeas = 60, nsrc = 80;
+    auto R = make_response(nmeas, nsrc, rng);
+    Ress::matrix_t Rd(R);
+    Ress::vector_t m = R * make_source(nsrc, rng);
+
+    for (auto model : {Ress::lasso, Ress::elnet}) {
+        Ress::Params params;
+        params.model = model;
+        params.lambda = 0.01;
+        params.alpha = 0.9;
+        params.tolerance = 1e-6;
+
+        auto dense = Ress::solve(Rd, m, params);
+        auto sparse = Ress::solve(R, m, params);
+        REQUIRE(dense.size() == nsrc);
+        REQUIRE(sparse.size() == nsrc);
+        CHECK((dense - sparse).norm() < 1e-3 * dense.norm());
+        CHECK(Ress::chi2_base(m, Ress::predict(R, sparse)) ==
+              doctest::Approx(Ress::chi2_base(m, Ress::predict(Rd, dense))).epsilon(1e-3));
+    }
+}
+
+TEST_CASE("ress sparse warm start")
+{
+    std::mt19937 rng(7);
+    const int nmeas = 40, nsrc = 50;
+    auto R = make_response(nmeas, nsrc, rng);
+    Ress::vector_t m = R * make_source(nsrc, rng);
+
+    Ress::Params params;
+    params.model = Ress::lasso;
+    params.lambda = 0.01;
+    params.tolerance = 1e-6;
+    auto cold = Ress::solve(R, m, params);
+
+    // Starting at the solution, one sweep leaves it in place.
+    params.set_init = true;
+    params.max_iter = 1;
+    auto warm = Ress::solve(R, m, params, cold);
+    CHECK((warm - cold).norm() < 1e-6 * cold.norm());
+
+    // The dense path honors the initial values as well.
+    auto dwarm = Ress::solve(Ress::matrix_t(R), m, params, cold);
+    CHECK((dwarm - cold).norm() < 1e-6 * cold.norm());
+}
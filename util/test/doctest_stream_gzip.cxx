@@ -0,0 +1,64 @@
+#include "WireCellUtil/Stream.h"
+#include "WireCellUtil/Persist.h"
+#include "WireCellUtil/doctest.h"
+
+#include <boost/iostreams/device/back_inserter.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace WireCell;
+using namespace WireCell::Stream;
+
+TEST_CASE("stream parallel gzip members")
+{
+    // Small blocks so the data spans several members and batches.
+    std::string text;
+    for (int ind = 0; ind < 20000; ++ind) {
+        text += std::to_string(ind * 7919 % 10007) + " ";
+    }
+
+    std::vector<char> zipped;
+    {
+        filtering_ostream so;
+        so.push(custard::parallel_gzip_compressor(6, 3, 4096));
+        so.push(boost::iostreams::back_inserter(zipped));
+        so.write(text.data(), text.size());
+        so.reset();
+    }
+    CHECK(zipped.size() < text.size());
+
+    filtering_istream si;
+    si.push(boost::iostreams::gzip_decompressor());
+    si.push(boost::iostreams::array_source(zipped.data(), zipped.size()));
+    std::string got(std::istreambuf_iterator<char>(si), {});
+    CHECK(got == text);
+}
+
+TEST_CASE("stream parallel gzip tar file")
+{
+    Persist::TempDir td;
+    const std::string fname = (td.path / "par.tar.gz").string();
+    const int nmembers = 5;
+    {
+        filtering_ostream so;
+        output_filters(so, fname, 1, 4);
+        for (int ind = 0; ind < nmembers; ++ind) {
+            std::vector<float> vec(300000, ind); // > 1MB in all
+            write(so, "arr_" + std::to_string(ind) + ".npy", vec);
+            REQUIRE(so);
+        }
+        so.reset();
+    }
+    filtering_istream si;
+    input_filters(si, fname);
+    for (int ind = 0; ind < nmembers; ++ind) {
+        std::string name;
+        std::vector<float> vec;
+        read(si, name, vec);
+        REQUIRE(si);
+        CHECK(name == "arr_" + std::to_string(ind) + ".npy");
+        CHECK(vec.size() == 300000);
+        CHECK(vec.back() == ind);
+    }
+}
@@ -0,0 +1,107 @@
+#include "WireCellUtil/Stream.h"
+#include "WireCellUtil/Persist.h"
+#include "WireCellUtil/doctest.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace WireCell;
+using namespace WireCell::Stream;
+
+static void write_members(const std::string& fname, int nmembers)
+{
+    filtering_ostream so;
+    output_filters(so, fname);
+    for (int ind = 0; ind < nmembers; ++ind) {
+        // varied sizes so some bodies fill 512 byte blocks exactly
+        std::vector<int> vec(ind * 32 + 3, ind);
+        write(so, "frame_tag_" + std::to_string(ind) + ".npy", vec);
+        REQUIRE(so);
+    }
+    so.flush();
+    so.reset();
+}
+
+TEST_CASE("stream index random access")
+{
+    Persist::TempDir td;
+    const int nmembers = 10;
+    for (std::string ext : {".tar", ".npz", ".tar.gz"}) {
+        const std::string fname = (td.path / ("members" + ext)).string();
+        write_members(fname, nmembers);
+
+        if (ext == ".tar.gz") {
+            CHECK(!seekable(fname));
+            continue;
+        }
+        REQUIRE(seekable(fname));
+
+        const auto members = custard::index(fname);
+        REQUIRE(members.size() == nmembers);
+        for (int ind = 0; ind < nmembers; ++ind) {
+            CHECK(members[ind].name == "frame_tag_" + std::to_string(ind) + ".npy");
+            if (ext == ".tar") {
+                CHECK(members[ind].stored == int64_t(members[ind].offset));
+            }
+            else {              // miniz_sink deflates
+                CHECK(members[ind].stored == -1);
+            }
+        }
+
+        // Read back a selection out of order.
+        members_t keep{members[7], members[2], members[8]};
+        filtering_istream si;
+        custard::input_filters(si, fname, keep);
+        for (const auto& mem : keep) {
+            std::string name;
+            std::vector<int> vec;
+            read(si, name, vec);
+            REQUIRE(si);
+            CHECK(name == mem.name);
+            const int want = std::stoi(name.substr(10));
+            CHECK(vec.size() == size_t(want * 32 + 3));
+            CHECK(vec.back() == want);
+        }
+        std::string name;
+        size_t fsize = 0;
+        custard::read(si, name, fsize);
+        CHECK(fsize == 0);
+
+        // An empty selection is an empty stream.
+        filtering_istream none;
+        custard::input_filters(none, fname, {});
+        fsize = 0;
+        custard::read(none, name, fsize);
+        CHECK(fsize == 0);
+    }
+}
+
+TEST_CASE("stream index stored zip members")
+{
+    Persist::TempDir td;
+    const std::string fname = (td.path / "stored.npz").string();
+    const std::vector<std::string> bodies = {"a", "some longer body", ""};
+    {
+        mz_zip_archive zip;
+        memset(&zip, 0, sizeof(mz_zip_archive));
+        REQUIRE(mz_zip_writer_init_file(&zip, fname.c_str(), 0));
+        for (size_t ind = 0; ind < bodies.size(); ++ind) {
+            const auto name = "m" + std::to_string(ind) + ".npy";
+            REQUIRE(mz_zip_writer_add_mem(&zip, name.c_str(), bodies[ind].data(), bodies[ind].size(),
+                                          MZ_NO_COMPRESSION));
+        }
+        mz_zip_writer_finalize_archive(&zip);
+        mz_zip_writer_end(&zip);
+    }
+    const auto members = custard::index(fname);
+    REQUIRE(members.size() == bodies.size());
+    std::ifstream fi(fname, std::ios::binary);
+    for (size_t ind = 0; ind < bodies.size(); ++ind) {
+        REQUIRE(members[ind].stored >= 0);
+        std::string got(members[ind].size, 0);
+        fi.seekg(members[ind].stored);
+        fi.read(got.data(), got.size());
+        CHECK(got == bodies[ind]);
+    }
+}
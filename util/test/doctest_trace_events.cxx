@@ -0,0 +1,51 @@
+#include "WireCellUtil/TraceEvents.h"
+#include "WireCellUtil/doctest.h"
+
+#include <json/json.h>
+
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace WireCell;
+
+TEST_CASE("trace events record and write")
+{
+    TraceEvents te;
+
+    auto work = [&](const std::string& name) {
+        for (int ind = 0; ind < 10; ++ind) {
+            auto stamp = te.start();
+            std::vector<double> junk(1000, 1.0);
+            te.stop(stamp, name, ind, ind + 1);
+        }
+    };
+    std::thread t1(work, "one"), t2(work, "two \"quoted\"");
+    t1.join();
+    t2.join();
+
+    auto spans = te.spans();
+    REQUIRE(spans.size() == 20);
+    for (const auto& span : spans) {
+        CHECK(span.tid < 2);
+        CHECK(span.wall >= 0);
+        CHECK(span.cpu >= 0);
+        CHECK(span.nout == span.nin + 1);
+    }
+
+    const std::string fname = "doctest_trace_events.json";
+    te.write(fname);
+
+    Json::Value jroot;
+    std::ifstream fstr(fname);
+    fstr >> jroot;
+    const auto& jevents = jroot["traceEvents"];
+    REQUIRE(jevents.size() == 20);
+    for (const auto& jev : jevents) {
+        CHECK(jev["ph"].asString() == "X");
+        const auto name = jev["name"].asString();
+        CHECK((name == "one" or name == "two \"quoted\""));
+        // Memory is process wide and labeled so.
+        CHECK(jev["args"].isMember("process_rss_kb"));
+    }
+}